@@ -31,6 +31,8 @@
 #
 #  OROCOS-RTT_MQUEUE_FOUND: Boolean that indicates if mqueue transport support is available
 #  OROCOS-RTT_MQUEUE_LIBRARIES: Libraries to link against to use OROCOS-RTT with mqueue transport support
+#  OROCOS-RTT_SHM_FOUND: Boolean that indicates if shared memory transport support is available
+#  OROCOS-RTT_SHM_LIBRARIES: Libraries to link against to use OROCOS-RTT with shared memory transport support
 #
 #  OROCOS-RTT_VERSION: Package version
 #  OROCOS-RTT_VERSION_MAJOR: Package major version
@@ -140,6 +142,14 @@ if(TARGET ${OROCOS-RTT-MQUEUE_TARGET})
   set(FOUND_TRANSPORTS "${FOUND_TRANSPORTS} mqueue")
   set(OROCOS-RTT_MQUEUE_LIBRARIES ${OROCOS-RTT-MQUEUE_TARGET})
 endif()
+
+# Shared memory support
+set(OROCOS-RTT-SHM_TARGET "${PREFIX}orocos-rtt-shm-${OROCOS_TARGET}_dynamic")
+if(TARGET ${OROCOS-RTT-SHM_TARGET})
+  set(OROCOS-RTT_SHM_FOUND TRUE)
+  set(FOUND_TRANSPORTS "${FOUND_TRANSPORTS} shm")
+  set(OROCOS-RTT_SHM_LIBRARIES ${OROCOS-RTT-SHM_TARGET} ${OROCOS-RTT-MQUEUE_TARGET})
+endif()
 endif()
 
 
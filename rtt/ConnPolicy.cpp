@@ -69,6 +69,15 @@ namespace RTT
         return result;
     }
 
+    ConnPolicy ConnPolicy::broadcast(int size, bool init_connection /*= false*/, bool pull /*= false*/)
+    {
+        ConnPolicy result(BROADCAST, LOCK_FREE);
+        result.init = init_connection;
+        result.pull = pull;
+        result.size = size;
+        return result;
+    }
+
     ConnPolicy ConnPolicy::data(int lock_policy /*= LOCK_FREE*/, bool init_connection /*= true*/, bool pull /*= false*/)
     {
         ConnPolicy result(DATA, lock_policy);
@@ -78,7 +87,7 @@ namespace RTT
     }
 
     ConnPolicy::ConnPolicy(int type /* = DATA*/, int lock_policy /*= LOCK_FREE*/)
-        : type(type), init(false), lock_policy(lock_policy), pull(false), size(0), transport(0), data_size(0) {}
+        : type(type), init(false), lock_policy(lock_policy), pull(false), size(0), transport(0), data_size(0), batch_size(0), batch_latency(0.0) {}
 
     /** @cond */
     /** This is dead code. We use the boost::serialization now.
@@ -87,6 +96,7 @@ namespace RTT
     {
         Property<int> i;
         Property<bool> b;
+        Property<double> d;
         Property<string> s;
         if ( bag.getType() != "ConnPolicy")
             return false;
@@ -119,6 +129,20 @@ namespace RTT
             log(Error) <<"ConnPolicy: wrong property type of 'data_size'."<<endlog();
             return false;
         }
+        i = bag.getProperty("batch_size");
+        if ( i.ready() )
+            result.batch_size = i.get();
+        else if ( bag.find("batch_size") ){
+            log(Error) <<"ConnPolicy: wrong property type of 'batch_size'."<<endlog();
+            return false;
+        }
+        d = bag.getProperty("batch_latency");
+        if ( d.ready() )
+            result.batch_latency = d.get();
+        else if ( bag.find("batch_latency") ){
+            log(Error) <<"ConnPolicy: wrong property type of 'batch_latency'."<<endlog();
+            return false;
+        }
         i = bag.getProperty("transport");
         if ( i.ready() )
             result.transport = i.get();
@@ -168,6 +192,8 @@ namespace RTT
         targetbag.ownProperty( new Property<int>("transport","The prefered transport. Set to zero if unsure.", cp.transport));
         targetbag.ownProperty( new Property<int>("data_size","A hint about the data size of a single data sample. Set to zero if unsure.", cp.transport));
         targetbag.ownProperty( new Property<string>("name_id","The name of the connection to be formed.",cp.name_id));
+        targetbag.ownProperty( new Property<int>("batch_size","The maximum number of samples delivered at once. Set to zero to deliver each sample on its own.", cp.batch_size));
+        targetbag.ownProperty( new Property<double>("batch_latency","The maximum time in seconds a sample may be held back to complete a batch.", cp.batch_latency));
     }
     /** @endcond */
 
@@ -49,10 +49,13 @@ namespace RTT {
      * behave. Various parameters are available:
      *
      * <ul>
-     *  <li> the connection type: DATA, BUFFER or CIRCULAR_BUFFER. On a data connection, the reader will have
+     *  <li> the connection type: DATA, BUFFER, CIRCULAR_BUFFER or BROADCAST. On a data connection, the reader will have
      *       only access to the last written value. On a buffered connection, a
      *       \a size number of elements can be stored until the reader reads
      *       them. BUFFER drops newer samples on full, CIRCULAR_BUFFER drops older samples on full.
+     *       BROADCAST behaves like CIRCULAR_BUFFER, but all broadcast connections of
+     *       an output port share one lock-free buffer, such that each sample is stored
+     *       only once, whatever the number of readers. The lock policy is ignored.
      *  <li> the locking policy: LOCKED, LOCK_FREE or UNSYNC. This defines how locking is done in the
      *       connection. For now, only three policies are available. LOCKED uses
      *       mutexes, LOCK_FREE uses a lock free method and UNSYNC means there's no
@@ -93,10 +96,21 @@ namespace RTT {
         static const int DATA   = 0;
         static const int BUFFER = 1;
         static const int CIRCULAR_BUFFER = 2;
+        static const int BROADCAST = 3;
 
         static const int UNSYNC    = 0;
         static const int LOCKED    = 1;
         static const int LOCK_FREE = 2;
+        /**
+         * Only for DATA connections: a lock-free data object for which
+         * the writer never waits and readers never write shared memory: they
+         * only copy a slot between two reads of its sequence number, each
+         * ordered by a memory fence (a locked instruction on x86).
+         * Meant for large samples read by several readers. Only types which can
+         * be copied bit by bit use it, others fall back to LOCK_FREE.
+         * @see base::DataObjectSeqLock
+         */
+        static const int SEQLOCK   = 3;
 
         /**
          * Create a policy for a (lock-free) fifo buffer connection of a given size.
@@ -118,6 +132,22 @@ namespace RTT {
          */
         static ConnPolicy circularBuffer(int size, int lock_policy = LOCK_FREE, bool init_connection = false, bool pull = false);
 
+        /**
+         * Create a policy for a lock-free broadcast connection. All broadcast
+         * connections of an output port share a circular buffer of \a size
+         * elements, and every sample is stored only once in that buffer.
+         * Readers which do not keep up skip the oldest samples.
+         * Only local connections can share their buffer, other connections
+         * fall back to a circular buffer per connection.
+         * @param size The size of the shared buffer. Only the size of the first
+         * broadcast connection of an output port is taken into account.
+         * @param init_connection If the reader should start with the last sample
+         * written to the shared buffer.
+         * @param pull In inter-process cases, should the consumer pull itself ?
+         * @return the specified policy.
+         */
+        static ConnPolicy broadcast(int size, bool init_connection = false, bool pull = false);
+
         /**
          * Create a policy for a (lock-free) shared data connection of a given size.
          * @param lock_policy The locking policy
@@ -137,7 +167,7 @@ namespace RTT {
          */
         explicit ConnPolicy(int type = DATA, int lock_policy = LOCK_FREE);
 
-        /** DATA, BUFFER or CIRCULAR_BUFFER */
+        /** DATA, BUFFER, CIRCULAR_BUFFER or BROADCAST */
         int    type;
         /** If true, one should initialize the connection's value with the last
          * value written on the writer port. This is only possible if the writer
@@ -152,7 +182,8 @@ namespace RTT {
          * data is available by base::ChannelElementBase::signal()
          */
         bool   pull;
-        /** If the connection is a buffered connection, the size of the buffer */
+        /** If the connection is a buffered connection, the size of the buffer.
+         * For a SEQLOCK data connection, the number of slots of its ring (default 3). */
         int    size;
         /**
          * The prefered transport used. 0 is local (in process), a higher number
@@ -177,6 +208,23 @@ namespace RTT {
          * work around name clashes or if the transport protocol documents to do so.
          */
         mutable std::string name_id;
+
+        /**
+         * The maximum number of samples a transport may deliver in one batch
+         * to the input port, which is then signalled once per batch instead
+         * of once per sample. Zero or one turns batching off, which is the
+         * default. The mqueue and shm transports batch on the receiving side,
+         * the CORBA transport batches pushed samples into one remote call.
+         */
+        int batch_size;
+
+        /**
+         * The maximum time, in seconds, a transport may hold back a sample
+         * in order to complete a batch of \a batch_size samples. Zero, which
+         * is the default, sends whatever is available without waiting.
+         * Only used by the CORBA transport in push mode.
+         */
+        double batch_latency;
     };
 }
 
@@ -40,6 +40,7 @@
 #include "Logger.hpp"
 #include "Service.hpp"
 #include "TaskContext.hpp"
+#include <sstream>
 
 namespace RTT
 {
@@ -143,8 +144,8 @@ namespace RTT
             return port;
         }
 #endif
-        if (callback)
-            mservice->getOwner()->dataOnPortCallback(&port,callback); // the handle will be deleted when the port is removed.
+        // also ports without callback are registered, such that their events are coalesced.
+        mservice->getOwner()->dataOnPortCallback(&port,callback); // the handle will be deleted when the port is removed.
 
 #ifndef ORO_SIGNALLING_PORTS
         port.signalInterface(true);
@@ -199,6 +200,41 @@ namespace RTT
         return "";
     }
 
+    std::vector<ChannelStatistics> DataFlowInterface::getConnectionStatistics(const std::string& name) const {
+        PortInterface* port = this->getPort(name);
+        if ( port )
+            return port->getConnectionStatistics();
+        return std::vector<ChannelStatistics>();
+    }
+
+    std::string DataFlowInterface::dumpConnectionStatistics() const {
+        std::stringstream result;
+        for ( Ports::const_iterator it(mports.begin());
+              it != mports.end();
+              ++it) {
+            std::vector<ChannelStatistics> stats = (*it)->getConnectionStatistics();
+            for (std::vector<ChannelStatistics>::const_iterator cs = stats.begin(); cs != stats.end(); ++cs)
+                result << (*it)->getName() << " <-> " << (cs->peer.empty() ? "?" : cs->peer)
+                       << ": writes " << cs->writes << ", reads " << cs->reads
+                       << ", drops " << cs->drops << ", overwrites " << cs->overwrites
+                       << ", size " << cs->size << "/" << cs->capacity
+                       << ", high-water " << cs->high_water << std::endl;
+            if (mservice && mservice->getOwner()) {
+                unsigned int coalesced = mservice->getOwner()->coalescedEvents(*it);
+                if (coalesced)
+                    result << (*it)->getName() << ": coalesced events " << coalesced << std::endl;
+            }
+        }
+        return result.str();
+    }
+
+    unsigned int DataFlowInterface::getCoalescedEvents(const std::string& name) const {
+        PortInterface* p = this->getPort(name);
+        if ( !p || !mservice || !mservice->getOwner() )
+            return 0;
+        return mservice->getOwner()->coalescedEvents(p);
+    }
+
     bool DataFlowInterface::setPortDescription(const std::string& name, const std::string description) {
         Service::shared_ptr srv = mservice->getService(name);
         if (srv) {
@@ -168,6 +168,34 @@ namespace RTT
          */
         std::string getPortDescription(const std::string& name) const;
 
+        /**
+         * Get the data flow statistics of each connection of an added Port.
+         *
+         * @param name The port name
+         *
+         * @return The statistics, or an empty sequence if the port does not exist.
+         */
+        std::vector<base::ChannelStatistics> getConnectionStatistics(const std::string& name) const;
+
+        /**
+         * Describes the data flow statistics of all connections of all
+         * added Ports, one connection per line, followed by the number
+         * of coalesced events of each event Port, if any.
+         */
+        std::string dumpConnectionStatistics() const;
+
+        /**
+         * Get the number of times new data arrived on an added event
+         * Port while the previous data on that Port was not yet handled
+         * by the TaskContext. Such events are handled in a single step.
+         *
+         * @param name The port name
+         *
+         * @return The number of coalesced events, zero if the port does
+         * not exist or is not an event port.
+         */
+        unsigned int getCoalescedEvents(const std::string& name) const;
+
         /**
          * Sets the description for the service of an added port.
          * It's prefered to use getPort(name)->doc(description) instead
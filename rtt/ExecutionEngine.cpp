@@ -45,6 +45,7 @@
 #include "internal/MWSRQueue.hpp"
 #include "TaskContext.hpp"
 #include "internal/CatchConfig.hpp"
+#include "os/TimeService.hpp"
 
 #include <boost/bind.hpp>
 #include <boost/ref.hpp>
@@ -71,8 +72,10 @@ namespace RTT
     ExecutionEngine::ExecutionEngine( TaskCore* owner )
         : taskc(owner),
           mqueue(new MWSRQueue<DisposableInterface*>(ORONUM_EE_MQUEUE_SIZE) ),
-          f_queue( new MWSRQueue<ExecutableInterface*>(ORONUM_EE_MQUEUE_SIZE) )
+          f_queue( new MWSRQueue<ExecutableInterface*>(ORONUM_EE_MQUEUE_SIZE) ),
+          msg_waiters(0), msg_budget(0), msg_time_budget(0)
     {
+        resetMessageStatistics();
     }
 
     ExecutionEngine::~ExecutionEngine()
@@ -220,12 +223,28 @@ namespace RTT
     {
         // execute all commands from the AtomicQueue.
         // msg_lock may not be held when entering this function !
+        unsigned int depth = mqueue->size();
+        if ( depth == 0 )
+            return;
+        if ( depth > msg_max_depth )
+            msg_max_depth = depth;
+
+        os::TimeService::nsecs start = os::TimeService::Instance()->getNSecs();
+        os::TimeService::nsecs elapsed = 0;
+        unsigned int count = 0;
+        int waiters = 0;
         DisposableInterface* com(0);
         {
-            while ( mqueue->dequeue(com) ) {
+            // stay within the budget, the remaining messages
+            // are processed in the next step.
+            while ( (msg_budget == 0 || count != msg_budget) && mqueue->dequeue(com) ) {
                 assert( com );
                 com->executeAndDispose();
+                ++count;
+                if ( msg_time_budget != 0 && os::TimeService::Instance()->getNSecs(start) >= msg_time_budget )
+                    break;
             }
+            elapsed = os::TimeService::Instance()->getNSecs(start);
             // there's no need to hold the lock during
             // emptying the queue. But we must hold the
             // lock once between excuteAndDispose and the
@@ -233,9 +252,20 @@ namespace RTT
             // waitForMessages().
             // This allows us to recurse into processMessages.
             MutexLock locker( msg_lock );
+            waiters = msg_waiters.read();
         }
-        if ( com )
+        msg_processed += count;
+        msg_last_processed = count;
+        msg_last_time = elapsed;
+        if ( elapsed > msg_max_time )
+            msg_max_time = elapsed;
+
+        if ( count != 0 && waiters != 0 )
             msg_cond.broadcast(); // required for waitForMessages() (3rd party thread)
+
+        // come back for the messages we left in the queue.
+        if ( (msg_budget != 0 || msg_time_budget != 0) && !mqueue->isEmpty() && this->getActivity() )
+            this->getActivity()->trigger();
     }
 
     bool ExecutionEngine::process( DisposableInterface* c )
@@ -246,7 +276,12 @@ namespace RTT
                 return false;
             bool result = mqueue->enqueue( c );
             this->getActivity()->trigger();
-            msg_cond.broadcast(); // required for waitAndProcessMessages() (EE thread)
+            if ( msg_waiters.read() != 0 ) {
+                // wake up waitAndProcessMessages() (EE thread), the lock
+                // guarantees it is waiting or will see the new message.
+                { MutexLock locker( msg_lock ); }
+                msg_cond.broadcast();
+            }
             return result;
         }
         return false;
@@ -276,14 +311,19 @@ namespace RTT
             return;
         // only to be called from the thread not executing step().
         os::MutexLock lock(msg_lock);
+        msg_waiters.inc();
         while (!pred()) { // the mutex guards that processMessages can not run between !pred and the wait().
             msg_cond.wait(msg_lock); // now processMessages may run.
         }
+        msg_waiters.dec();
     }
 
 
     void ExecutionEngine::waitAndProcessMessages(boost::function<bool(void)> const& pred)
     {
+        // registered before processing, such that process() wakes us up
+        // for any message we did not see.
+        msg_waiters.inc();
         while ( !pred() ){
             // may not be called while holding the msg_lock !!!
             this->processMessages();
@@ -291,13 +331,14 @@ namespace RTT
                 // only to be called from the thread executing step().
                 // We must lock because the cond variable will unlock msg_lock.
                 os::MutexLock lock(msg_lock);
-                if (!pred()) {
+                if (pred())
+                    break; // do not process messages when pred() == true;
+                // messages left over by the budget are processed without waiting.
+                if ( mqueue->isEmpty() )
                     msg_cond.wait(msg_lock); // now processMessages may run.
-                } else {
-                    return; // do not process messages when pred() == true;
-                }
             }
         }
+        msg_waiters.dec();
     }
 
     void ExecutionEngine::waitAndProcessFunctions(boost::function<bool(void)> const& pred)
@@ -409,6 +450,54 @@ namespace RTT
         return false;
     }
 
+    void ExecutionEngine::setMessageBudget(unsigned int max_messages) {
+        msg_budget = max_messages;
+    }
+
+    unsigned int ExecutionEngine::getMessageBudget() const {
+        return msg_budget;
+    }
+
+    void ExecutionEngine::setMessageTimeBudget(Seconds max_time) {
+        msg_time_budget = max_time > 0 ? Seconds_to_nsecs(max_time) : 0;
+    }
+
+    Seconds ExecutionEngine::getMessageTimeBudget() const {
+        return nsecs_to_Seconds(msg_time_budget);
+    }
+
+    unsigned int ExecutionEngine::getMessageQueueDepth() const {
+        return mqueue->size();
+    }
+
+    unsigned int ExecutionEngine::getMaxMessageQueueDepth() const {
+        return msg_max_depth;
+    }
+
+    unsigned int ExecutionEngine::getMessagesProcessed() const {
+        return msg_processed;
+    }
+
+    unsigned int ExecutionEngine::getLastMessagesProcessed() const {
+        return msg_last_processed;
+    }
+
+    Seconds ExecutionEngine::getLastMessageProcessingTime() const {
+        return nsecs_to_Seconds(msg_last_time);
+    }
+
+    Seconds ExecutionEngine::getMaxMessageProcessingTime() const {
+        return nsecs_to_Seconds(msg_max_time);
+    }
+
+    void ExecutionEngine::resetMessageStatistics() {
+        msg_max_depth = 0;
+        msg_processed = 0;
+        msg_last_processed = 0;
+        msg_last_time = 0;
+        msg_max_time = 0;
+    }
+
     void ExecutionEngine::setExceptionTask() {
         std::string name;
         TaskContext* tc = dynamic_cast<TaskContext*>(taskc);
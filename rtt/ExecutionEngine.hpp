@@ -42,6 +42,8 @@
 #include "os/Mutex.hpp"
 #include "os/MutexLock.hpp"
 #include "os/Condition.hpp"
+#include "os/Atomic.hpp"
+#include "os/Time.hpp"
 #include "base/RunnableInterface.hpp"
 #include "base/ActivityInterface.hpp"
 #include "base/DisposableInterface.hpp"
@@ -182,6 +184,74 @@ namespace RTT
          * Set the 'owner' task in the exception state.
          */
         void setExceptionTask();
+
+        /**
+         * Limits the number of messages that are processed in one step().
+         * The remaining messages are processed in the next step(s), such
+         * that a burst of messages does not delay the updateHook().
+         * @param max_messages The maximum number of messages per step, or
+         * zero to process all queued messages in each step (the default).
+         */
+        void setMessageBudget(unsigned int max_messages);
+
+        /**
+         * Returns the maximum number of messages processed in one step(),
+         * zero if unbounded.
+         */
+        unsigned int getMessageBudget() const;
+
+        /**
+         * Limits the time spent in processing messages in one step().
+         * The message which exceeds the budget is completed, the remaining
+         * messages are processed in the next step(s).
+         * @param max_time The maximum processing time per step, or zero to
+         * process all queued messages in each step (the default).
+         */
+        void setMessageTimeBudget(Seconds max_time);
+
+        /**
+         * Returns the maximum time spent in processing messages in one step(),
+         * zero if unbounded.
+         */
+        Seconds getMessageTimeBudget() const;
+
+        /**
+         * Returns the number of messages which are currently queued.
+         */
+        unsigned int getMessageQueueDepth() const;
+
+        /**
+         * Returns the largest number of queued messages seen at the start of a step().
+         */
+        unsigned int getMaxMessageQueueDepth() const;
+
+        /**
+         * Returns the number of messages processed since the creation of this
+         * engine or the last resetMessageStatistics().
+         */
+        unsigned int getMessagesProcessed() const;
+
+        /**
+         * Returns the number of messages processed in the last step() which
+         * processed messages.
+         */
+        unsigned int getLastMessagesProcessed() const;
+
+        /**
+         * Returns the time spent in processing messages in the last step()
+         * which processed messages.
+         */
+        Seconds getLastMessageProcessingTime() const;
+
+        /**
+         * Returns the longest time spent in processing messages in one step().
+         */
+        Seconds getMaxMessageProcessingTime() const;
+
+        /**
+         * Resets the message statistics of this engine.
+         */
+        void resetMessageStatistics();
     protected:
         /**
          * Call this if you wish to block on a message arriving in the Execution Engine.
@@ -245,6 +315,27 @@ namespace RTT
 
         os::Mutex msg_lock;
         os::Condition msg_cond;
+        /**
+         * The number of threads waiting on msg_cond. Changed while
+         * holding msg_lock or before processing messages, such that
+         * processMessages() only needs to broadcast if it's not zero.
+         */
+        os::AtomicInt msg_waiters;
+
+        /**
+         * The budgets of processMessages(), zero when unbounded.
+         */
+        unsigned int msg_budget;
+        nsecs msg_time_budget;
+
+        /**
+         * The message statistics.
+         */
+        unsigned int msg_max_depth;
+        unsigned int msg_processed;
+        unsigned int msg_last_processed;
+        nsecs msg_last_time;
+        nsecs msg_max_time;
 
         void processMessages();
         void processFunctions();
@@ -84,6 +84,22 @@ namespace RTT
             return false;
         }
 
+        bool do_read_ref(base::SampleRef<T>& sample, FlowStatus& result, bool copy_old_data, const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        {
+            typename base::ChannelElement<T>::shared_ptr input = static_cast< base::ChannelElement<T>* >( descriptor.get<1>().get() );
+            assert( result != NewData );
+            if ( input ) {
+                FlowStatus tresult = input->readRef(sample, copy_old_data);
+                if (tresult == NewData) {
+                    result = tresult;
+                    return true;
+                }
+                if (tresult > result)
+                    result = tresult;
+            }
+            return false;
+        }
+
         /**
          * You are not allowed to copy ports.
          * In case you want to create a container of ports,
@@ -157,6 +173,22 @@ namespace RTT
         }
 
 
+        /** Reads a sample from the connection without copying it, if the
+         * connection allows so. This is the case for lock-free buffered
+         * connections, where \a sample then shares the buffer's storage
+         * until it is read into again or reset. On other connections, the
+         * sample is copied into the private storage of \a sample.
+         *
+         * The return value and @arg copy_old_data have the same meaning as
+         * in read().
+         */
+        FlowStatus readRef(base::SampleRef<T>& sample, bool copy_old_data = true)
+        {
+            FlowStatus result = NoData;
+            cmanager.select_reader_channel( boost::bind( &InputPort::do_read_ref, this, boost::ref(sample), boost::ref(result), boost::lambda::_1, boost::lambda::_2), copy_old_data );
+            return result;
+        }
+
         /** Read all new samples that are available on this port, and returns
          * the last one.
          *
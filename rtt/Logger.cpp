@@ -41,9 +41,18 @@
 #include "os/MutexLock.hpp"
 #include "os/Mutex.hpp"
 #include "os/TimeService.hpp"
+#include "os/Thread.hpp"
+#include "os/threads.hpp"
+#include "os/Atomic.hpp"
+#include "os/CAS.hpp"
+#include "internal/TsPool.hpp"
+#include "internal/AtomicMWSRQueue.hpp"
 
 #include "Logger.hpp"
 #include <iomanip>
+#include <streambuf>
+#include <vector>
+#include <string.h>
 
 #ifdef OROSEM_PRINTF_LOGGING
 #  include <stdio.h>
@@ -62,6 +71,10 @@
 #include "rtt-config.h"
 #include "rtt-fwd.hpp"
 
+#if !defined(OROBLD_DISABLE_LOGGING) && !defined(_MSC_VER)
+#  include <pthread.h>
+#endif
+
 namespace RTT
 {
     using namespace std;
@@ -86,6 +99,12 @@ namespace RTT
 
 #ifndef OROBLD_DISABLE_LOGGING
 
+#ifdef _MSC_VER
+#  define ORO_LOGGER_TLS __declspec(thread)
+#else
+#  define ORO_LOGGER_TLS __thread
+#endif
+
     Logger& Logger::log() {
         return *Instance();
     }
@@ -100,6 +119,85 @@ namespace RTT
     struct Logger::D
     {
     public:
+        /**
+         * The maximum length of a line and of a module name
+         * in asynchronous mode, including the terminating zero.
+         */
+        enum { LineSize = 512, ModuleSize = 64 };
+
+        /**
+         * The number of lines that can be queued in asynchronous mode.
+         */
+        enum { QueueSize = 256 };
+
+        /**
+         * A streambuf which writes in a fixed character array.
+         * Output beyond the end of the array is discarded.
+         */
+        class LineBuf : public std::streambuf
+        {
+            char text[LineSize];
+        public:
+            LineBuf() { reset(); }
+            void reset() { setp(text, text + LineSize - 1); }
+            const char* c_str() { *pptr() = '\0'; return text; }
+        };
+
+        /**
+         * The states of a ThreadLine, see releaseLine().
+         */
+        enum { LineInUse, LineFree, LineOrphan };
+
+        /**
+         * The message a thread is formatting in asynchronous mode.
+         */
+        struct ThreadLine
+        {
+            ThreadLine(LogLevel ll, const std::string& module)
+                : stream(&buf), state(LineInUse)
+            {
+                reset(ll, module);
+            }
+            void reset(LogLevel ll, const std::string& module)
+            {
+                buf.reset();
+                stream.clear();
+                level = ll;
+                strncpy(this->module, module.c_str(), ModuleSize - 1);
+                this->module[ModuleSize - 1] = '\0';
+            }
+            LineBuf buf;
+            std::ostream stream;
+            LogLevel level;
+            char module[ModuleSize];
+            volatile int state;
+        };
+
+        /**
+         * A completed line, waiting in the queue for the LogFlusher.
+         */
+        struct LogRecord
+        {
+            LogLevel level;
+            TimeService::ticks stamp;
+            char module[ModuleSize];
+            char text[LineSize];
+        };
+
+        /**
+         * The low priority thread which writes out the queued lines.
+         */
+        class LogFlusher : public os::Thread
+        {
+            D* d;
+        public:
+            LogFlusher(D* d)
+                : os::Thread(ORO_SCHED_OTHER, os::LowestPriority, 0.01, 0, "LogFlusher"), d(d)
+            {}
+            ~LogFlusher() { this->stop(); }
+            void step() { d->drain(); }
+        };
+
         D(std::ostream& str, char const* logfile_name) :
 #ifndef OROSEM_PRINTF_LOGGING
               stdoutput( &str ),
@@ -114,14 +212,32 @@ namespace RTT
               outloglevel(Warning),
               timestamp(0),
               started(false), showtime(true), allowRT(false),
-              mlogStdOut(true), mlogFile(true),
-              moduleptr("Logger")
+              mlogStdOut(true), mlogFile(true), masync(false),
+              moduleptr("Logger"),
+              generation(++generations), pool(0), queue(0), flusher(0)
         {
 #if defined(OROSEM_FILE_LOGGING) && defined(OROSEM_PRINTF_LOGGING)
             logfile = fopen(logfile_name ? logfile_name : "orocos.log","w");
 #endif
         }
 
+        ~D()
+        {
+            delete flusher;
+            if ( queue )
+                drain();
+            delete queue;
+            delete pool;
+            for (std::vector<ThreadLine*>::iterator it = lines.begin(); it != lines.end(); ++it) {
+#ifndef _MSC_VER
+                // a running thread deletes its line itself when it exits.
+                if ( os::CAS(&(*it)->state, (int)LineInUse, (int)LineOrphan) )
+                    continue;
+#endif
+                delete *it;
+            }
+        }
+
         bool maylog() const {
             if (!started || (outloglevel == RealTime && allowRT == false))
                 return false;
@@ -129,13 +245,21 @@ namespace RTT
         }
 
         bool maylogStdOut() const {
-            if ( inloglevel <= outloglevel && outloglevel != Never && inloglevel != Never && mlogStdOut)
+            return maylogStdOut(inloglevel);
+        }
+
+        bool maylogStdOut(LogLevel ll) const {
+            if ( ll <= outloglevel && outloglevel != Never && ll != Never && mlogStdOut)
                 return true;
             return false;
         }
 
         bool maylogFile() const {
-            if ( (inloglevel <= Info || inloglevel <= outloglevel)  && mlogFile)
+            return maylogFile(inloglevel);
+        }
+
+        bool maylogFile(LogLevel ll) const {
+            if ( (ll <= Info || ll <= outloglevel)  && mlogFile)
                 return true;
             return false;
         }
@@ -153,36 +277,193 @@ namespace RTT
 
             // do not log if not wanted.
             if ( maylogStdOut() ) {
-#ifndef OROSEM_PRINTF_LOGGING
-                *stdoutput << res << logline.str() << pf;
-#else
-                printf("%s%s\n", res.c_str(), logline.str().c_str() );
-#endif
+                writeStdOut( res, logline.str(), pf );
                 logline.str("");   // clear stringstream.
             }
 
             if ( maylogFile() ) {
 #ifdef OROSEM_FILE_LOGGING
+                writeFile( res, fileline.str(), pf );
+                fileline.str("");
+#endif
+            }
+        }
+
+        /**
+         * Writes a prefix and a message to the standard output.
+         * @pre inpguard is locked.
+         */
+        void writeStdOut(const std::string& res, const std::string& line, std::ostream& (*pf)(std::ostream&))
+        {
 #ifndef OROSEM_PRINTF_LOGGING
-                logfile << res << fileline.str() << pf;
+            *stdoutput << res << line << pf;
 #else
-                fprintf( logfile, "%s%s\n", res.c_str(), fileline.str().c_str() );
+            printf("%s%s\n", res.c_str(), line.c_str() );
+#endif
+        }
+
+        /**
+         * Writes a prefix and a message to the log file and the
+         * remote log buffer.
+         * @pre inpguard is locked.
+         */
+        void writeFile(const std::string& res, const std::string& line, std::ostream& (*pf)(std::ostream&))
+        {
+#ifdef OROSEM_FILE_LOGGING
+#ifndef OROSEM_PRINTF_LOGGING
+            logfile << res << line << pf;
+#else
+            fprintf( logfile, "%s%s\n", res.c_str(), line.c_str() );
 #endif
 #ifdef OROSEM_REMOTE_LOGGING
-                // detect buffer 'overflow'
-                if ( messagecnt >= ORONUM_LOGGING_BUFSIZE ) {
-                    std::string dummy;
-                    remotestream >> dummy; // FIFO principle: read 1 line
-                    --messagecnt;
+            // detect buffer 'overflow'
+            if ( messagecnt >= ORONUM_LOGGING_BUFSIZE ) {
+                std::string dummy;
+                remotestream >> dummy; // FIFO principle: read 1 line
+                --messagecnt;
+            }
+            remotestream << res << line << pf;
+            ++messagecnt;
+#endif
+#endif
+        }
+
+        /**
+         * Flushes the standard output and file streams.
+         * @pre inpguard is locked.
+         */
+        void flushStreams()
+        {
+            if ( maylogStdOut() ) {
+#ifndef OROSEM_PRINTF_LOGGING
+                stdoutput->flush();
+#endif
+#if defined(OROSEM_REMOTE_LOGGING)
+                remotestream.flush();
+#endif
+            }
+#if defined(OROSEM_FILE_LOGGING)
+            if ( maylogFile() ) {
+#ifndef OROSEM_PRINTF_LOGGING
+                logfile.flush();
+#endif
+            }
+#endif
+        }
+
+        /**
+         * Returns the line buffer of the calling thread, which is
+         * taken the first time a thread logs in asynchronous mode.
+         * The lines of threads that exited are reused.
+         */
+        ThreadLine* threadLine()
+        {
+            if ( tls_generation != generation ) {
+                os::MutexLock lock( inpguard );
+#ifndef _MSC_VER
+                // hand back the line of a previous logger.
+                if ( tls_line )
+                    releaseLine( tls_line );
+#endif
+                tls_line = 0;
+                for (std::vector<ThreadLine*>::iterator it = lines.begin(); it != lines.end() && !tls_line; ++it)
+                    if ( (*it)->state == LineFree ) {
+                        tls_line = *it;
+                        tls_line->reset( inloglevel, moduleptr );
+                        tls_line->state = LineInUse;
+                    }
+                if ( !tls_line ) {
+                    tls_line = new ThreadLine( inloglevel, moduleptr );
+                    lines.push_back( tls_line );
                 }
-                remotestream << res << fileline.str() << pf;
-                ++messagecnt;
+#ifndef _MSC_VER
+                pthread_once( &line_key_once, &createLineKey );
+                pthread_setspecific( line_key, tls_line );
 #endif
-#if defined(OROSEM_FILE_LOGGING) || defined(OROSEM_REMOTE_LOGGING)
-                fileline.str("");
+                tls_generation = generation;
+            }
+            return tls_line;
+        }
+
+#ifndef _MSC_VER
+        /**
+         * Called when a thread with a line exits. It hands the line back
+         * to its logger, or deletes it if the logger was released.
+         */
+        static void releaseLine(void* arg)
+        {
+            ThreadLine* line = static_cast<ThreadLine*>(arg);
+            if ( !os::CAS(&line->state, (int)LineInUse, (int)LineFree) )
+                delete line;
+        }
+
+        static void createLineKey()
+        {
+            pthread_key_create( &line_key, &releaseLine );
+        }
 #endif
+
+        /**
+         * Queues the message of \a line for the LogFlusher and starts
+         * a new one. Does not block and does not allocate.
+         */
+        void pushLine(ThreadLine* line)
+        {
+            if ( maylogStdOut(line->level) || maylogFile(line->level) ) {
+                LogRecord* r = pool->allocate();
+                if ( r ) {
+                    r->level = line->level;
+                    r->stamp = TimeService::Instance()->getTicks();
+                    memcpy( r->module, line->module, ModuleSize );
+                    strcpy( r->text, line->buf.c_str() );
+                    if ( !queue->enqueue(r) ) {
+                        pool->deallocate(r);
+                        r = 0;
+                    }
+                }
+                if ( r == 0 )
+                    dropped.inc();
+            }
+            line->buf.reset();
+            line->stream.clear();
+        }
+
+        /**
+         * Writes out all queued lines. This is called periodically by
+         * the LogFlusher and when asynchronous mode is switched off.
+         */
+        void drain()
+        {
+            os::MutexLock lock( inpguard );
+            LogRecord* r;
+            bool written = false;
+            while ( queue->dequeue(r) ) {
+                std::string res = showTime(r->stamp) + " " + showLevel(r->level) + "[" + r->module + "] ";
+                if ( maylogStdOut(r->level) )
+                    writeStdOut( res, r->text, Logger::nl );
+#ifdef OROSEM_FILE_LOGGING
+                if ( maylogFile(r->level) )
+                    writeFile( res, r->text, Logger::nl );
+#endif
+                pool->deallocate(r);
+                written = true;
+            }
+            int lost = dropped.read();
+            if ( lost ) {
+                dropped.add( -lost );
+                std::stringstream msg;
+                msg << lost << " log lines were dropped because the log queue was full.";
+                std::string res = showTime() + " " + showLevel(Warning) + "[Logger] ";
+                if ( maylogStdOut(Warning) )
+                    writeStdOut( res, msg.str(), Logger::nl );
+#ifdef OROSEM_FILE_LOGGING
+                if ( maylogFile(Warning) )
+                    writeFile( res, msg.str(), Logger::nl );
 #endif
+                written = true;
             }
+            if ( written )
+                flushStreams();
         }
 
 #ifndef OROSEM_PRINTF_LOGGING
@@ -238,6 +519,17 @@ namespace RTT
             return time.str();
         }
 
+        /**
+         * Shows the time of a message which was logged at \a stamp.
+         */
+        std::string showTime(TimeService::ticks stamp) const
+        {
+            std::stringstream time;
+            if ( showtime )
+                time <<fixed<< showpoint << setprecision(3) << nsecs_to_Seconds( TimeService::ticks2nsecs(stamp - timestamp) );
+            return time.str();
+        }
+
         /**
          * Convert a loglevel to a string representation.
          */
@@ -288,11 +580,47 @@ namespace RTT
 
         bool mlogStdOut, mlogFile;
 
+        bool masync;
+
         std::string moduleptr;
 
         os::Mutex inpguard;
+
+        /**
+         * Distinguishes the thread line buffers of this logger from
+         * those of a previous (released) logger.
+         */
+        unsigned int generation;
+        static unsigned int generations;
+
+        static ORO_LOGGER_TLS ThreadLine* tls_line;
+        static ORO_LOGGER_TLS unsigned int tls_generation;
+#ifndef _MSC_VER
+        static pthread_key_t line_key;
+        static pthread_once_t line_key_once;
+#endif
+
+        /**
+         * All thread line buffers, owned by this logger, except for
+         * the orphaned lines of threads that outlive it.
+         * Protected by inpguard.
+         */
+        std::vector<ThreadLine*> lines;
+
+        internal::TsPool<LogRecord>* pool;
+        internal::AtomicMWSRQueue<LogRecord*>* queue;
+        os::AtomicInt dropped;
+        LogFlusher* flusher;
     };
 
+    unsigned int Logger::D::generations = 0;
+    ORO_LOGGER_TLS Logger::D::ThreadLine* Logger::D::tls_line = 0;
+    ORO_LOGGER_TLS unsigned int Logger::D::tls_generation = 0;
+#ifndef _MSC_VER
+    pthread_key_t Logger::D::line_key;
+    pthread_once_t Logger::D::line_key_once = PTHREAD_ONCE_INIT;
+#endif
+
     Logger::Logger(std::ostream& str)
         :d ( new Logger::D(str, getenv("ORO_LOGFILE")) ),
          inpguard(d->inpguard), logline(d->logline), fileline(d->fileline)
@@ -325,6 +653,44 @@ namespace RTT
         d->mlogFile = tf;
     }
 
+    bool Logger::setAsynchronous(bool async) {
+        if ( async == d->masync )
+            return true;
+        if ( async ) {
+            if ( d->queue == 0 ) {
+                d->pool = new internal::TsPool<D::LogRecord>( D::QueueSize );
+                d->queue = new internal::AtomicMWSRQueue<D::LogRecord*>( D::QueueSize );
+            }
+            d->flusher = new D::LogFlusher( d );
+            if ( !d->flusher->start() ) {
+                delete d->flusher;
+                d->flusher = 0;
+                *this << Logger::Error << "Could not start the LogFlusher thread: logging remains synchronous." << Logger::endl;
+                return false;
+            }
+            d->masync = true;
+            return true;
+        }
+        // Lines which are being pushed right now are written out by a next
+        // drain() or when the logger is destroyed.
+        d->masync = false;
+        delete d->flusher;
+        d->flusher = 0;
+        d->drain();
+        return true;
+    }
+
+    bool Logger::isAsynchronous() const {
+        return d->masync;
+    }
+
+    std::ostream* Logger::threadLine() {
+        D::ThreadLine* line = d->threadLine();
+        if ( d->maylogStdOut(line->level) || d->maylogFile(line->level) )
+            return &line->stream;
+        return 0;
+    }
+
     void Logger::allowRealTime() {
         *this << Logger::Warning << "Enabling Real-Time Logging !" <<Logger::endl;
         d->allowRT = true;
@@ -383,6 +749,11 @@ namespace RTT
 
     Logger& Logger::in(const std::string& modname)
     {
+        if ( d->masync ) {
+            D::ThreadLine* line = d->threadLine();
+            strncpy( line->module, modname.c_str(), D::ModuleSize - 1 );
+            return *this;
+        }
         os::MutexLock lock( d->inpguard );
         d->moduleptr = modname.c_str();
         return *this;
@@ -390,12 +761,19 @@ namespace RTT
 
     Logger& Logger::out(const std::string& oldmod)
     {
+        if ( d->masync ) {
+            D::ThreadLine* line = d->threadLine();
+            strncpy( line->module, oldmod.c_str(), D::ModuleSize - 1 );
+            return *this;
+        }
         os::MutexLock lock( d->inpguard );
         d->moduleptr = oldmod.c_str();
         return *this;
     }
 
     std::string Logger::getLogModule() const {
+        if ( d->masync )
+            return d->threadLine()->module;
         os::MutexLock lock( d->inpguard );
         std::string ret = d->moduleptr.c_str();
         return ret;
@@ -458,6 +836,7 @@ namespace RTT
     void Logger::shutdown() {
         if (!d->started)
             return;
+        this->setAsynchronous(false);
         *this<<Logger::Info<<"Orocos Logging Deactivated." << Logger::endl;
         this->logflush();
         d->started = false;
@@ -492,6 +871,13 @@ namespace RTT
         if ( !d->maylog() )
             return *this;
 
+        if ( d->masync ) {
+            std::ostream* line = this->threadLine();
+            if ( line )
+                *line << t;
+            return *this;
+        }
+
         os::MutexLock lock( d->inpguard );
         if ( d->maylogStdOut() )
             d->logline << t;
@@ -511,7 +897,10 @@ namespace RTT
     Logger& Logger::operator<<(LogLevel ll) {
         if ( !d->maylog() )
             return *this;
-        d->inloglevel = ll;
+        if ( d->masync )
+            d->threadLine()->level = ll;
+        else
+            d->inloglevel = ll;
         return *this;
     }
 
@@ -525,6 +914,11 @@ namespace RTT
             this->lognl();
         else if ( pf == Logger::flush )
             this->logflush();
+        else if ( d->masync ) {
+            std::ostream* line = this->threadLine();
+            if ( line )
+                *line << pf;
+        }
         else {
             os::MutexLock lock( d->inpguard );
             if ( d->maylogStdOut() )
@@ -540,37 +934,32 @@ namespace RTT
     void Logger::logflush() {
         if (!d->maylog())
             return;
+        // the LogFlusher flushes the streams after writing out the queue.
+        if ( d->masync )
+            return;
         {
             // just flush all buffers, do not produce a new logline
             os::MutexLock lock( d->inpguard );
-            if ( d->maylogStdOut() ) {
-#ifndef OROSEM_PRINTF_LOGGING
-                d->stdoutput->flush();
-#endif
-#if defined(OROSEM_REMOTE_LOGGING)
-                d->remotestream.flush();
-#endif
-            }
-#if defined(OROSEM_FILE_LOGGING)
-            if ( d->maylogFile() ) {
-#ifndef OROSEM_PRINTF_LOGGING
-                d->logfile.flush();
-#endif
-            }
-#endif
+            d->flushStreams();
         }
      }
 
     void Logger::lognl() {
         if (!d->maylog())
             return;
-        d->logit( Logger::nl );
+        if ( d->masync )
+            d->pushLine( d->threadLine() );
+        else
+            d->logit( Logger::nl );
      }
 
     void Logger::logendl() {
         if (!d->maylog())
             return;
-        d->logit( Logger::endl );
+        if ( d->masync )
+            d->pushLine( d->threadLine() );
+        else
+            d->logit( Logger::endl );
      }
 
     void Logger::setLogLevel( LogLevel ll ) {
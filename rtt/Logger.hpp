@@ -142,6 +142,29 @@ namespace RTT
          */
         void mayLogFile(bool tf);
 
+        /**
+         * Switches the logger to or from asynchronous mode.
+         * In asynchronous mode, every thread formats its messages in a
+         * line buffer of its own and hands each completed line to a lock-free
+         * queue. A low priority 'LogFlusher' thread empties that queue into the
+         * standard output, file and remote streams. Logging then takes no mutex
+         * and does not allocate, except for the first message a thread logs,
+         * which creates the buffer of that thread. The LogLevel and module of
+         * each message are kept per thread in this mode.
+         * Lines longer than 511 characters are truncated, and lines that
+         * do not fit in the queue are dropped and reported afterwards.
+         * @param async true to start asynchronous logging, false to flush all
+         * pending lines and log synchronously again.
+         * @return false if the flushing thread could not be started.
+         */
+        bool setAsynchronous(bool async);
+
+        /**
+         * Returns true if the logger is in asynchronous mode.
+         * @see setAsynchronous()
+         */
+        bool isAsynchronous() const;
+
         /**
          * Notify the Logger in which 'module' the message occured. This returns an object
          * whose scope (i.e. {...} ) is indicative for the boundaries of the module.
@@ -321,6 +344,12 @@ namespace RTT
         bool mayLog() const;
         bool mayLogStdOut() const;
         bool mayLogFile() const;
+        /**
+         * Returns the stream in which the calling thread formats its
+         * current message in asynchronous mode, or null if the message
+         * will not be logged.
+         */
+        std::ostream* threadLine();
 
         Logger(std::ostream& str=std::cerr);
         ~Logger();
@@ -17,6 +17,13 @@ namespace RTT
         if ( !mayLog() )
             return *this;
 
+        if ( isAsynchronous() ) {
+            std::ostream* line = this->threadLine();
+            if ( line )
+                *line << t;
+            return *this;
+        }
+
         os::MutexLock lock( inpguard );
         if ( this->mayLogStdOut() )
             logline << t;
@@ -51,6 +58,14 @@ namespace RTT
     inline void Logger::mayLogFile(bool ) {
     }
 
+    inline bool Logger::setAsynchronous(bool) {
+        return false;
+    }
+
+    inline bool Logger::isAsynchronous() const {
+        return false;
+    }
+
     inline void Logger::allowRealTime() {
     }
 
@@ -80,7 +80,7 @@ namespace RTT
          * @param name The name of this instance.
          */
         Operation(const std::string& name)
-        :OperationBase(name)
+        :OperationBase(name), msendpool(0)
         {
             // set null implementation such that we can
             ExecutionEngine* null_e = 0;
@@ -95,7 +95,7 @@ namespace RTT
          * @param ownerEngine the execution engine of the owner of this operation if any.
          */
         Operation(const std::string& name, boost::function<Signature> func, ExecutionThread et = ClientThread, ExecutionEngine* ee = NULL )
-        :OperationBase(name)
+        :OperationBase(name), msendpool(0)
         {
             this->calls(func, et, ee);
         }
@@ -110,7 +110,7 @@ namespace RTT
          */
         template<class Function, class Object>
         Operation(const std::string& name, Function func, Object o, ExecutionThread et = ClientThread, ExecutionEngine* ee = NULL )
-        :OperationBase(name)
+        :OperationBase(name), msendpool(0)
         {
             this->calls(func, o, et, ee);
         }
@@ -147,6 +147,7 @@ namespace RTT
             // creates a Local OperationCaller
             ExecutionEngine* null_e = 0;
             impl = boost::make_shared<internal::LocalOperationCaller<Signature> >(func, this->mowner, null_e, et, ownerEngine);
+            impl->setSendPool( msendpool );
 #ifdef ORO_SIGNALLING_OPERATIONS
             if (signal)
                 impl->setSignal(signal);
@@ -168,6 +169,7 @@ namespace RTT
             // creates a Local OperationCaller or sets function
             ExecutionEngine* null_e = 0;
             impl = boost::make_shared<internal::LocalOperationCaller<Signature> >(func, o, this->mowner, null_e, et, ownerEngine);
+            impl->setSendPool( msendpool );
 #ifdef ORO_SIGNALLING_OPERATIONS
             if (signal)
                 impl->setSignal(signal);
@@ -175,6 +177,21 @@ namespace RTT
             return *this;
         }
 
+        /**
+         * Reserves memory for \a size asynchronous invocations of this operation,
+         * such that send() is real-time and does not allocate memory as long as
+         * less than \a size SendHandles are in use. Other sends allocate memory.
+         * Only callers which are set up after this call use the reserved memory.
+         * @param size The number of real-time sends, zero to allocate memory in each send().
+         * @return A reference to this object.
+         */
+        Operation<Signature>& sendPool(unsigned int size) {
+            msendpool = size;
+            if (impl)
+                impl->setSendPool( size );
+            return *this;
+        }
+
 #ifdef ORO_SIGNALLING_OPERATIONS
         /**
          * Indicate that this operation signals a given function.
@@ -221,6 +238,7 @@ namespace RTT
 #endif
     private:
         typename internal::LocalOperationCaller<Signature>::shared_ptr impl;
+        unsigned int msendpool;
         virtual void ownerUpdated() {
             if (impl)
                 impl->setExecutor( this->mowner );
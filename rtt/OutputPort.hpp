@@ -84,6 +84,26 @@ namespace RTT
             }
         }
 
+        bool do_commit(T* sample, const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        {
+            typename base::ChannelElement<T>::shared_ptr output
+                = boost::static_pointer_cast< base::ChannelElement<T> >(descriptor.get<1>());
+            // only the channel we loaned from takes over the sample, the others get a copy.
+            bool result;
+            if (output == loan_channel) {
+                loan_committed = true;
+                result = output->commit(sample);
+            } else
+                result = output->write(*sample);
+            if (result)
+                return false;
+            else
+            {
+                log(Error) << "A channel of port " << getName() << " has been invalidated during commit(), it will be removed" << endlog();
+                return true;
+            }
+        }
+
         bool do_init(typename base::ChannelElement<T>::param_t sample, const internal::ConnectionManager::ChannelDescriptor& descriptor)
         {
             typename base::ChannelElement<T>::shared_ptr output
@@ -135,6 +155,10 @@ namespace RTT
         // This is used to allow the use of the 'init' connection policy option
         bool keeps_last_written_value;
         typename base::DataObjectInterface<T>::shared_ptr sample;
+        /// The channel which handed out the sample returned by loan(), if any.
+        typename base::ChannelElement<T>::shared_ptr loan_channel;
+        /// Set by commit() when \c loan_channel took over the loaned sample.
+        bool loan_committed;
 
         /**
          * You are not allowed to copy ports.
@@ -169,6 +193,7 @@ namespace RTT
             , keeps_next_written_value(false)
             , keeps_last_written_value(false)
             , sample( new base::DataObject<T>() )
+            , loan_committed(false)
         {
             if (keep_last_written_value)
                 keepLastWrittenValue(true);
@@ -257,6 +282,71 @@ namespace RTT
                     );
         }
 
+        /**
+         * Reserves storage for the next sample in the current connection of
+         * this port, such that it can be filled in place and written with
+         * commit() without copying it into the connection. This is only
+         * possible on lock-free buffered connections. Only one sample can be
+         * loaned at a time.
+         *
+         * In order to avoid any copy, create this port with
+         * keep_last_written_value set to false.
+         * @return a sample to fill in, or null if the connection can not loan
+         * its storage or is full. Use write() in that case.
+         */
+        T* loan()
+        {
+            typename base::ChannelElement<T>::shared_ptr channel =
+                boost::static_pointer_cast< base::ChannelElement<T> >( cmanager.lockCurrentChannel() );
+            if ( !channel || loan_channel )
+                return 0;
+            T* result = channel->loan();
+            if (result)
+                loan_channel = channel;
+            return result;
+        }
+
+        /**
+         * Writes a sample obtained with loan() to all receivers (if any).
+         * The connection that loaned the sample takes it over without
+         * copying, other connections receive a copy. After this call,
+         * \a sample may no longer be accessed.
+         * @param sample The sample returned by the last call to loan().
+         */
+        void commit(T* sample)
+        {
+            if (!loan_channel)
+                return;
+            if (keeps_last_written_value || keeps_next_written_value)
+            {
+                keeps_next_written_value = false;
+                has_initial_sample = true;
+                this->sample->Set(*sample);
+            }
+            has_last_written_value = keeps_last_written_value;
+
+            loan_committed = false;
+            cmanager.delete_if( boost::bind(
+                        &OutputPort<T>::do_commit, this, sample, boost::lambda::_1)
+                    );
+            // the loaning channel was disconnected in the mean time.
+            if (!loan_committed)
+                loan_channel->release(sample);
+            loan_channel = 0;
+        }
+
+        /**
+         * Gives back a sample obtained with loan() without writing it.
+         * @param sample The sample returned by the last call to loan().
+         */
+        void discard(T* sample)
+        {
+            if (!loan_channel)
+                return;
+            loan_channel->release(sample);
+            loan_channel = 0;
+        }
+
         void write(base::DataSourceBase::shared_ptr source)
         {
             typename internal::AssignableDataSource<T>::shared_ptr ds =
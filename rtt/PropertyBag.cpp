@@ -52,15 +52,15 @@ namespace RTT
     using namespace std;
 
     PropertyBag::PropertyBag( )
-        : mproperties(), type("PropertyBag")
+        : mproperties(), mindexed(false), type("PropertyBag")
     {}
 
     PropertyBag::PropertyBag( const std::string& _type)
-        : mproperties(), type(_type)
+        : mproperties(), mindexed(false), type(_type)
     {}
 
     PropertyBag::PropertyBag( const PropertyBag& orig)
-        : mproperties(), type( orig.getType() )
+        : mproperties(), mindexed( orig.mindexed ), type( orig.getType() )
     {
         for( const_iterator i = orig.mproperties.begin(); i != orig.mproperties.end(); ++i) {
             if ( orig.ownsProperty( *i ) ) {
@@ -96,6 +96,8 @@ namespace RTT
         removeProperty(p);
         mproperties.push_back(p);
         mowned_props.push_back(p);
+        if ( mindexed )
+            index(p);
         return true;
     }
 
@@ -116,6 +118,8 @@ namespace RTT
         if ( ! p.ready() )
             return false;
         mproperties.push_back(&p);
+        if ( mindexed )
+            index(&p);
         return true;
     }
 
@@ -126,6 +130,8 @@ namespace RTT
         iterator i = std::find(mproperties.begin(), mproperties.end(), p);
         if ( i != mproperties.end() ) {
             mproperties.erase(i);
+            if ( mindexed )
+                unindex(p);
             i = std::find(mowned_props.begin(), mowned_props.end(), p);
             if ( i != mowned_props.end() ) {
                 delete *i;
@@ -139,6 +145,7 @@ namespace RTT
     void PropertyBag::clear()
     {
         mproperties.clear();
+        mindex.clear();
         for ( iterator i = mowned_props.begin();
               i != mowned_props.end();
               i++ )
@@ -214,8 +221,49 @@ namespace RTT
     };
     /** @endcond */
 
+    void PropertyBag::setIndexed(bool indexed)
+    {
+        mindexed = indexed;
+        mindex.clear();
+        if ( !mindexed )
+            return;
+        for ( const_iterator i = mproperties.begin(); i != mproperties.end(); ++i )
+            index( *i );
+    }
+
+    void PropertyBag::index(PropertyBase* p)
+    {
+        // keeps the first property with this name.
+        mindex.insert( Index::value_type( p->getName(), p ) );
+    }
+
+    void PropertyBag::unindex(PropertyBase* p)
+    {
+        Index::iterator i = mindex.find( p->getName() );
+        if ( i == mindex.end() || i->second != p ) {
+            // p was renamed after it was indexed, or was not the first with its name.
+            for ( i = mindex.begin(); i != mindex.end() && i->second != p; ++i ) {}
+            if ( i == mindex.end() )
+                return;
+        }
+        std::string name = i->first;
+        mindex.erase(i);
+        // the next property with this name takes its place.
+        const_iterator it( std::find_if(mproperties.begin(), mproperties.end(), std::bind2nd(FindProp(), name ) ) );
+        if ( it != mproperties.end() )
+            mindex[name] = *it;
+    }
+
     PropertyBase* PropertyBag::find(const std::string& name) const
     {
+        if ( mindexed ) {
+            Index::const_iterator j = mindex.find( name );
+            if ( j == mindex.end() )
+                return 0;
+            if ( j->second->getName() == name )
+                return j->second;
+            // renamed since it was indexed, fall through.
+        }
         const_iterator i( std::find_if(mproperties.begin(), mproperties.end(), std::bind2nd(FindProp(), name ) ) );
         if ( i != mproperties.end() )
             return ( *i );
@@ -224,10 +272,7 @@ namespace RTT
 
     base::PropertyBase* PropertyBag::getProperty(const std::string& name) const
     {
-        const_iterator i( std::find_if(mproperties.begin(), mproperties.end(), std::bind2nd(FindProp(), name ) ) );
-        if ( i != mproperties.end() )
-            return *i;
-        return 0;
+        return this->find( name );
     }
 
 
@@ -338,6 +383,41 @@ namespace RTT
         return 0; // failure
     }
 
+    PropertyPath splitPropertyPath(const std::string& path, const std::string& separator)
+    {
+        PropertyPath result;
+        if ( separator.empty() ) {
+            result.push_back( path );
+            return result;
+        }
+        std::string::size_type start = 0;
+        while ( start < path.length() ) {
+            std::string::size_type len = path.find(separator, start);
+            if ( len == std::string::npos )
+                len = path.length();
+            if ( len != start ) // skip 'root' and empty names.
+                result.push_back( path.substr(start, len - start) );
+            start = len + separator.length();
+        }
+        return result;
+    }
+
+    PropertyBase* findProperty(const PropertyBag& bag, const PropertyPath& path)
+    {
+        const PropertyBag* walker = &bag;
+        PropertyBase* result = 0;
+        for ( PropertyPath::const_iterator it = path.begin(); it != path.end(); ++it ) {
+            result = walker->find( *it );
+            if ( result == 0 )
+                return 0;
+            Property<PropertyBag>* result_bag = dynamic_cast<Property<PropertyBag>*>(result);
+            if ( result_bag == 0 )
+                return result; // not a bag, so it is a result.
+            walker = &result_bag->rvalue();
+        }
+        return result;
+    }
+
     /** @cond */
     /** Recursively reads the names of a bag.
      */
@@ -501,6 +581,15 @@ namespace RTT
             return false;
         }
 
+        // look up the names of target in an indexed view on source.
+        PropertyBag indexed;
+        const PropertyBag* lookup = &source;
+        if ( !source.isIndexed() && source.size() > 8 ) {
+            indexed.setIndexed(true);
+            indexed = source;
+            lookup = &indexed;
+        }
+
         //iterate over source, update PropertyBases
         PropertyBag::const_iterator it( target.getProperties().begin() );
         bool failure = false;
@@ -510,7 +599,7 @@ namespace RTT
             if ( (*it)->getName() == "" ) //&& target.getType() == "Sequence" )
                 srcprop = source.getItem( it - target.getProperties().begin() );
             else
-                srcprop = source.find( (*it)->getName() );
+                srcprop = lookup->find( (*it)->getName() );
             PropertyBase* tgtprop = *it;
             if (srcprop != 0)
             {
@@ -575,13 +664,27 @@ namespace RTT
         // Make an updated if present, create if not present
         //iterate over source, update or clone PropertyBases
 
-        PropertyBag::Names allnames = source.list();
-        PropertyBag::Names::const_iterator endnames = std::unique(allnames.begin(), allnames.end());
+        // group the properties by name, in the order in which the names appear in source.
+        typedef boost::unordered_map<std::string, PropertyBag::Properties> Groups;
+        PropertyBag::Names allnames;
+        Groups sourcegroups, targetgroups;
+        for ( PropertyBag::const_iterator sit = source.begin(); sit != source.end(); ++sit ) {
+            PropertyBag::Properties& group = sourcegroups[ (*sit)->getName() ];
+            if ( group.empty() )
+                allnames.push_back( (*sit)->getName() );
+            group.push_back( *sit );
+        }
+        for ( PropertyBag::const_iterator tit = target.begin(); tit != target.end(); ++tit ) {
+            Groups::iterator group = sourcegroups.find( (*tit)->getName() );
+            if ( group != sourcegroups.end() )
+                targetgroups[ (*tit)->getName() ].push_back( *tit );
+        }
+
         PropertyBag::Names::const_iterator it( allnames.begin() );
-        while ( it != endnames )
+        while ( it != allnames.end() )
         {
-            PropertyBag::Properties sources = source.getProperties(*it);
-            PropertyBag::Properties mines = target.getProperties(*it);
+            const PropertyBag::Properties& sources = sourcegroups[*it];
+            PropertyBag::Properties& mines = targetgroups[*it];
             PropertyBag::iterator mit = mines.begin();
             for( PropertyBag::const_iterator sit = sources.begin(); sit != sources.end(); ++sit ) {
                 if ( mit != mines.end() ) {
@@ -42,6 +42,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <boost/unordered_map.hpp>
 
 #ifdef ORO_PRAGMA_INTERFACE
 #pragma interface
@@ -90,6 +91,9 @@ namespace RTT
      Property<ClassT> pb = bag.getProperty( "name" ).
      @endverbatim
      * Both will return null if no such property exists.
+     *
+     * Bags with many properties can keep an index on the names of
+     * their properties, see setIndexed().
 	 * @see base::PropertyBase, Property, BagOperations
      * @ingroup CoreLibProperties
 	 */
@@ -241,6 +245,12 @@ namespace RTT
         template<class T>
         Property<T>* getPropertyType(const std::string& name) const
         {
+            if ( mindexed ) {
+                // the first property with this name is also the first of this type.
+                Property<T>* p = dynamic_cast<Property<T>* >( this->find(name) );
+                if ( p )
+                    return p;
+            }
             const_iterator i( std::find_if(mproperties.begin(), mproperties.end(), std::bind2nd(FindPropType<T>(), name ) ) );
             if ( i != mproperties.end() )
                 return dynamic_cast<Property<T>* >(*i);
@@ -350,6 +360,22 @@ namespace RTT
          */
         Names getPropertyNames() const { return list(); }
 
+        /**
+         * Keep an index on the names of the properties in this bag,
+         * such that find(), getProperty() and getPropertyType() do not
+         * need to compare the name of every property. The index is kept
+         * up to date by the members of this class, but not when a property
+         * is renamed or when getProperties() is modified directly: call
+         * setIndexed(true) again after doing so.
+         * @param indexed false to drop the index.
+         */
+        void setIndexed(bool indexed);
+
+        /**
+         * Returns true if this bag keeps an index on the names of its properties.
+         */
+        bool isIndexed() const { return mindexed; }
+
         iterator begin() { return mproperties.begin(); }
         const_iterator begin() const { return mproperties.begin(); }
         iterator end() { return mproperties.end(); }
@@ -358,6 +384,23 @@ namespace RTT
         Properties mproperties;
         Properties mowned_props;
 
+        /**
+         * Maps a name to the first property with that name.
+         */
+        typedef boost::unordered_map<std::string, base::PropertyBase*> Index;
+        Index mindex;
+        bool mindexed;
+
+        /**
+         * Adds \a p to the index, after it was added to mproperties.
+         */
+        void index(base::PropertyBase* p);
+
+        /**
+         * Removes \a p from the index, after it was removed from mproperties.
+         */
+        void unindex(base::PropertyBase* p);
+
         /**
          * A function object for finding a Property by name and type.
          */
@@ -408,6 +451,35 @@ namespace RTT
      */
     RTT_API base::PropertyBase* findProperty(const PropertyBag& bag, const std::string& path, const std::string& separator = std::string(".") );
 
+    /**
+     * A path to a Property in nested PropertyBags, as the sequence
+     * of the names of the bags and the name of the Property.
+     * @see splitPropertyPath
+     * @ingroup CoreLibProperties
+     */
+    typedef std::vector<std::string> PropertyPath;
+
+    /**
+     * Splits \a path in the names it consists of, such that it can be
+     * looked up repeatedly without parsing it again.
+     * @param path A sequence of names, separated by \a separator.
+     * @param separator The token to separate properties in the \a path,
+     * Defaults to ".".
+     * @ingroup CoreLibProperties
+     */
+    RTT_API PropertyPath splitPropertyPath(const std::string& path, const std::string& separator = std::string(".") );
+
+    /**
+     * This function locates a Property in nested PropertyBags,
+     * using a path returned by splitPropertyPath().
+     *
+     * @param bag The bag to look for a Property.
+     * @param path The names of the bags and the Property, omitting
+     * the name of the \a bag itself.
+     * @ingroup CoreLibProperties
+     */
+    RTT_API base::PropertyBase* findProperty(const PropertyBag& bag, const PropertyPath& path);
+
     /**
      * List all properties in a PropertyBag in a single list.
      * The returned list has the form 'item1'...'subbag.subsubbag.itemN',
@@ -49,7 +49,8 @@
 
 #include "internal/DataSource.hpp"
 #include "internal/mystd.hpp"
-#include "internal/MWSRQueue.hpp"
+#include "os/CAS.hpp"
+#include "internal/ExecutionEngineService.hpp"
 #include "OperationCaller.hpp"
 
 #include "rtt-config.h"
@@ -69,7 +70,7 @@ namespace RTT
 
     TaskContext::TaskContext(const std::string& name, TaskState initial_state /*= Stopped*/)
         :  TaskCore( initial_state)
-           ,portqueue( new MWSRQueue<PortInterface*>(64) )
+           ,mevent_ports( new EventPorts() )
            ,tcservice(new Service(name,this) ), tcrequests( new ServiceRequester(name,this) )
 #if defined(ORO_ACT_DEFAULT_SEQUENTIAL)
            ,our_act( new SequentialActivity( this->engine() ) )
@@ -82,7 +83,7 @@ namespace RTT
 
     TaskContext::TaskContext(const std::string& name, ExecutionEngine* parent, TaskState initial_state /*= Stopped*/ )
         :  TaskCore(parent, initial_state)
-           ,portqueue( new MWSRQueue<PortInterface*>(64) )
+           ,mevent_ports( new EventPorts() )
            ,tcservice(new Service(name,this) ), tcrequests( new ServiceRequester(name,this) )
 #if defined(ORO_ACT_DEFAULT_SEQUENTIAL)
            ,our_act( parent ? 0 : new SequentialActivity( this->engine() ) )
@@ -148,7 +149,11 @@ namespace RTT
             }
             // Do not call this->disconnect() !!!
             // Ports are probably already destructed by user code.
-            delete portqueue;
+            for (EventPorts::iterator it = mevent_ports->begin(); it != mevent_ports->end(); ++it)
+                delete *it;
+            delete mevent_ports;
+            for (std::vector<EventPorts*>::iterator it = mretired_event_ports.begin(); it != mretired_event_ports.end(); ++it)
+                delete *it;
         }
 
     bool TaskContext::connectPorts( TaskContext* peer )
@@ -227,12 +232,15 @@ namespace RTT
     }
 
     bool TaskContext::prepareProvide(const std::string& name) {
-         return tcservice->hasService(name) || plugin::PluginLoader::Instance()->loadService(name, this);
+         return loadService(name);
     }
 
     bool TaskContext::loadService(const std::string& service_name) {
         if ( provides()->hasService(service_name))
             return true;
+        // built in, but only added on request.
+        if ( service_name == "engine" )
+            return provides()->addService( Service::shared_ptr( new ExecutionEngineService(this) ) );
         return PluginLoader::Instance()->loadService(service_name, this);
     }
 
@@ -418,34 +426,83 @@ namespace RTT
         return false;
     }
 
+    TaskContext::EventPortEntry* TaskContext::eventPortEntry(EventPorts* eps, PortInterface* port)
+    {
+        int index = port->getEventIndex();
+        if ( index < 0 || index >= int(eps->size()) || (*eps)[index]->port != port )
+            return 0;
+        return (*eps)[index];
+    }
+
     void TaskContext::dataOnPort(PortInterface* port)
     {
-        portqueue->enqueue( port );
+        // lock-free: this is called from the thread that wrote the data.
+        EventPortEntry* entry = eventPortEntry( mevent_ports, port );
+        // only the first sample since the last update raises the flag.
+        if ( entry && !os::CAS( &entry->pending, 0, 1) )
+            entry->coalesced.inc();
         this->getActivity()->trigger();
     }
 
     void TaskContext::dataOnPortCallback(InputPortInterface* port, TaskContext::SlotFunction callback) {
-        // user_callbacks will only be emitted from updateHook().
+        // user callbacks will only be emitted from updateHook().
         MutexLock lock(mportlock);
-        user_callbacks[port] = callback;
+        EventPortEntry* entry = eventPortEntry( mevent_ports, port );
+        if ( entry ) {
+            entry->callback = callback;
+            return;
+        }
+        EventPorts::iterator it = mevent_ports->begin();
+        while ( it != mevent_ports->end() && (*it)->port != 0 )
+            ++it;
+        if ( it == mevent_ports->end() ) {
+            // all entries are used: publish an index with twice as many
+            // free entries, such that the copies stay linear in the number of ports.
+            EventPorts* old_eps = mevent_ports;
+            EventPorts* eps = new EventPorts( *old_eps );
+            eps->reserve( std::max<size_t>(4, 2 * old_eps->size()) );
+            while ( eps->size() != eps->capacity() ) {
+                entry = new EventPortEntry();
+                entry->port = 0;
+                entry->pending = 0;
+                eps->push_back( entry );
+            }
+            mretired_event_ports.push_back( old_eps );
+            os::CAS( &mevent_ports, old_eps, eps );
+            it = mevent_ports->begin() + old_eps->size();
+        }
+        entry = *it;
+        entry->pending = 0;
+        entry->coalesced.set(0);
+        entry->callback = callback;
+        port->setEventIndex( it - mevent_ports->begin() );
+        entry->port = port;
     }
 
     void TaskContext::dataOnPortRemoved(PortInterface* port) {
         MutexLock lock(mportlock);
-        UserCallbacks::iterator it = user_callbacks.find(port);
-        if (it != user_callbacks.end() ) {
-            user_callbacks.erase(it);
+        EventPortEntry* entry = eventPortEntry( mevent_ports, port );
+        if ( entry ) {
+            entry->port = 0;
+            entry->callback = SlotFunction();
+            entry->pending = 0;
+            port->setEventIndex( -1 );
         }
     }
 
+    unsigned int TaskContext::coalescedEvents(PortInterface* port) const {
+        EventPortEntry* entry = eventPortEntry( mevent_ports, port );
+        return entry ? entry->coalesced.read() : 0;
+    }
+
     void TaskContext::prepareUpdateHook()
     {
         MutexLock lock(mportlock);
-        PortInterface* port = 0;
-        while ( portqueue->dequeue( port ) == true ) {
-            UserCallbacks::iterator it = user_callbacks.find(port);
-            if (it != user_callbacks.end() )
-                it->second(port); // fire the user callback
+        for (EventPorts::iterator it = mevent_ports->begin(); it != mevent_ports->end(); ++it) {
+            EventPortEntry* entry = *it;
+            // clear the flag first, such that data arriving during the callback triggers it again.
+            if ( entry->port && os::CAS( &entry->pending, 1, 0) && entry->callback )
+                entry->callback( entry->port ); // fire the user callback
         }
     }
 }
@@ -46,6 +46,7 @@
 #include "DataFlowInterface.hpp"
 #include "ExecutionEngine.hpp"
 #include "base/TaskCore.hpp"
+#include "os/Atomic.hpp"
 #include <boost/make_shared.hpp>
 
 #include <string>
@@ -320,6 +321,8 @@ namespace RTT
 
         /**
          * Use this method to load a service known to RTT into this component.
+         * The 'engine' service, see internal::ExecutionEngineService, is built
+         * into RTT and is loaded without the PluginLoader.
          * @param service_name The name with which the service is registered by in the PluginLoader.
          * @return true if the service was present already or could be loaded.
          */
@@ -627,9 +630,42 @@ namespace RTT
         void setup();
 
         friend class DataFlowInterface;
-        internal::MWSRQueue<base::PortInterface*>* portqueue;
-        typedef std::map<base::PortInterface*, SlotFunction > UserCallbacks;
-        UserCallbacks user_callbacks;
+        /**
+         * An event port of this component, its user callback and
+         * the flag that is raised when new data arrives on the port.
+         * Entries are only deleted with this component, such that
+         * dataOnPort() can use them without taking a lock. Removing a
+         * port clears its entry, which is reused by the next event port.
+         * Each port stores the position of its entry, see
+         * base::PortInterface::getEventIndex().
+         */
+        struct EventPortEntry {
+            base::PortInterface* volatile port;
+            SlotFunction callback;
+            volatile int pending;
+            os::AtomicInt coalesced;
+        };
+        typedef std::vector<EventPortEntry*> EventPorts;
+        /**
+         * The dense index of event ports. It is never modified once
+         * published: when all its entries are used, a copy with twice
+         * as many entries is published and the old index is retired,
+         * because dataOnPort() might still be reading it.
+         */
+        EventPorts* volatile mevent_ports;
+        std::vector<EventPorts*> mretired_event_ports;
+
+        /**
+         * Returns the number of times new data on \a port arrived
+         * while the previous data was not yet handled.
+         */
+        unsigned int coalescedEvents(base::PortInterface* port) const;
+
+        /**
+         * Returns the entry of \a port in \a eps, or null if it
+         * is not an event port of this component.
+         */
+        static EventPortEntry* eventPortEntry(EventPorts* eps, base::PortInterface* port);
 
         /**
          * This callback is called each time data arrived on an
@@ -0,0 +1,430 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  BroadcastBuffer.hpp
+
+                        BroadcastBuffer.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_BROADCAST_BUFFER_HPP
+#define ORO_BROADCAST_BUFFER_HPP
+
+#include "../os/CAS.hpp"
+#include "../os/Mutex.hpp"
+#include "../os/MutexLock.hpp"
+#include "rtt-base-fwd.hpp"
+#include <boost/shared_ptr.hpp>
+#include <boost/call_traits.hpp>
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+namespace RTT
+{ namespace base {
+
+    /**
+     * A lock-free circular buffer which is shared by all readers of an
+     * output port. Each sample is stored only once, and every reader
+     * keeps its own read cursor in the buffer. When a reader falls behind
+     * more than capacity() samples, it skips the samples that were
+     * overwritten in the mean time.
+     *
+     * Samples live in reference counted elements. The buffer holds one
+     * reference on each element that is still in the ring, and every
+     * reader holds one while it is accessing an element, such that the
+     * writer never overwrites an element that is being read. Each reader
+     * may hold at most three elements at the same time (its last read
+     * sample, the sample it is reading and a shared reference given to
+     * the user), for which storage is reserved in addReader(). The number
+     * of readers is only limited by the 16 bit index of the elements.
+     *
+     * One thread may write and any number of threads may read this buffer.
+     * @param T The value type to be stored in the Buffer.
+     * @ingroup PortBuffers
+     */
+    template<class T>
+    class BroadcastBuffer
+    {
+    public:
+        typedef T value_t;
+        typedef typename boost::call_traits<T>::param_type param_t;
+        typedef unsigned int size_type;
+        typedef unsigned long cursor_t;
+        typedef boost::shared_ptr< BroadcastBuffer<T> > shared_ptr;
+
+        /**
+         * The number of elements reserved for each reader.
+         */
+        static const unsigned int ITEMS_PER_READER = 3;
+    private:
+        /**
+         * The implementation assumes that value is the first
+         * element of this struct.
+         */
+        struct Item {
+            Item() : value(), refs(0), index(0) {}
+            T value;
+            volatile int refs;
+            unsigned short index;
+        };
+
+        // A ring entry packs the sequence number of a sample (upper bits)
+        // and the index of the item which holds it (lower 16 bits).
+        static const unsigned long INDEX_MASK = 0xFFFF;
+        static const unsigned long NO_ITEM = 0xFFFF;
+
+        // The items are kept in chunks which never move, such that
+        // addReader() can add items while the writer and readers
+        // look them up by index.
+        static const unsigned int CHUNK_BITS = 8;
+        static const unsigned int CHUNK_SIZE = 1 << CHUNK_BITS;
+        static const unsigned int NB_CHUNKS = (NO_ITEM >> CHUNK_BITS) + 1;
+
+        const size_type cap;
+        Item** pool[NB_CHUNKS];
+        size_type nb_items;
+        volatile size_type pool_size;
+        size_type alloc_hint;
+        volatile unsigned long* ring;
+        volatile cursor_t write_seq;
+        T initial;
+
+        os::Mutex readers_lock;
+        std::vector<const void*> readers;
+        const void* volatile writer;
+
+        static Item* item_of(value_t* value) {
+            return reinterpret_cast<Item*>(value);
+        }
+
+        static unsigned long entry(cursor_t seq, unsigned short index) {
+            return (seq << 16) | index;
+        }
+
+        /**
+         * Only the lower bits of the sequence number fit in an entry, which
+         * are 16 bits where unsigned long has 32 bits. Pop() checks that
+         * write_seq did not pass seq + cap when it read the entry, so the
+         * entry holds either sample seq or seq + cap, which always differ
+         * in these bits since cap is smaller than 2^16.
+         */
+        static bool isEntryOf(unsigned long entry, cursor_t seq) {
+            return (entry >> 16) == ((seq << 16) >> 16);
+        }
+
+        Item* at(size_type index) const {
+            return pool[index >> CHUNK_BITS][index & (CHUNK_SIZE - 1)];
+        }
+
+        /**
+         * Grabs a free item for the writer.
+         * @return null if all items are in use.
+         */
+        Item* allocate() {
+            size_type n = pool_size;
+            for (size_type i = 0; i != n; ++i) {
+                Item* item = at( (alloc_hint + i) % n );
+                if ( item->refs == 0 && os::CAS(&item->refs, 0, 1) ) {
+                    alloc_hint = (alloc_hint + i + 1) % n;
+                    return item;
+                }
+            }
+            return 0;
+        }
+
+        /**
+         * Adds a reader reference to an item, unless it was freed
+         * by the writer in the mean time.
+         */
+        static bool tryRef(Item* item) {
+            int refs;
+            do {
+                refs = item->refs;
+                if (refs == 0)
+                    return false;
+            } while ( !os::CAS(&item->refs, refs, refs + 1) );
+            return true;
+        }
+
+        static void unref(Item* item) {
+            int refs;
+            do {
+                refs = item->refs;
+                assert( refs > 0 );
+            } while ( !os::CAS(&item->refs, refs, refs - 1) );
+        }
+
+        Item* grow() {
+            if ( (nb_items & (CHUNK_SIZE - 1)) == 0 )
+                pool[nb_items >> CHUNK_BITS] = new Item*[CHUNK_SIZE];
+            Item* item = new Item();
+            item->value = initial;
+            item->index = nb_items;
+            pool[nb_items >> CHUNK_BITS][nb_items & (CHUNK_SIZE - 1)] = item;
+            ++nb_items;
+            return item;
+        }
+
+        BroadcastBuffer(BroadcastBuffer const&);
+        BroadcastBuffer& operator=(BroadcastBuffer const&);
+    public:
+        /**
+         * Create a broadcast buffer which can store \a bufsize elements.
+         * @param bufsize the capacity of the buffer.
+         * @param initial_value A sample used to size the storage elements.
+         */
+        BroadcastBuffer( size_type bufsize, const T& initial_value = T() )
+            : cap( bufsize ? bufsize : 1 ), nb_items(0),
+              pool_size(0), alloc_hint(0), ring( new unsigned long[cap] ),
+              write_seq(0), initial(initial_value), writer(0)
+        {
+            assert( cap + 1 + ITEMS_PER_READER <= NO_ITEM );
+            for (size_type i = 0; i != cap + 1; ++i)
+                grow();
+            pool_size = nb_items;
+            for (size_type i = 0; i != cap; ++i)
+                ring[i] = entry(0, NO_ITEM);
+        }
+
+        ~BroadcastBuffer() {
+            delete[] ring;
+            for (size_type i = 0; i != nb_items; ++i)
+                delete at(i);
+            for (size_type c = 0; c * CHUNK_SIZE < nb_items; ++c)
+                delete[] pool[c];
+        }
+
+        /**
+         * Registers a reader of this buffer and reserves storage for it.
+         * The first registered reader is the writer of this buffer.
+         * @param reader An opaque identification of the reader.
+         * @return false if no more elements can be indexed for this reader.
+         * @nrt
+         */
+        bool addReader(const void* reader) {
+            os::MutexLock lock(readers_lock);
+            if ( std::find(readers.begin(), readers.end(), reader) != readers.end() )
+                return true;
+            if ( nb_items + ITEMS_PER_READER > NO_ITEM )
+                return false;
+            for (size_type i = 0; i != ITEMS_PER_READER; ++i)
+                grow();
+            // publish the new items only after they are initialized.
+            os::CAS(&pool_size, pool_size, nb_items);
+            readers.push_back(reader);
+            if ( writer == 0 )
+                writer = reader;
+            return true;
+        }
+
+        /**
+         * Unregisters a reader. If it was the writer, the oldest
+         * remaining reader becomes the writer.
+         * @nrt
+         */
+        void removeReader(const void* reader) {
+            os::MutexLock lock(readers_lock);
+            std::vector<const void*>::iterator it = std::find(readers.begin(), readers.end(), reader);
+            if ( it == readers.end() )
+                return;
+            readers.erase(it);
+            if ( writer == reader )
+                writer = readers.empty() ? 0 : readers.front();
+        }
+
+        /**
+         * Returns true if \a reader is the one that must store the
+         * written samples in this buffer.
+         */
+        bool isWriter(const void* reader) const {
+            return writer == reader;
+        }
+
+        /**
+         * Returns the number of registered readers.
+         */
+        size_type nbReaders() const {
+            return readers.size();
+        }
+
+        /**
+         * Returns the cursor of a reader that only reads the samples written
+         * from now on.
+         * @param with_last If true, the last written sample (if any) will be read as well.
+         */
+        cursor_t begin(bool with_last) const {
+            cursor_t w = write_seq;
+            if ( with_last && w != 0 )
+                return w - 1;
+            return w;
+        }
+
+        size_type capacity() const {
+            return cap;
+        }
+
+        /**
+         * Returns the number of samples \a cursor has not read yet.
+         */
+        size_type size(cursor_t cursor) const {
+            cursor_t w = write_seq;
+            return (w - cursor > cap) ? cap : size_type(w - cursor);
+        }
+
+        /**
+         * Initializes the free elements with a data sample, such that for
+         * dynamically allocated types T, the buffer can reserve place
+         * to hold these elements.
+         * @nts
+         * @nrt
+         */
+        void data_sample( const T& sample ) {
+            os::MutexLock lock(readers_lock);
+            initial = sample;
+            for (size_type i = 0; i != nb_items; ++i)
+                if ( at(i)->refs == 0 )
+                    at(i)->value = sample;
+        }
+
+        T data_sample() const {
+            return initial;
+        }
+
+        /**
+         * Reserves a free element, such that it can be
+         * filled in place and appended with PushLoaned().
+         * @return null if no element is free.
+         */
+        value_t* Loan() {
+            Item* item = allocate();
+            return item ? &item->value : 0;
+        }
+
+        /**
+         * Appends an element obtained with Loan(). The oldest sample
+         * is dropped if the buffer is full.
+         * Only one thread may call this function.
+         */
+        bool PushLoaned(value_t* value) {
+            Item* item = item_of(value);
+            cursor_t seq = write_seq;
+            volatile unsigned long* slot = &ring[ seq % cap ];
+            unsigned long old = *slot;
+            os::CAS(slot, old, entry(seq, item->index));
+            os::CAS(&write_seq, seq, seq + 1);
+            // readers can no longer find the old sample, drop our reference.
+            if ( (old & INDEX_MASK) != NO_ITEM )
+                unref( at(old & INDEX_MASK) );
+            return true;
+        }
+
+        /**
+         * Appends a copy of \a item. The oldest sample is dropped if
+         * the buffer is full.
+         * Only one thread may call this function.
+         * @return false if no element was free.
+         */
+        bool Push( param_t item ) {
+            value_t* value = Loan();
+            if ( value == 0 )
+                return false;
+            *value = item;
+            return PushLoaned(value);
+        }
+
+        /**
+         * Returns the sample at \a cursor and advances it.
+         * The returned element must be given back with Release().
+         * @param cursor The cursor of the reader, samples which were overwritten
+         * are skipped.
+         * @return null if the reader has read all samples.
+         */
+        value_t* Pop( cursor_t& cursor ) {
+            while (true) {
+                cursor_t w = write_seq;
+                if ( cursor == w )
+                    return 0;
+                if ( w - cursor > cap )
+                    cursor = w - cap;
+                // read the slot only after write_seq, or a weakly ordered
+                // CPU may return the entry of the previous round.
+                os::fence();
+                volatile unsigned long* slot = &ring[ cursor % cap ];
+                unsigned long e = *slot;
+                if ( !isEntryOf(e, cursor) ) {
+                    // the writer stored sample cursor + cap in this slot but did
+                    // not advance write_seq yet, which may take long if we preempted
+                    // it: our sample is lost, skip it instead of waiting.
+                    if ( write_seq == w )
+                        ++cursor;
+                    // else overwritten in the mean time: re-evaluate the cursor.
+                    continue;
+                }
+                Item* item = at( e & INDEX_MASK );
+                if ( !tryRef(item) )
+                    continue;
+                // the writer may have recycled it before we got our reference.
+                if ( *slot != e ) {
+                    unref(item);
+                    continue;
+                }
+                // if the writer passed cursor + cap by now, e may be a much
+                // later sample with the same lower sequence bits. tryRef()
+                // ordered this read after the one of e. Re-evaluate the cursor.
+                if ( write_seq - cursor > cap ) {
+                    unref(item);
+                    continue;
+                }
+                ++cursor;
+                return &item->value;
+            }
+        }
+
+        /**
+         * Adds a reference to an element returned by Pop().
+         * Each call must be matched by a call to Release().
+         */
+        bool Ref(value_t* value) {
+            return value && tryRef( item_of(value) );
+        }
+
+        /**
+         * Drops a reference to an element returned by Pop() or Loan().
+         */
+        void Release(value_t* value) {
+            if ( value )
+                unref( item_of(value) );
+        }
+    };
+}}
+
+#endif
@@ -98,6 +98,25 @@ namespace RTT
          * @rt
          */
         virtual void clear() = 0;
+
+        /**
+         * Returns the number of items a circular buffer discarded to make
+         * room for new items, since it was created. A buffer which is not
+         * circular never discards items, it refuses new ones.
+         * @return number of overwritten items.
+         * @cts
+         * @rt
+         */
+        virtual size_type overwritten() const { return 0; }
+
+        /**
+         * Returns the highest number of items that were stored in the
+         * buffer at once, since it was created.
+         * @return the high-water mark of size().
+         * @cts
+         * @rt
+         */
+        virtual size_type highWaterMark() const { return 0; }
     };
 }}
 
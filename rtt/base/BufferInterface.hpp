@@ -103,6 +103,35 @@ namespace RTT
 	 **/
 	virtual void Release(value_t *item) = 0;
 	
+        /**
+         * Adds an owner to an element returned by PopWithoutRelease(),
+         * such that it remains valid after the next pop. Each successful
+         * call must be matched by a call to Release().
+         * @return false if this buffer can not share its elements.
+         */
+        virtual bool Ref(value_t* item) { return false; }
+
+        /**
+         * Reserves a free element of this buffer, such that it can be
+         * filled in place and appended with PushLoaned() without copying.
+         * If it is not pushed, it must be given back with Release().
+         * @return a free element or zero if the buffer has no free element
+         * or does not support loaning.
+         * @cts
+         * @rt
+         */
+        virtual value_t* Loan() { return 0; }
+
+        /**
+         * Appends an element obtained with Loan() without copying it.
+         * The buffer takes over \a item, also if it could not be appended.
+         * @param item An element returned by Loan() of this buffer.
+         * @return false if the buffer is full.
+         * @cts
+         * @rt
+         */
+        virtual bool PushLoaned( value_t* item ) { return false; }
+
         /**
          * Write a single value to the buffer.
          * @param item the value to write
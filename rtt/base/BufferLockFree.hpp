@@ -41,7 +41,7 @@
 #include "../os/oro_arch.h"
 #include "../os/CAS.hpp"
 #include "BufferInterface.hpp"
-#include "../internal/AtomicMWSRQueue.hpp"
+#include "../internal/AtomicMPSCQueue.hpp"
 #include "../internal/TsPool.hpp"
 #include <vector>
 
@@ -75,24 +75,35 @@ namespace RTT
         typedef T value_t;
     private:
         typedef T Item;
-        internal::AtomicMWSRQueue<Item*> bufs;
+        internal::AtomicMPSCQueue<Item*> bufs;
         // is mutable because of reference counting.
+        // It holds three elements more than bufs: one for the reader's
+        // last sample, one for an element the reader still refers to
+        // with a SampleRef and one for an element loaned by the writer.
         mutable internal::TsPool<Item> mpool;
         const bool mcircular;
+        // statistics, see overwritten() and highWaterMark().
+        oro_atomic_t moverwritten;
+        size_type mhigh_water;
     public:
         /**
          * Create a lock-free buffer wich can store \a bufsize elements.
          * @param bufsize the capacity of the buffer.
-'         */
+         * A full buffer can still lend one element with Loan() and keep one
+         * element shared with Ref() after it was popped. Holding more elements
+         * makes Push() fail before the buffer is full.
+         */
         BufferLockFree( unsigned int bufsize, const T& initial_value = T(), bool circular = false)
-            : bufs( bufsize ), mpool(bufsize + 1), mcircular(circular)
+            : bufs( bufsize ), mpool(bufsize + 3), mcircular(circular), mhigh_water(0)
         {
+            ORO_ATOMIC_SETUP(&moverwritten, 0);
             mpool.data_sample( initial_value );
         }
 
         ~BufferLockFree() {
             // free all items still in the buffer.
             clear();
+            ORO_ATOMIC_CLEANUP(&moverwritten);
         }
 
         virtual void data_sample( const T& sample )
@@ -132,6 +143,16 @@ namespace RTT
             return bufs.isFull();
         }
 
+        size_type overwritten() const
+        {
+            return oro_atomic_read(&moverwritten);
+        }
+
+        size_type highWaterMark() const
+        {
+            return mhigh_water;
+        }
+
         void clear()
         {
             Item* item;
@@ -153,12 +174,30 @@ namespace RTT
                 else {
                     if (bufs.dequeue( mitem ) == false )
                         return false; // assert(false) ???
+                    oro_atomic_inc(&moverwritten);
                     // we keep mitem to write item to next
                 }
             }
 
             // copy over.
             *mitem = item;
+            return PushLoaned( mitem );
+        }
+
+        value_t* Loan()
+        {
+            Item* mitem = mpool.allocate();
+            if ( mitem == 0 && mcircular ) {
+                // recycle the oldest element, as Push() does.
+                if (bufs.dequeue( mitem ) == false )
+                    return 0;
+                oro_atomic_inc(&moverwritten);
+            }
+            return mitem;
+        }
+
+        bool PushLoaned( value_t* mitem )
+        {
             if (bufs.enqueue( mitem ) == false ) {
                 //got memory, but buffer is full
                 //this can happen, as the memory pool is
@@ -170,11 +209,18 @@ namespace RTT
                     // pop & deallocate until we have free space.
                     Item* itmp = 0;
                     do {
-                        bufs.dequeue( itmp );
-                        mpool.deallocate( itmp );
+                        // a reader may have emptied the queue meanwhile.
+                        if ( bufs.dequeue( itmp ) ) {
+                            mpool.deallocate( itmp );
+                            oro_atomic_inc(&moverwritten);
+                        }
                     } while ( bufs.enqueue( mitem ) == false );
                 }
             }
+            // concurrent writers may miss each other's maximum, which is acceptable for statistics.
+            size_type level = bufs.size();
+            if ( level > mhigh_water )
+                mhigh_water = level;
             return true;
         }
 
@@ -227,6 +273,11 @@ namespace RTT
             if (mpool.deallocate( item ) == false )
                 assert(false);  
 	}
+
+        bool Ref(value_t *item)
+        {
+            return mpool.ref( item );
+        }
     };
 }}
 
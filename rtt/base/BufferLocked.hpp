@@ -75,7 +75,7 @@ namespace RTT
          * @param circular Set flag to true to make this buffer circular. If not circular, new values are discarded on full.
          */
         BufferLocked( size_type size, const T& initial_value = T(), bool circular = false )
-            : cap(size), buf(), mcircular(circular)
+            : cap(size), buf(), mcircular(circular), moverwritten(0), mhigh_water(0)
         {
             data_sample(initial_value);
         }
@@ -103,10 +103,14 @@ namespace RTT
             if ( cap == (size_type)buf.size() ) {
                 if (!mcircular)
                     return false;
-                else
+                else {
                     buf.pop_front();
+                    ++moverwritten;
+                }
             }
             buf.push_back( item );
+            if ( (size_type)buf.size() > mhigh_water )
+                mhigh_water = buf.size();
             return true;
         }
 
@@ -116,19 +120,24 @@ namespace RTT
             typename std::vector<T>::const_iterator itl( items.begin() );
             if (mcircular && (size_type)items.size() >= cap ) {
                 // clear out current data and reset iterator to first element we're going to take.
+                moverwritten += buf.size() + items.size() - cap;
                 buf.clear();
                 itl = items.begin() + ( items.size() - cap );
             } else if ( mcircular && (size_type)(buf.size() + items.size()) > cap) {
                 // drop excess elements from front
                 assert( (size_type)items.size() < cap );
-                while ( (size_type)(buf.size() + items.size()) > cap )
+                while ( (size_type)(buf.size() + items.size()) > cap ) {
                     buf.pop_front();
+                    ++moverwritten;
+                }
                 // itl still points at first element of items.
             }
             while ( ((size_type)buf.size() != cap) && (itl != items.end()) ) {
                 buf.push_back( *itl );
                 ++itl;
             }
+            if ( (size_type)buf.size() > mhigh_water )
+                mhigh_water = buf.size();
             // this is in any case the number of elements taken from items.
             if (mcircular)
                 assert( (size_type)(itl - items.begin() ) == (size_type)items.size() );
@@ -204,12 +213,24 @@ namespace RTT
             os::MutexLock locker(lock);
             return (size_type)buf.size() ==  cap;
         }
+
+        size_type overwritten() const {
+            os::MutexLock locker(lock);
+            return moverwritten;
+        }
+
+        size_type highWaterMark() const {
+            os::MutexLock locker(lock);
+            return mhigh_water;
+        }
     private:
         size_type cap;
         std::deque<T> buf;
         value_t lastSample;
         mutable os::Mutex lock;
         const bool mcircular;
+        size_type moverwritten;
+        size_type mhigh_water;
     };
 }}
 
@@ -68,7 +68,7 @@ namespace RTT
          * Create a buffer of size \a size.
          */
         BufferUnSync( size_type size, const T& initial_value = T(), bool circular = false )
-            : cap(size), buf(), mcircular(circular)
+            : cap(size), buf(), mcircular(circular), moverwritten(0), mhigh_water(0)
         {
             data_sample(initial_value);
         }
@@ -94,10 +94,14 @@ namespace RTT
             if (cap == (size_type)buf.size() ) {
                 if (!mcircular)
                     return false;
-                else
+                else {
                     buf.pop_front();
+                    ++moverwritten;
+                }
             }
             buf.push_back( item );
+            if ( (size_type)buf.size() > mhigh_water )
+                mhigh_water = buf.size();
             return true;
         }
 
@@ -106,19 +110,24 @@ namespace RTT
             typename std::vector<T>::const_iterator itl( items.begin() );
             if (mcircular && (size_type)items.size() >= cap ) {
                 // clear out current data and reset iterator to first element we're going to take.
+                moverwritten += buf.size() + items.size() - cap;
                 buf.clear();
                 itl = items.begin() + ( items.size() - cap );
             } else if ( mcircular && (size_type)(buf.size() + items.size()) > cap) {
                 // drop excess elements from front
                 assert( (size_type)items.size() < cap );
-                while ( (size_type)(buf.size() + items.size()) > cap )
+                while ( (size_type)(buf.size() + items.size()) > cap ) {
                     buf.pop_front();
+                    ++moverwritten;
+                }
                 // itl still points at first element of items.
             }
             while ( ((size_type)buf.size() != cap) && (itl != items.end()) ) {
                 buf.push_back( *itl );
                 ++itl;
             }
+            if ( (size_type)buf.size() > mhigh_water )
+                mhigh_water = buf.size();
             return (itl - items.begin());
         }
 
@@ -185,11 +194,21 @@ namespace RTT
         bool full() const {
             return (size_type)buf.size() ==  cap;
         }
+
+        size_type overwritten() const {
+            return moverwritten;
+        }
+
+        size_type highWaterMark() const {
+            return mhigh_water;
+        }
     private:
         size_type cap;
         std::deque<T> buf;
         value_t lastSample;
         const bool mcircular;
+        size_type moverwritten;
+        size_type mhigh_water;
     };
 }}
 
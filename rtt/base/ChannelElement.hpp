@@ -42,6 +42,7 @@
 #include <boost/intrusive_ptr.hpp>
 #include <boost/call_traits.hpp>
 #include "ChannelElementBase.hpp"
+#include "SampleRef.hpp"
 #include "../FlowStatus.hpp"
 
 namespace RTT { namespace base {
@@ -53,6 +54,12 @@ namespace RTT { namespace base {
     template<typename T>
     class ChannelElement : public ChannelElementBase
     {
+        /**
+         * The output which handed out the sample of the last loan(), such
+         * that commit() and release() can give it back even when this
+         * element was disconnected in the mean time.
+         */
+        boost::intrusive_ptr< ChannelElement<T> > loan_output;
     public:
         typedef T value_t;
         typedef boost::intrusive_ptr< ChannelElement<T> > shared_ptr;
@@ -108,6 +115,18 @@ namespace RTT { namespace base {
             return false;
         }
 
+        /** Writes a new sample on this connection like write(), but does not
+         * signal the reader. A writer which delivers a batch of samples calls
+         * signal() once after the last one. By default, write() is called,
+         * which does signal the reader.
+         *
+         * @returns false if an error occured that requires the channel to be invalidated.
+         */
+        virtual bool writeWithoutSignal(param_t sample)
+        {
+            return this->write(sample);
+        }
+
         /** Reads a sample from the connection. \a sample is a reference which
          * will get updated if a sample is available. The method returns true
          * if a sample was available, and false otherwise. If false is returned,
@@ -121,6 +140,71 @@ namespace RTT { namespace base {
             else
                 return NoData;
         }
+
+        /**
+         * Reserves an element of this connection's storage, such that the
+         * writer can fill it in place and pass it to commit() without copying.
+         * By default, the call is forwarded to the output of this element.
+         *
+         * @return null if this connection does not support loaning or has
+         * no free element.
+         */
+        virtual value_t* loan()
+        {
+            typename ChannelElement<T>::shared_ptr output = this->getOutput();
+            if (!output)
+                return 0;
+            value_t* result = output->loan();
+            if (result)
+                loan_output = output;
+            return result;
+        }
+
+        /** Writes a sample that was obtained with loan() on this connection,
+         * without copying it. The connection takes over \a sample, also if it
+         * could not be stored. If this element was disconnected since the
+         * loan(), \a sample is given back to the element which handed it out.
+         *
+         * @returns false if an error occured that requires the channel to be invalidated.
+         */
+        virtual bool commit(value_t* sample)
+        {
+            typename ChannelElement<T>::shared_ptr owner;
+            owner.swap(loan_output);
+            if (!owner)
+                return false;
+            if (owner == this->getOutput())
+                return owner->commit(sample);
+            owner->release(sample);
+            return false;
+        }
+
+        /**
+         * Gives back an element obtained with loan() or handed out by
+         * readRef(), without writing it.
+         */
+        virtual void release(value_t* sample)
+        {
+            typename ChannelElement<T>::shared_ptr owner;
+            owner.swap(loan_output);
+            if (!owner)
+                owner = this->getOutput();
+            if (owner)
+                owner->release(sample);
+        }
+
+        /** Reads a sample from the connection without copying it, if the
+         * storage of this connection allows so. Otherwise, the sample is
+         * copied into the private storage of \a sample. The return values are
+         * the same as for read().
+         */
+        virtual FlowStatus readRef(SampleRef<T>& sample, bool copy_old_data)
+        {
+            FlowStatus result = this->read(sample.storage(), copy_old_data);
+            if ( result == NewData || (result == OldData && copy_old_data) )
+                sample.useStorage();
+            return result;
+        }
     };
 }}
 
@@ -41,6 +41,7 @@
 
 #include "../os/oro_arch.h"
 #include <utility>
+#include <string>
 #include <boost/intrusive_ptr.hpp>
 #include <boost/call_traits.hpp>
 
@@ -49,6 +50,39 @@
 
 namespace RTT { namespace base {
 
+    /**
+     * The data flow statistics of one connection. They are counted
+     * by the channel element that stores the data of the connection.
+     *
+     * The writes, reads, drops and overwrites counters wrap around
+     * modulo 2^32, such that the difference of two snapshots, taken
+     * as unsigned int, remains correct over a wrap.
+     * @see PortInterface::getConnectionStatistics()
+     */
+    struct ChannelStatistics
+    {
+        /** The qualified name of the port at the other side of the
+         * connection, or the name of the stream. */
+        std::string peer;
+        /** The number of samples written into the connection. */
+        unsigned int writes;
+        /** The number of samples read from the connection as NewData. */
+        unsigned int reads;
+        /** The number of samples refused because the buffer was full. */
+        unsigned int drops;
+        /** The number of samples overwritten before they were read. */
+        unsigned int overwrites;
+        /** The number of samples that were stored but not read yet. */
+        int size;
+        /** The highest number of samples that was stored at once. */
+        int high_water;
+        /** The number of samples the connection can store. */
+        int capacity;
+
+        ChannelStatistics()
+            : writes(0), reads(0), drops(0), overwrites(0), size(0), high_water(0), capacity(0) {}
+    };
+
     /** In the data flow implementation, a channel is created by chaining
      * ChannelElementBase objects.
      *
@@ -168,6 +202,13 @@ namespace RTT { namespace base {
          * port (or a proxy representing the port) otherwise.
          */
         virtual PortInterface* getPort() const;
+
+        /**
+         * Fills in the counters of \a stats if this element stores the
+         * data of the connection. It leaves \a stats.peer untouched.
+         * @return false if this element does not store data.
+         */
+        virtual bool getStatistics(ChannelStatistics& stats);
     };
 
     void RTT_API intrusive_ptr_add_ref( ChannelElementBase* e );
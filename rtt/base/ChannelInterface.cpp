@@ -132,6 +132,11 @@ PortInterface* ChannelElementBase::getPort() const {
     return 0;
 }
 
+bool ChannelElementBase::getStatistics(ChannelStatistics& stats)
+{
+    return false;
+}
+
 void ChannelElementBase::ref()
 {
     oro_atomic_inc(&refcount);
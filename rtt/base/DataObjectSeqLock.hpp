@@ -0,0 +1,177 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  DataObjectSeqLock.hpp
+
+                        DataObjectSeqLock.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef CORELIB_DATAOBJECT_SEQLOCK_HPP
+#define CORELIB_DATAOBJECT_SEQLOCK_HPP
+
+
+#include "../os/CAS.hpp"
+#include "DataObjectInterface.hpp"
+
+namespace RTT
+{ namespace base {
+
+    /**
+     * @brief A DataObject for a single writer which is read by copying
+     * from a ring of sequence numbered slots (a 'seqlock').
+     *
+     * Set() writes in the slot after the last written one, increments
+     * the sequence number of that slot before and after the copy and
+     * then publishes it. It never waits for readers. Get() copies the
+     * last published slot and checks its sequence number afterwards: if the
+     * writer wrote in that slot in the meantime, the copy is redone from
+     * the newest slot. This only happens when the writer went around the
+     * whole ring during one copy. Readers do not write any shared memory,
+     * so any number of them can read concurrently without contending.
+     *
+     * Because a reader may copy a slot while it is being written,
+     * the data type must be copyable bit by bit (no pointers to
+     * owned memory, like in std::vector or std::string). ConnFactory
+     * only uses this data object for such types.
+     * @verbatim
+     * The following Truth table applies when a Low Priority thread is
+     * preempted by a High Priority thread :
+     *   L\H | Set | Get |
+     *   Set | NA  | Ok  |
+     *   Get | Ok  | Ok  |
+     * legend : L : Low Priority thread
+     *          H : High Priority thread
+     *          NA : Not allowed !
+     * @endverbatim
+     * @ingroup PortBuffers
+     */
+    template<class T>
+    class DataObjectSeqLock
+        : public DataObjectInterface<T>
+    {
+    public:
+        /**
+         * The type of the data.
+         */
+        typedef T DataType;
+
+    private:
+        /**
+         * The number of slots in the ring.
+         */
+        const unsigned int BUF_LEN;
+
+        struct DataBuf {
+            DataBuf() : seq(0), data() {}
+            /**
+             * Odd while the writer is writing in this slot.
+             */
+            volatile unsigned int seq;
+            DataType data;
+        };
+
+        DataBuf* data;
+
+        /**
+         * The index of the last published slot.
+         */
+        volatile unsigned int read_index;
+
+    public:
+        /**
+         * Construct a DataObjectSeqLock.
+         * @param initial_value The initial value of this DataObject.
+         * @param slots The number of slots in the ring, at least 2.
+         * A reader needs to redo its copy only if the writer writes
+         * \a slots times during that copy.
+         */
+        DataObjectSeqLock( const T& initial_value = T(), unsigned int slots = 3 )
+            : BUF_LEN( slots < 2 ? 2 : slots ), data( new DataBuf[BUF_LEN] ), read_index(0)
+        {
+            data_sample(initial_value);
+        }
+
+        ~DataObjectSeqLock() {
+            delete[] data;
+        }
+
+        /**
+         * Get a copy of the data.
+         * This method will allocate memory twice if data is not a value type.
+         * Use Get(DataType&) for the non-allocating version.
+         * @return A copy of the data.
+         */
+        virtual DataType Get() const {DataType cache; Get(cache); return cache; }
+
+        /**
+         * Get a copy of the Data (non allocating, no atomic operations
+         * on shared memory).
+         * @param pull A copy of the data.
+         */
+        virtual void Get( DataType& pull ) const
+        {
+            unsigned int before, after;
+            do {
+                const DataBuf& reading = data[read_index];
+                before = reading.seq;
+                os::fence();
+                pull = reading.data;
+                os::fence();
+                after = reading.seq;
+            } while ( (before & 1) || before != after );
+        }
+
+        /**
+         * Set the data to a certain value (wait-free).
+         * Only one thread may call this method.
+         * @param push The data which must be set.
+         */
+        virtual void Set( const DataType& push )
+        {
+            unsigned int next = read_index + 1 == BUF_LEN ? 0 : read_index + 1;
+            DataBuf& writing = data[next];
+            writing.seq = writing.seq + 1;  // odd: being written
+            os::fence();
+            writing.data = push;
+            os::fence();
+            writing.seq = writing.seq + 1;  // even: complete
+            read_index = next;
+        }
+
+        virtual void data_sample( const DataType& sample ) {
+            for (unsigned int i = 0; i < BUF_LEN; ++i)
+                data[i].data = sample;
+        }
+    };
+}}
+
+#endif
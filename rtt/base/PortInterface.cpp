@@ -39,13 +39,14 @@
 #include "PortInterface.hpp"
 #include "../Service.hpp"
 #include "../OperationCaller.hpp"
+#include "../internal/ConnectionManager.hpp"
 
 using namespace RTT;
 using namespace RTT::detail;
 using namespace std;
 
 PortInterface::PortInterface(const std::string& name)
-    : name(name), iface(0) {}
+    : name(name), mevent_index(-1), iface(0) {}
 
 bool PortInterface::setName(const std::string& name)
 {
@@ -96,3 +97,11 @@ DataFlowInterface* PortInterface::getInterface() const
     return iface;
 }
 
+std::vector<ChannelStatistics> PortInterface::getConnectionStatistics() const
+{
+    std::vector<ChannelStatistics> stats;
+    const ConnectionManager* manager = getManager();
+    if (manager)
+        manager->getStatistics(stats);
+    return stats;
+}
@@ -40,6 +40,7 @@
 #define ORO_EXECUTION_PORT_INTERFACE_HPP
 
 #include <string>
+#include <vector>
 #include "../internal/rtt-internal-fwd.hpp"
 #include "../ConnPolicy.hpp"
 #include "../internal/ConnID.hpp"
@@ -58,6 +59,7 @@ namespace RTT
     {
         std::string name;
         std::string mdesc;
+        int mevent_index;
     protected:
         DataFlowInterface* iface;
 
@@ -198,6 +200,20 @@ namespace RTT
          */
         DataFlowInterface* getInterface() const;
 
+        /**
+         * Sets the slot of this port in the event ports of the
+         * component it belongs to, or -1 if it is no event port.
+         * @internal Used by TaskContext.
+         */
+        void setEventIndex(int index) { mevent_index = index; }
+
+        /**
+         * Returns the slot of this port in the event ports of the
+         * component it belongs to, or -1 if it is no event port.
+         * @internal Used by TaskContext.
+         */
+        int getEventIndex() const { return mevent_index; }
+
         /**
          * Returns the connection manager of this port (if any).
          * This method provides access to the internals of this port
@@ -208,6 +224,12 @@ namespace RTT
          * connections of this port.
          */
         virtual const internal::ConnectionManager* getManager() const = 0;
+
+        /**
+         * Returns the data flow statistics of each connection of this port.
+         * @see ChannelStatistics for the meaning of each counter.
+         */
+        std::vector<ChannelStatistics> getConnectionStatistics() const;
 };
 
 }}
@@ -0,0 +1,150 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  SampleRef.hpp
+
+                        SampleRef.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_SAMPLE_REF_HPP
+#define ORO_SAMPLE_REF_HPP
+
+#include <boost/intrusive_ptr.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/noncopyable.hpp>
+#include "rtt-base-fwd.hpp"
+
+namespace RTT { namespace base {
+
+    /**
+     * A read-only view on a data sample that was read from a connection
+     * without copying it. It is filled in by InputPort::readRef().
+     *
+     * If the connection stores its samples in a lock-free buffer, the view
+     * points directly into the buffer's storage and holds a reference on that
+     * element, such that the writer can not recycle it as long as the view
+     * exists or until it is read into again. Other connections copy the sample
+     * into a private sample of this object, which is allocated on first use.
+     *
+     * A SampleRef is meant to be kept by the reader, just like a plain data
+     * sample, and is not thread-safe. A lock-free buffer reserves storage for
+     * one SampleRef per connection next to its capacity: each additional
+     * SampleRef that holds an element of the same connection lowers the
+     * number of samples the writer can store, and writes which find no free
+     * element are counted as drops in the ChannelStatistics.
+     * @ingroup Ports
+     */
+    template<typename T>
+    class SampleRef
+        : private boost::noncopyable
+    {
+        typedef boost::intrusive_ptr< ChannelElement<T> > owner_t;
+        owner_t mowner;
+        T* msample;
+        boost::scoped_ptr<T> mcopy;
+    public:
+        typedef T value_t;
+
+        SampleRef() : mowner(), msample(0), mcopy() {}
+
+        ~SampleRef() { reset(); }
+
+        /**
+         * Returns true if this object refers to a sample.
+         */
+        bool valid() const { return msample != 0; }
+
+        T const& operator*() const { return *msample; }
+
+        T const* operator->() const { return msample; }
+
+        /**
+         * Returns the sample this object refers to or null if !valid().
+         */
+        T const* get() const { return msample; }
+
+        /**
+         * Returns true if this object refers to an element of a connection's
+         * storage, false if it refers to its private copy or to nothing.
+         */
+        bool isShared() const { return mowner != 0; }
+
+        /**
+         * Gives the referred element back to the connection it was read from.
+         * After this call, valid() returns false.
+         */
+        void reset()
+        {
+            if (mowner)
+                mowner->release(msample);
+            mowner = 0;
+            msample = 0;
+        }
+
+        /**
+         * Lets this object refer to an element of \a owner's storage.
+         * The caller must have added a reference on \a sample for this object,
+         * which is dropped again by reset() or the next assign().
+         * @internal Used by the channel elements.
+         */
+        void assign(ChannelElement<T>* owner, T* sample)
+        {
+            reset();
+            mowner = owner;
+            msample = sample;
+        }
+
+        /**
+         * Returns the private copy of this object, which is created upon the
+         * first call. It does not change what this object refers to.
+         * @internal Used by the channel elements.
+         */
+        T& storage()
+        {
+            if (!mcopy)
+                mcopy.reset( new T() );
+            return *mcopy;
+        }
+
+        /**
+         * Lets this object refer to its private copy.
+         * @internal Used by the channel elements.
+         */
+        void useStorage()
+        {
+            reset();
+            msample = &storage();
+        }
+    };
+}}
+
+#endif
@@ -20,6 +20,7 @@ namespace RTT {
         class PropertyIntrospection;
         class RunnableInterface;
         class TaskCore;
+        struct ChannelStatistics;
         struct DataBuf;
         struct OperationCallerBaseInvoker;
         template <class T>
@@ -46,6 +47,8 @@ namespace RTT {
         class DataObjectUnSync;
         template<typename T>
         class ChannelElement;
+        template<typename T>
+        class SampleRef;
     }
     namespace detail {
         using namespace base;
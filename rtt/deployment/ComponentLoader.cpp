@@ -5,6 +5,7 @@
 #include <boost/version.hpp>
 #include <rtt/os/StartStopManager.hpp>
 #include <rtt/plugin/PluginLoader.hpp>
+#include <rtt/plugin/LibraryCache.hpp>
 #include <rtt/types/TypekitRepository.hpp>
 
 #ifdef HAS_ROSLIB
@@ -320,10 +321,22 @@ bool ComponentLoader::import( std::string const& path_list )
 #else
                     libname = itr->path().filename();
 #endif
+                    plugin::LibraryCache::Entry entry;
                     if(!isCompatibleComponent(libname))
                     {
                         log(Debug) << "not a compatible component: ignored."<<endlog();
                     }
+                    else if ( plugin::LibraryCache::Instance()->lookup( itr->path().string(), entry ) )
+                    {
+                        // defer loading until a component of this library is created.
+                        if ( entry.kind == plugin::LibraryCache::Component ) {
+                            log(Debug) << "found in library cache."<<endlog();
+                            for (vector<string>::iterator ct = entry.names.begin(); ct != entry.names.end(); ++ct)
+                                if ( ComponentFactories::Instance().count(*ct) == 0 )
+                                    cachedTypes[*ct] = itr->path().string();
+                        } else
+                            log(Debug) << "not a component library according to the library cache: ignored."<<endlog();
+                    }
                     else
                     {
                         found = true;
@@ -571,6 +584,8 @@ bool ComponentLoader::isImported(string type_name)
     if ( type_name == "ocl" && TypekitRepository::hasTypekit("OCLTypekit")) {
         return true;
     }
+    if ( cachedTypes.count(type_name) )
+        return true;
     return false;
 }
 
@@ -617,7 +632,7 @@ bool ComponentLoader::reloadInProcess(string file, string libname)
 }
 
 // loads a single component in the current process.
-bool ComponentLoader::loadInProcess(string file, string libname, bool log_error) {
+bool ComponentLoader::loadInProcess(string file, string libname, bool log_error, bool lazy) {
     path p(file);
     char* error;
     void* handle;
@@ -631,7 +646,7 @@ bool ComponentLoader::loadInProcess(string file, string libname, bool log_error)
         return false;
     }
 
-    handle = dlopen ( p.string().c_str(), RTLD_NOW);
+    handle = dlopen ( p.string().c_str(), lazy ? RTLD_LAZY : RTLD_NOW);
 
     if (!handle) {
         if ( log_error ) {
@@ -646,6 +661,10 @@ bool ComponentLoader::loadInProcess(string file, string libname, bool log_error)
     LoadedLib loading_lib(file, libname, handle);
     dlerror();    /* Clear any existing error */
 
+    // The component types provided by this library, for the library cache.
+    vector<string> cache_types;
+    bool cacheable = true;
+
     // Lookup Component factories (multi component case):
     FactoryMap* (*getfactory)(void) = 0;
     vector<string> (*getcomponenttypes)(void) = 0;
@@ -663,7 +682,9 @@ bool ComponentLoader::loadInProcess(string file, string libname, bool log_error)
             for (vector<string>::iterator it = ctypes.begin(); it != ctypes.end(); ++it)
                 log(Debug) <<" "<< *it;
             log(Debug) << endlog();
-        }
+            cache_types = ctypes;
+        } else
+            cacheable = false; // we can't tell which types it provides.
         loadedLibs.push_back(loading_lib);
         success = true;
     }
@@ -690,10 +711,18 @@ bool ComponentLoader::loadInProcess(string file, string libname, bool log_error)
         log(Info) << "Loaded component type '"<< cname <<"'"<<endlog();
         loading_lib.components_type.push_back( cname );
         loadedLibs.push_back(loading_lib);
+        cache_types.push_back( cname );
         success = true;
     }
 
-    if (success) return true;
+    if (success) {
+        if (cacheable)
+            plugin::LibraryCache::Instance()->insert( file, plugin::LibraryCache::Component, cache_types );
+        return true;
+    }
+
+    // remember, such that it is not opened again.
+    plugin::LibraryCache::Instance()->insert( file, plugin::LibraryCache::None );
 
     log(Error) <<"Unloading "<< loading_lib.filename  <<": not a valid component library:" <<endlog();
     if (!create_error.empty())
@@ -710,6 +739,10 @@ std::vector<std::string> ComponentLoader::listComponentTypes() const {
     for( it = ComponentFactories::Instance().begin(); it != ComponentFactories::Instance().end(); ++it) {
         names.push_back( it->first );
     }
+    for( map<string,string>::const_iterator ct = cachedTypes.begin(); ct != cachedTypes.end(); ++ct) {
+        if ( ComponentFactories::Instance().count( ct->first ) == 0 )
+            names.push_back( ct->first );
+    }
     return names;
 }
 
@@ -732,6 +765,21 @@ RTT::TaskContext *ComponentLoader::loadComponent(const std::string & name, const
     RTT::TaskContext* (*factory)(std::string name) = 0;
     log(Debug) << "Trying to create component "<< name <<" of type "<< type << endlog();
 
+    // Load the library of a type that was only found in the library cache.
+    map<string,string>::iterator cached = cachedTypes.find(type);
+    if ( cached != cachedTypes.end() ) {
+        string file = cached->second;
+        cachedTypes.erase(cached);
+        if ( ComponentFactories::Instance().count(type) == 0 ) {
+            log(Info) << "Loading component library '" << file << "' for component type " << type << endlog();
+#if BOOST_VERSION >= 104600
+            loadInProcess( file, makeShortFilename( path(file).filename().string() ), true, true );
+#else
+            loadInProcess( file, makeShortFilename( path(file).filename() ), true, true );
+#endif
+        }
+    }
+
     // First: try loading from imported libraries. (see: import).
     if ( ComponentFactories::Instance().count(type) == 1 ) {
         factory = ComponentFactories::Instance()[ type ];
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <vector>
+#include <map>
 #include <boost/shared_ptr.hpp>
 #include <rtt/Component.hpp>
 
@@ -71,6 +72,13 @@ namespace RTT {
 
             std::vector< std::string > loadedPackages;
 
+            /**
+             * Component types found in the library cache during an import,
+             * mapped to the library which provides them. These libraries are
+             * only loaded when a component of such a type is created.
+             */
+            std::map< std::string, std::string > cachedTypes;
+
             /**
              * Path to look for if all else fails.
              */
@@ -82,9 +90,12 @@ namespace RTT {
              * @param shortname The short name of this file
              * @param log_error Log errors to users. Set to false in case you are poking
              * files to see if they can be loaded.
+             * @param lazy Resolve the symbols of the library when they are first used.
+             * Only used for libraries which were loaded successfully before, according
+             * to the library cache.
              * @return true if a new library was loaded or if this library was already loaded.
              */
-            bool loadInProcess(std::string filename, std::string shortname, bool log_error );
+            bool loadInProcess(std::string filename, std::string shortname, bool log_error, bool lazy = false );
 
             /**
              * Internal function that does try to reload a previously loaded library by first dl_close'ing the library.
@@ -0,0 +1,478 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  ThreadPoolActivity.cpp
+
+                        ThreadPoolActivity.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "ThreadPoolActivity.hpp"
+#include "../os/Thread.hpp"
+#include "../os/MutexLock.hpp"
+#include "../os/CAS.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+namespace RTT {
+    using namespace extras;
+    using namespace base;
+
+    /**
+     * A non periodic thread which executes the activities of its
+     * pool until it is stopped.
+     */
+    class ThreadPool::Worker
+        : public os::Thread
+    {
+    public:
+        Worker(ThreadPool* pool, unsigned int index, int scheduler, int priority, unsigned cpu_affinity, const std::string& name)
+            : os::Thread(scheduler, priority, 0.0, cpu_affinity, name),
+              index(index), mpool(pool), mbreak(false)
+        {
+        }
+
+        ~Worker()
+        {
+            // stop here, breakLoop() is no longer ours in ~Thread().
+            this->stop();
+        }
+
+        void loop()
+        {
+            while ( !mbreak ) {
+                ThreadPoolActivity* act = mpool->next(this);
+                if ( act )
+                    act->work(this);
+                else
+                    mpool->waitForWork(this);
+            }
+        }
+
+        bool breakLoop()
+        {
+            mbreak = true;
+            os::MutexLock lock(mpool->msleep_lock);
+            mpool->msleep_cond.broadcast();
+            return true;
+        }
+
+        const unsigned int index;
+        std::deque<ThreadPoolActivity*> queue;
+        os::Mutex queue_lock;
+        ThreadPool* mpool;
+        volatile bool mbreak;
+    };
+
+    /**
+     * The thread of a ThreadPoolActivity. It is the worker which executes
+     * the activity for isSelf() and the pool for all other queries.
+     */
+    class ThreadPoolActivity::PoolThread
+        : public os::ThreadInterface
+    {
+    public:
+        PoolThread(ThreadPoolActivity* act)
+            : mact(act)
+        {
+        }
+
+        bool start() { return false; }
+
+        bool stop() { return false; }
+
+        Seconds getPeriod() const { return 0.0; }
+
+        bool setPeriod(Seconds s) { return s == 0.0; }
+
+        nsecs getPeriodNS() const { return 0; }
+
+        bool isRunning() const { return mact->isRunning(); }
+
+        bool isActive() const { return mact->isActive(); }
+
+        const char* getName() const { return worker()->getName(); }
+
+        RTOS_TASK * getTask() { return worker()->getTask(); }
+
+        const RTOS_TASK * getTask() const { return worker()->getTask(); }
+
+        bool setScheduler(int sched_type) { return false; }
+
+        int getScheduler() const { return mact->mpool->getScheduler(); }
+
+        bool setPriority(int priority) { return false; }
+
+        int getPriority() const { return mact->mpool->getPriority(); }
+
+        unsigned int getPid() const { return worker()->getPid(); }
+
+        void setMaxOverrun(int m) {}
+
+        int getMaxOverrun() const { return 0; }
+
+        void setWaitPeriodPolicy(int p) {}
+
+        void yield() { worker()->yield(); }
+
+        bool isSelf() const
+        {
+            ThreadPool::Worker* w = mact->mworker;
+            return w && w->isSelf();
+        }
+
+    private:
+        /**
+         * The worker which executes the activity or, if none does,
+         * the first worker of the pool.
+         */
+        ThreadPool::Worker* worker() const
+        {
+            ThreadPool::Worker* w = mact->mworker;
+            return w ? w : mact->mpool->mworkers.front();
+        }
+
+        ThreadPoolActivity* mact;
+    };
+
+    ThreadPool::ThreadPool(unsigned int workers, int scheduler, int priority, unsigned cpu_affinity, const std::string& name)
+    {
+        workers = std::max(workers, 1u);
+        for (unsigned int i = 0; i != workers; ++i) {
+            std::ostringstream worker_name;
+            worker_name << name << '.' << i;
+            mworkers.push_back( new Worker(this, i, scheduler, priority, cpu_affinity, worker_name.str()) );
+        }
+        for (Workers::iterator it = mworkers.begin(); it != mworkers.end(); ++it)
+            (*it)->start();
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        for (Workers::iterator it = mworkers.begin(); it != mworkers.end(); ++it)
+            delete *it;
+    }
+
+    unsigned int ThreadPool::getWorkerCount() const
+    {
+        return mworkers.size();
+    }
+
+    bool ThreadPool::setPriority(int priority)
+    {
+        bool result = true;
+        for (Workers::iterator it = mworkers.begin(); it != mworkers.end(); ++it)
+            result = (*it)->setPriority(priority) && result;
+        return result;
+    }
+
+    int ThreadPool::getPriority() const
+    {
+        return mworkers.front()->getPriority();
+    }
+
+    int ThreadPool::getScheduler() const
+    {
+        return mworkers.front()->getScheduler();
+    }
+
+    bool ThreadPool::setCpuAffinity(unsigned cpu_affinity)
+    {
+        bool result = true;
+        for (Workers::iterator it = mworkers.begin(); it != mworkers.end(); ++it)
+            result = (*it)->setCpuAffinity(cpu_affinity) && result;
+        return result;
+    }
+
+    unsigned ThreadPool::getCpuAffinity() const
+    {
+        return mworkers.front()->getCpuAffinity();
+    }
+
+    unsigned int ThreadPool::getExecuted()
+    {
+        return mexecuted.read();
+    }
+
+    unsigned int ThreadPool::getStolen()
+    {
+        return mstolen.read();
+    }
+
+    ThreadPool::Worker* ThreadPool::self() const
+    {
+        for (Workers::const_iterator it = mworkers.begin(); it != mworkers.end(); ++it)
+            if ( (*it)->isSelf() )
+                return *it;
+        return 0;
+    }
+
+    void ThreadPool::schedule(ThreadPoolActivity* act)
+    {
+        Worker* w = self();
+        if ( !w ) {
+            mnext.inc();
+            w = mworkers[ (unsigned int)(mnext.read()) % mworkers.size() ];
+        }
+        // count first, such that a worker never sleeps on a non empty queue.
+        mqueued.inc();
+        {
+            os::MutexLock lock(w->queue_lock);
+            w->queue.push_back(act);
+        }
+        if ( msleepers.read() ) {
+            os::MutexLock lock(msleep_lock);
+            msleep_cond.broadcast();
+        }
+    }
+
+    bool ThreadPool::cancel(ThreadPoolActivity* act)
+    {
+        for (Workers::iterator it = mworkers.begin(); it != mworkers.end(); ++it) {
+            os::MutexLock lock((*it)->queue_lock);
+            std::deque<ThreadPoolActivity*>::iterator found = std::find((*it)->queue.begin(), (*it)->queue.end(), act);
+            if ( found != (*it)->queue.end() ) {
+                (*it)->queue.erase(found);
+                act->mstate = ThreadPoolActivity::Idle;
+                mqueued.dec();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    ThreadPoolActivity* ThreadPool::next(Worker* w)
+    {
+        ThreadPoolActivity* act = 0;
+        {
+            // our own queue, in order.
+            os::MutexLock lock(w->queue_lock);
+            if ( !w->queue.empty() ) {
+                act = w->queue.front();
+                w->queue.pop_front();
+                act->mstate = ThreadPoolActivity::Running;
+                act->mworker = w;
+            }
+        }
+        // steal the oldest activity of the other workers.
+        for (unsigned int i = 1; act == 0 && i != mworkers.size(); ++i) {
+            Worker* victim = mworkers[ (w->index + i) % mworkers.size() ];
+            os::MutexLock lock(victim->queue_lock);
+            if ( !victim->queue.empty() ) {
+                act = victim->queue.front();
+                victim->queue.pop_front();
+                act->mstate = ThreadPoolActivity::Running;
+                act->mworker = w;
+                mstolen.inc();
+            }
+        }
+        if ( act )
+            mqueued.dec();
+        return act;
+    }
+
+    void ThreadPool::waitForWork(Worker* w)
+    {
+        os::MutexLock lock(msleep_lock);
+        msleepers.inc();
+        while ( mqueued.read() <= 0 && !w->mbreak )
+            msleep_cond.wait(msleep_lock);
+        msleepers.dec();
+    }
+
+    ThreadPoolActivity::ThreadPoolActivity( ThreadPool* pool, RunnableInterface* run /*= 0*/ )
+        : ActivityInterface(run), mpool(pool), mthread(new PoolThread(this)), mstate(Idle), mworker(0), active(false), stopping(false)
+    {
+    }
+
+    ThreadPoolActivity::~ThreadPoolActivity()
+    {
+        stop();
+        delete mthread;
+    }
+
+    ThreadPool* ThreadPoolActivity::getThreadPool() const
+    {
+        return mpool;
+    }
+
+    Seconds ThreadPoolActivity::getPeriod() const
+    {
+        return 0.0;
+    }
+
+    bool ThreadPoolActivity::setPeriod(Seconds s) {
+        if ( s == 0.0)
+            return true;
+        return false;
+    }
+
+    unsigned ThreadPoolActivity::getCpuAffinity() const
+    {
+        return mpool->getCpuAffinity();
+    }
+
+    bool ThreadPoolActivity::setCpuAffinity(unsigned cpu)
+    {
+        return false;
+    }
+
+    os::ThreadInterface* ThreadPoolActivity::thread()
+    {
+        return mthread;
+    }
+
+    bool ThreadPoolActivity::initialize()
+    {
+        return true;
+    }
+
+    void ThreadPoolActivity::step()
+    {
+    }
+
+    void ThreadPoolActivity::finalize()
+    {
+    }
+
+    bool ThreadPoolActivity::start()
+    {
+        if (active == true )
+            return false;
+
+        active = true;
+
+        if ( runner ? runner->initialize() : this->initialize() ) {
+        } else {
+            active = false;
+        }
+        return active;
+    }
+
+    bool ThreadPoolActivity::stop()
+    {
+        if ( !active )
+            return false;
+
+        stopping = true;
+        os::fence();
+        // when called from our own step(), the worker finishes it.
+        ThreadPool::Worker* w = mworker;
+        if ( !w || !w->isSelf() ) {
+            // wait until no worker holds or executes us anymore.
+            os::MutexLock lock(execution_lock);
+            while ( !mpool->cancel(this) && mstate != Idle )
+                mstopped.wait(execution_lock);
+        }
+
+        if (runner)
+            runner->finalize();
+        else
+            this->finalize();
+        active = false;
+        stopping = false;
+        return true;
+    }
+
+    bool ThreadPoolActivity::isRunning() const
+    {
+        return mstate == Running || mstate == Retriggered;
+    }
+
+    bool ThreadPoolActivity::isPeriodic() const
+    {
+        return false;
+    }
+
+    bool ThreadPoolActivity::isActive() const
+    {
+        return active;
+    }
+
+    bool ThreadPoolActivity::trigger()
+    {
+        while ( active && !stopping ) {
+            int state = mstate;
+            if ( state == Idle ) {
+                if ( os::CAS(&mstate, (int)Idle, (int)Queued) ) {
+                    mpool->schedule(this);
+                    // a stop() which did not find us in the queue yet waits for us.
+                    os::fence();
+                    if ( stopping ) {
+                        os::MutexLock lock(execution_lock);
+                        mstopped.broadcast();
+                    }
+                    return true;
+                }
+            } else if ( state == Running ) {
+                // step() will be executed once more afterwards.
+                if ( os::CAS(&mstate, (int)Running, (int)Retriggered) )
+                    return true;
+            } else
+                return true; // already pending
+        }
+        return false;
+    }
+
+    bool ThreadPoolActivity::execute()
+    {
+        return false;
+    }
+
+    void ThreadPoolActivity::work(ThreadPool::Worker* w)
+    {
+        // stop() waits on mstopped with this lock, releasing it is our last access.
+        os::MutexLock lock(execution_lock);
+        if ( active && !stopping ) {
+            if (runner) runner->step(); else this->step();
+        }
+        mpool->mexecuted.inc();
+
+        mworker = 0;
+        while ( true ) {
+            if ( !active || stopping ) {
+                mstate = Idle;
+                break;
+            }
+            if ( mstate == Retriggered || (runner && runner->hasWork()) ) {
+                // run again, but after the other activities queued at this worker.
+                mstate = Queued;
+                mpool->schedule(this);
+                return;
+            }
+            // fails if trigger() was called in the meantime.
+            if ( os::CAS(&mstate, (int)Running, (int)Idle) )
+                break;
+        }
+        mstopped.broadcast();
+    }
+}
@@ -0,0 +1,284 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  ThreadPoolActivity.hpp
+
+                        ThreadPoolActivity.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_THREAD_POOL_ACTIVITY_HPP
+#define ORO_THREAD_POOL_ACTIVITY_HPP
+
+#include "../base/ActivityInterface.hpp"
+#include "../base/RunnableInterface.hpp"
+#include "../os/Mutex.hpp"
+#include "../os/Condition.hpp"
+#include "../os/Atomic.hpp"
+#include "../os/threads.hpp"
+
+#include <deque>
+#include <vector>
+#include <string>
+
+namespace RTT
+{ namespace extras {
+
+    class ThreadPoolActivity;
+
+    /**
+     * @brief A fixed set of worker threads which execute the step() of
+     * triggered ThreadPoolActivity objects.
+     *
+     * Each worker has its own queue of triggered activities. A trigger from
+     * within a worker is queued at that worker, other triggers are spread
+     * over the workers. A worker executes its own queue in order and steals
+     * the oldest activity from the other workers when its own queue is
+     * empty, such that activities which keep on triggering themselves or
+     * each other can not keep the other activities of a worker waiting.
+     * Idle workers sleep until new work arrives.
+     *
+     * All workers share the scheduler, priority and cpu affinity of the pool.
+     *
+     * @note A step() which blocks, for example because it waits for the
+     * result of an operation executed by another activity of the same
+     * pool, occupies its worker. If all workers block this way, the
+     * pool deadlocks. Size the pool accordingly.
+     *
+     * @ingroup CoreLibActivities
+     */
+    class RTT_API ThreadPool
+    {
+    public:
+        /**
+         * Create and start a pool of worker threads.
+         * @param workers The number of worker threads, at least one.
+         * @param scheduler The scheduler of the workers, ORO_SCHED_OTHER or ORO_SCHED_RT.
+         * @param priority The priority of the workers.
+         * @param cpu_affinity The cpu affinity of the workers, ~0 for all cpus.
+         * @param name The name of the pool, the workers are named after it.
+         */
+        ThreadPool(unsigned int workers, int scheduler = ORO_SCHED_OTHER,
+                   int priority = os::LowestPriority, unsigned cpu_affinity = ~0,
+                   const std::string& name = "ThreadPool");
+
+        /**
+         * Stops all workers. All activities using this pool must
+         * be stopped or destroyed before.
+         */
+        ~ThreadPool();
+
+        unsigned int getWorkerCount() const;
+
+        /**
+         * Set the priority of all workers.
+         * @return false if one of the workers refused the priority.
+         */
+        bool setPriority(int priority);
+
+        int getPriority() const;
+
+        int getScheduler() const;
+
+        /**
+         * Set the cpu affinity of all workers.
+         * @return false if one of the workers refused the affinity.
+         */
+        bool setCpuAffinity(unsigned cpu_affinity);
+
+        unsigned getCpuAffinity() const;
+
+        /**
+         * Returns the number of steps executed by the workers.
+         */
+        unsigned int getExecuted();
+
+        /**
+         * Returns the number of activities a worker took from the
+         * queue of another worker.
+         */
+        unsigned int getStolen();
+
+    private:
+        friend class ThreadPoolActivity;
+        class Worker;
+        typedef std::vector<Worker*> Workers;
+
+        /**
+         * Queue \a act at the calling worker or, if the caller is not
+         * a worker of this pool, at the next worker in turn.
+         */
+        void schedule(ThreadPoolActivity* act);
+
+        /**
+         * Remove \a act from all queues.
+         * @return true if it was queued.
+         */
+        bool cancel(ThreadPoolActivity* act);
+
+        /**
+         * Take the next activity for \a w, from its own queue or
+         * from another worker's queue. The activity is marked as
+         * running while the queue is locked.
+         * @return null if no work is available.
+         */
+        ThreadPoolActivity* next(Worker* w);
+
+        /**
+         * Put \a w to sleep until work is queued or the pool stops.
+         */
+        void waitForWork(Worker* w);
+
+        /**
+         * Returns the worker of this pool which is the calling thread, if any.
+         */
+        Worker* self() const;
+
+        Workers mworkers;
+        os::AtomicInt mnext;
+        os::AtomicInt mqueued;
+        os::AtomicInt msleepers;
+        os::AtomicInt mexecuted;
+        os::AtomicInt mstolen;
+        os::Mutex msleep_lock;
+        os::Condition msleep_cond;
+
+        // non copyable
+        ThreadPool(const ThreadPool&);
+    };
+
+    /**
+     * @brief An activity which executes its step() in a worker of a
+     * ThreadPool when it is triggered.
+     *
+     * Use this activity to run many non periodic components on a few threads.
+     * Each trigger() queues the activity once in the pool. Triggers which arrive
+     * while it is queued are merged, and a trigger during step() makes it run
+     * again afterwards. The step() of one activity is never executed by two
+     * workers at the same time.
+     *
+     * \section ExecReact Reactions to execute():
+     * Always returns false.
+     *
+     * \section TrigReact Reactions to trigger():
+     * Schedules step() for execution in a worker of the pool.
+     *
+     * @ingroup CoreLibActivities
+     */
+    class RTT_API ThreadPoolActivity
+        :public base::ActivityInterface
+    {
+    public:
+        /**
+         * Create an activity which runs in \a pool.
+         * @param pool The pool which executes this activity. It must
+         * outlive this activity.
+         * @param run Run this instance.
+         */
+        ThreadPoolActivity( ThreadPool* pool, base::RunnableInterface* run = 0 );
+
+        /**
+         * Stops this activity and waits until it is no longer executed.
+         */
+        ~ThreadPoolActivity();
+
+        ThreadPool* getThreadPool() const;
+
+        Seconds getPeriod() const;
+
+        bool setPeriod(Seconds s);
+
+        /**
+         * Returns the cpu affinity of the pool.
+         */
+        unsigned getCpuAffinity() const;
+
+        /**
+         * The cpu affinity is a property of the pool.
+         * @return false.
+         */
+        bool setCpuAffinity(unsigned cpu);
+
+        /**
+         * Returns a thread which stands for the workers of the pool.
+         * Its isSelf() is only true in the worker which executes this
+         * activity, its scheduler and priority are those of the pool.
+         * It can not be started, stopped or changed. Will not be null.
+         */
+        os::ThreadInterface* thread();
+
+        bool initialize();
+        void step();
+        void finalize();
+
+        bool start();
+
+        bool stop();
+
+        bool isRunning() const;
+
+        bool isPeriodic() const;
+
+        bool isActive() const;
+
+        bool execute();
+
+        bool trigger();
+    private:
+        friend class ThreadPool;
+
+        enum { Idle, Queued, Running, Retriggered };
+
+        class PoolThread;
+
+        /**
+         * Called by a worker of the pool after next() returned us.
+         */
+        void work(ThreadPool::Worker* w);
+
+        ThreadPool* mpool;
+        PoolThread* mthread;
+        volatile int mstate;
+        ThreadPool::Worker* volatile mworker;
+        bool active;
+        volatile bool stopping;
+        os::Mutex execution_lock;
+        /**
+         * Signalled under the execution_lock when a worker set us Idle
+         * or when trigger() queued us during stop().
+         */
+        os::Condition mstopped;
+    };
+
+}}
+
+
+#endif
@@ -10,6 +10,8 @@ namespace RTT {
         class SimulationActivity;
         class SimulationThread;
         class SlaveActivity;
+        class ThreadPool;
+        class ThreadPoolActivity;
         class TimerThread;
         struct Provider;
         struct RT_INTR;
@@ -0,0 +1,269 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  AtomicMPSCQueue.hpp
+
+                        AtomicMPSCQueue.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_CORELIB_ATOMIC_MPSC_QUEUE_HPP
+#define ORO_CORELIB_ATOMIC_MPSC_QUEUE_HPP
+
+#include "../os/CAS.hpp"
+#include <climits>
+
+namespace RTT
+{
+    namespace internal
+    {
+        /**
+         * Create an atomic, non-blocking Multi-Producer Single-Consumer FIFO for storing
+         * a value \a T, with the same interface as AtomicMWSRQueue.
+         *
+         * Unlike AtomicMWSRQueue, which packs both indexes in one word, the
+         * write (tail) and read (head) positions live in separate cache lines
+         * and every slot carries its own sequence number, which tells if it
+         * is free for the writer of that position or filled for the reader.
+         * Writers only compete with each other on the tail and the reader
+         * never makes a writer's CAS fail, or the reverse. The positions are
+         * 32 bit counters, so the capacity is not limited to 65535.
+         *
+         * The reader claims its slot with a CAS too, such that the occasional
+         * dequeue() from a writer thread (as BufferLockFree does in circular
+         * mode) remains safe.
+         * @param T The type to be stored in the Queue.
+         * @ingroup CoreLibBuffers
+         */
+        template<class T>
+        class AtomicMPSCQueue
+        {
+            enum { CacheLineSize = 64 };
+
+            struct Cell
+            {
+                volatile unsigned int seq;
+                T value;
+            };
+
+            /**
+             * The number of slots, at least two: with a single slot, the
+             * sequence of a filled slot equals the one of a free slot of
+             * the next round.
+             */
+            const unsigned int _size;
+            /**
+             * The number of elements the queue accepts, at most _size.
+             */
+            const unsigned int _capacity;
+            /**
+             * The positions wrap at this largest multiple of _size,
+             * such that position % _size remains continuous.
+             */
+            const unsigned int _wrap;
+            Cell* _buf;
+
+            char _pad0[CacheLineSize];
+            /**
+             * The next position to write to.
+             */
+            volatile unsigned int _tail;
+            char _pad1[CacheLineSize - sizeof(unsigned int)];
+            /**
+             * The next position to read from.
+             */
+            volatile unsigned int _head;
+            char _pad2[CacheLineSize - sizeof(unsigned int)];
+
+            unsigned int next(unsigned int pos, unsigned int n = 1) const
+            {
+                return pos < _wrap - n ? pos + n : pos + n - _wrap;
+            }
+
+            unsigned int distance(unsigned int head, unsigned int tail) const
+            {
+                return tail >= head ? tail - head : tail + _wrap - head;
+            }
+
+            // non-copyable !
+            AtomicMPSCQueue(const AtomicMPSCQueue<T>&);
+        public:
+            typedef unsigned int size_type;
+
+            /**
+             * Create an AtomicMPSCQueue with queue size \a size.
+             * @param size The size of the queue, should be 1 or greater.
+             * A queue of size 1 uses two slots.
+             */
+            AtomicMPSCQueue(unsigned int size) :
+                _size(size < 2 ? 2 : size), _capacity(size),
+                _wrap( (UINT_MAX / _size) * _size ), _buf( new Cell[_size] )
+            {
+                this->clear();
+            }
+
+            ~AtomicMPSCQueue()
+            {
+                delete[] _buf;
+            }
+
+            /**
+             * Inspect if the Queue is full.
+             * @return true if full, false otherwise.
+             */
+            bool isFull() const
+            {
+                return size() >= _capacity;
+            }
+
+            /**
+             * Inspect if the Queue is empty.
+             * @return true if empty, false otherwise.
+             */
+            bool isEmpty() const
+            {
+                return _head == _tail;
+            }
+
+            /**
+             * Return the maximum number of items this queue can contain.
+             */
+            size_type capacity() const
+            {
+                return _capacity;
+            }
+
+            /**
+             * Return the number of elements in the queue.
+             */
+            size_type size() const
+            {
+                unsigned int head = _head;
+                unsigned int tail = _tail;
+                return distance(head, tail);
+            }
+
+            /**
+             * Enqueue an item.
+             * @param value The value to enqueue.
+             * @return false if queue is full, true if queued.
+             */
+            bool enqueue(const T& value)
+            {
+                unsigned int pos;
+                Cell* cell;
+                for(;;) {
+                    pos = _tail;
+                    cell = &_buf[pos % _size];
+                    if ( cell->seq == pos ) {
+                        // a queue of capacity 1 has a spare slot: only there,
+                        // the writer must look at the reader's position.
+                        if ( _capacity != _size && distance(_head, pos) >= _capacity ) {
+                            if ( pos == _tail )
+                                return false;
+                            continue;
+                        }
+                        // the slot is free for this position: claim it.
+                        if ( os::CAS(&_tail, pos, next(pos)) )
+                            break;
+                    } else if ( pos == _tail ) {
+                        // the slot still holds the element of the previous round.
+                        return false;
+                    }
+                }
+                cell->value = value;
+                // publish: the CAS orders the write of value before the sequence.
+                os::CAS(&cell->seq, pos, next(pos));
+                return true;
+            }
+
+            /**
+             * Dequeue an item.
+             * @param result Stores the dequeued value. It is unchanged when
+             * dequeue returns false and contains the dequeued value
+             * when it returns true.
+             * @return false if queue is empty, true if result was written.
+             */
+            bool dequeue(T& result)
+            {
+                unsigned int pos;
+                Cell* cell;
+                for(;;) {
+                    pos = _head;
+                    cell = &_buf[pos % _size];
+                    if ( cell->seq == next(pos) ) {
+                        if ( os::CAS(&_head, pos, next(pos)) )
+                            break;
+                    } else if ( pos == _head ) {
+                        // empty, or the writer of this position has not finished yet.
+                        return false;
+                    }
+                }
+                result = cell->value;
+                // hand the slot to the writer of the next round.
+                os::CAS(&cell->seq, next(pos), next(pos, _size));
+                return true;
+            }
+
+            /**
+             * Return the next to be read value, or a default constructed
+             * value if the queue is empty.
+             */
+            const T front() const
+            {
+                unsigned int pos = _head;
+                const Cell& cell = _buf[pos % _size];
+                if ( cell.seq == next(pos) )
+                    return cell.value;
+                return T();
+            }
+
+            /**
+             * Clear all contents of the Queue and thus make it empty.
+             * This function may not be called concurrently with
+             * enqueue() or dequeue().
+             */
+            void clear()
+            {
+                for (unsigned int i = 0; i != _size; ++i)
+                {
+                    _buf[i].seq = i;
+                    _buf[i].value = T();
+                }
+                _head = 0;
+                _tail = 0;
+            }
+
+        };
+
+    }
+}
+#endif
@@ -295,7 +295,7 @@ namespace RTT
                 if (msig) msig->emit();
 #endif
                 if (mmeth)
-                    retv.exec( mmeth );
+                    retv.exec( boost::bind( boost::ref(mmeth) ) );
                 else
                     retv.executed = true;
             }
@@ -330,7 +330,7 @@ namespace RTT
                 if (msig) (*msig)(a1.get());
 #endif
                 if (mmeth)
-                    retv.exec( boost::bind(mmeth, boost::ref(a1.get()) ) );
+                    retv.exec( boost::bind(boost::ref(mmeth), boost::ref(a1.get()) ) );
                 else
                     retv.executed = true;
             }
@@ -366,7 +366,7 @@ namespace RTT
                 if (msig) (*msig)(a1.get(), a2.get());
 #endif
                 if (mmeth)
-                    retv.exec( boost::bind(mmeth, boost::ref(a1.get()), boost::ref(a2.get()) ) );
+                    retv.exec( boost::bind(boost::ref(mmeth), boost::ref(a1.get()), boost::ref(a2.get()) ) );
                 else
                     retv.executed = true;
             }
@@ -404,7 +404,7 @@ namespace RTT
                 if (msig) (*msig)(a1.get(), a2.get(), a3.get());
 #endif
                 if (mmeth)
-                    retv.exec( boost::bind(mmeth, boost::ref(a1.get()), boost::ref(a2.get()), boost::ref(a3.get()) ) );
+                    retv.exec( boost::bind(boost::ref(mmeth), boost::ref(a1.get()), boost::ref(a2.get()), boost::ref(a3.get()) ) );
                 else
                     retv.executed = true;
             }
@@ -443,7 +443,7 @@ namespace RTT
                 if (msig) (*msig)(a1.get(), a2.get(), a3.get(), a4.get());
 #endif
                 if (mmeth)
-                    retv.exec( boost::bind( mmeth, boost::ref(a1.get()), boost::ref(a2.get()), boost::ref(a3.get()), boost::ref(a4.get()) ) );
+                    retv.exec( boost::bind( boost::ref(mmeth), boost::ref(a1.get()), boost::ref(a2.get()), boost::ref(a3.get()), boost::ref(a4.get()) ) );
                 else
                     retv.executed = true;
             }
@@ -484,7 +484,7 @@ namespace RTT
                 if (msig) (*msig)(a1.get(), a2.get(), a3.get(), a4.get(), a5.get());
 #endif
                 if (mmeth)
-                    retv.exec( boost::bind( mmeth, boost::ref(a1.get()), boost::ref(a2.get()), boost::ref(a3.get()), boost::ref(a4.get()), boost::ref(a5.get()) ) );
+                    retv.exec( boost::bind( boost::ref(mmeth), boost::ref(a1.get()), boost::ref(a2.get()), boost::ref(a3.get()), boost::ref(a4.get()), boost::ref(a5.get()) ) );
                 else
                     retv.executed = true;
             }
@@ -527,7 +527,7 @@ namespace RTT
                 if (msig) (*msig)(a1.get(), a2.get(), a3.get(), a4.get(), a5.get(), a6.get());
 #endif
                 if (mmeth)
-                    retv.exec( boost::bind( mmeth, boost::ref(a1.get()), boost::ref(a2.get()), boost::ref(a3.get()), boost::ref(a4.get()), boost::ref(a5.get()), boost::ref(a6.get()) ) );
+                    retv.exec( boost::bind( boost::ref(mmeth), boost::ref(a1.get()), boost::ref(a2.get()), boost::ref(a3.get()), boost::ref(a4.get()), boost::ref(a5.get()), boost::ref(a6.get()) ) );
                 else
                     retv.executed = true;
             }
@@ -572,7 +572,7 @@ namespace RTT
                 if (msig) (*msig)(a1.get(), a2.get(), a3.get(), a4.get(), a5.get(), a6.get(), a7.get());
 #endif
                 if (mmeth)
-                    retv.exec( boost::bind( mmeth, boost::ref(a1.get()), boost::ref(a2.get()), boost::ref(a3.get()), boost::ref(a4.get()), boost::ref(a5.get()), boost::ref(a6.get()), boost::ref(a7.get()) ) );
+                    retv.exec( boost::bind( boost::ref(mmeth), boost::ref(a1.get()), boost::ref(a2.get()), boost::ref(a3.get()), boost::ref(a4.get()), boost::ref(a5.get()), boost::ref(a6.get()), boost::ref(a7.get()) ) );
                 else
                     retv.executed = true;
             }
@@ -0,0 +1,269 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  ChannelBroadcastElement.hpp
+
+                        ChannelBroadcastElement.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_CHANNEL_BROADCAST_ELEMENT_HPP
+#define ORO_CHANNEL_BROADCAST_ELEMENT_HPP
+
+#include "../base/ChannelElement.hpp"
+#include "../base/BroadcastBuffer.hpp"
+#include "../os/Atomic.hpp"
+
+namespace RTT { namespace internal {
+
+    /** A connection element which reads from a buffer that is shared by all
+     * broadcast connections of an output port. Each sample is only stored
+     * once, and each element of the group keeps its own read position.
+     *
+     * The first element of the group stores the written samples in
+     * the buffer, the others only notify their reader.
+     */
+    template<typename T>
+    class ChannelBroadcastElement : public base::ChannelElement<T>
+    {
+    public:
+        typedef typename base::ChannelElement<T>::param_t param_t;
+        typedef typename base::ChannelElement<T>::reference_t reference_t;
+        typedef typename base::ChannelElement<T>::value_t value_t;
+        typedef typename base::BroadcastBuffer<T>::cursor_t cursor_t;
+
+    private:
+        typename base::BroadcastBuffer<T>::shared_ptr buffer;
+        cursor_t cursor;
+        value_t *last_sample_p;
+        bool mjoined;
+        // statistics, see getStatistics().
+        os::AtomicInt mwrites, mreads, mdrops, moverwrites;
+        int mhigh_water;
+
+    public:
+        /**
+         * Creates a reader of \a buffer.
+         * @param buffer The buffer of the group this element joins.
+         * @param with_last If true, this element starts reading
+         * at the last written sample, if any.
+         */
+        ChannelBroadcastElement(typename base::BroadcastBuffer<T>::shared_ptr buffer, bool with_last)
+            : buffer(buffer), cursor( buffer->begin(with_last) ), last_sample_p(0),
+              mjoined( buffer->addReader(this) ), mhigh_water(0)
+        {
+        }
+
+        virtual ~ChannelBroadcastElement()
+        {
+            if(last_sample_p)
+                buffer->Release(last_sample_p);
+            buffer->removeReader(this);
+        }
+
+        /**
+         * Returns false if the group of this element already had
+         * the maximum number of readers.
+         */
+        bool joined() const
+        {
+            return mjoined;
+        }
+
+        /** Returns the buffer that is shared by the group of this element.
+         */
+        typename base::BroadcastBuffer<T>::shared_ptr getBuffer() const
+        {
+            return buffer;
+        }
+
+        /** Appends a sample to the shared buffer, if this element is the
+         * writer of its group, and notifies the reader.
+         *
+         * @return false if the reader could not be notified.
+         */
+        virtual bool write(param_t sample)
+        {
+            mwrites.inc();
+            if ( buffer->isWriter(this) && !buffer->Push(sample) )
+                mdrops.inc();
+            return this->signal();
+        }
+
+        /** Returns the oldest sample this element has not read yet.
+         *
+         * @return NewData if a sample was read, OldData if the last read sample
+         * is returned and NoData if nothing was read yet.
+         */
+        virtual FlowStatus read(reference_t sample, bool copy_old_data)
+        {
+            value_t *new_sample_p;
+            cursor_t before = cursor;
+            if ( (new_sample_p = buffer->Pop(cursor)) ) {
+                if(last_sample_p)
+                    buffer->Release(last_sample_p);
+                updateStatistics(before);
+
+                last_sample_p = new_sample_p;
+                sample = *new_sample_p;
+                return NewData;
+            }
+            if (last_sample_p) {
+                if(copy_old_data)
+                    sample = *(last_sample_p);
+                return OldData;
+            }
+            return NoData;
+        }
+
+        virtual FlowStatus readRef(base::SampleRef<T>& sample, bool copy_old_data)
+        {
+            value_t *new_sample_p;
+            cursor_t before = cursor;
+            if ( (new_sample_p = buffer->Pop(cursor)) ) {
+                if(last_sample_p)
+                    buffer->Release(last_sample_p);
+                updateStatistics(before);
+
+                last_sample_p = new_sample_p;
+                share(sample, new_sample_p);
+                return NewData;
+            }
+            if (last_sample_p) {
+                if(copy_old_data)
+                    share(sample, last_sample_p);
+                return OldData;
+            }
+            return NoData;
+        }
+
+        /** Reserves a free element of the shared buffer. Only the writer
+         * of the group can loan elements.
+         */
+        virtual value_t* loan()
+        {
+            if ( buffer->isWriter(this) )
+                return buffer->Loan();
+            return 0;
+        }
+
+        /** Appends an element obtained with loan() to the shared buffer.
+         */
+        virtual bool commit(value_t* sample)
+        {
+            mwrites.inc();
+            buffer->PushLoaned(sample);
+            return this->signal();
+        }
+
+        virtual void release(value_t* sample)
+        {
+            buffer->Release(sample);
+        }
+
+        /** Skips all unread samples of this element. The other elements
+         * of the group are not affected.
+         */
+        virtual void clear()
+        {
+            if(last_sample_p)
+                buffer->Release(last_sample_p);
+            last_sample_p = 0;
+            cursor = buffer->begin(false);
+            base::ChannelElement<T>::clear();
+        }
+
+        /** Leaves the group. If this element was the writer of its group,
+         * another element takes over.
+         */
+        virtual void disconnect(bool forward)
+        {
+            buffer->removeReader(this);
+            base::ChannelElement<T>::disconnect(forward);
+        }
+
+        virtual bool data_sample(param_t sample)
+        {
+            if ( buffer->isWriter(this) )
+                buffer->data_sample(sample);
+            return base::ChannelElement<T>::data_sample(sample);
+        }
+
+        virtual T data_sample()
+        {
+            return buffer->data_sample();
+        }
+
+        /** The drops are only counted by the writer of the group, and
+         * the overwrites are the samples this element skipped.
+         */
+        virtual bool getStatistics(base::ChannelStatistics& stats)
+        {
+            stats.writes = mwrites.read();
+            stats.reads = mreads.read();
+            stats.drops = mdrops.read();
+            stats.overwrites = moverwrites.read();
+            stats.size = buffer->size(cursor);
+            stats.high_water = mhigh_water;
+            stats.capacity = buffer->capacity();
+            return true;
+        }
+
+    private:
+        /** Counts the read at \a before, which Pop() advanced to cursor.
+         */
+        void updateStatistics(cursor_t before)
+        {
+            mreads.inc();
+            // Pop() skips the samples that were overwritten.
+            if ( cursor - before > 1 )
+                moverwrites.add( cursor - before - 1 );
+            int level = buffer->size(before);
+            if ( level > mhigh_water )
+                mhigh_water = level;
+        }
+
+        /** Lets \a sample refer to \a item, which is kept in the buffer
+         * until \a sample releases it.
+         */
+        void share(base::SampleRef<T>& sample, value_t* item)
+        {
+            if ( buffer->Ref(item) )
+                sample.assign(this, item);
+            else {
+                sample.storage() = *item;
+                sample.useStorage();
+            }
+        }
+    };
+}}
+
+#endif
@@ -41,6 +41,7 @@
 
 #include "../base/ChannelElement.hpp"
 #include "../base/BufferInterface.hpp"
+#include "../os/Atomic.hpp"
 
 namespace RTT { namespace internal {
 
@@ -51,6 +52,9 @@ namespace RTT { namespace internal {
     {
         typename base::BufferInterface<T>::shared_ptr buffer;
         typename base::ChannelElement<T>::value_t *last_sample_p;
+        // statistics, see getStatistics().
+        os::AtomicInt mwrites, mreads, mdrops;
+
     public:
         typedef typename base::ChannelElement<T>::param_t param_t;
         typedef typename base::ChannelElement<T>::reference_t reference_t;
@@ -71,8 +75,22 @@ namespace RTT { namespace internal {
          */
         virtual bool write(param_t sample)
         {
+            mwrites.inc();
             if (buffer->Push(sample))
                 return this->signal();
+            mdrops.inc();
+            return true;
+        }
+
+        /** Appends a sample at the end of the FIFO, without signalling the reader.
+         *
+         * @return true
+         */
+        virtual bool writeWithoutSignal(param_t sample)
+        {
+            mwrites.inc();
+            if ( !buffer->Push(sample) )
+                mdrops.inc();
             return true;
         }
 
@@ -89,6 +107,7 @@ namespace RTT { namespace internal {
 		
 		last_sample_p = new_sample_p;
 		sample = *new_sample_p;
+                mreads.inc();
                 return NewData;
             }
             if (last_sample_p) {
@@ -99,6 +118,56 @@ namespace RTT { namespace internal {
             return NoData;
         }
 
+        /** Reads the first element of the FIFO without copying it, if the
+         * buffer can share its storage with \a sample.
+         *
+         * @return the same as read()
+         */
+        virtual FlowStatus readRef(base::SampleRef<T>& sample, bool copy_old_data)
+        {
+	    value_t *new_sample_p;
+            if ( (new_sample_p = buffer->PopWithoutRelease()) ) {
+		if(last_sample_p)
+		    buffer->Release(last_sample_p);
+
+		last_sample_p = new_sample_p;
+		share(sample, new_sample_p);
+                mreads.inc();
+                return NewData;
+            }
+            if (last_sample_p) {
+		if(copy_old_data)
+		    share(sample, last_sample_p);
+                return OldData;
+            }
+            return NoData;
+        }
+
+        /** Reserves a free element of the FIFO, to be passed to commit().
+         *
+         * @return null if the buffer is full or can not loan its elements.
+         */
+        virtual value_t* loan()
+        {
+            return buffer->Loan();
+        }
+
+        /** Appends an element obtained with loan() at the end of the FIFO
+         */
+        virtual bool commit(value_t* sample)
+        {
+            mwrites.inc();
+            if (buffer->PushLoaned(sample))
+                return this->signal();
+            mdrops.inc();
+            return true;
+        }
+
+        virtual void release(value_t* sample)
+        {
+            buffer->Release(sample);
+        }
+
         /** Removes all elements in the FIFO. After a call to clear(), read()
          * will always return false (provided write() has not been called in the
          * meantime).
@@ -122,6 +191,32 @@ namespace RTT { namespace internal {
         {
             return buffer->data_sample();
         }
+
+        virtual bool getStatistics(base::ChannelStatistics& stats)
+        {
+            stats.writes = mwrites.read();
+            stats.reads = mreads.read();
+            stats.drops = mdrops.read();
+            stats.overwrites = buffer->overwritten();
+            stats.size = buffer->size();
+            stats.high_water = buffer->highWaterMark();
+            stats.capacity = buffer->capacity();
+            return true;
+        }
+
+    private:
+        /** Lets \a sample refer to \a item, which is kept in the buffer
+         * until \a sample releases it, or copies it if the buffer can not share it.
+         */
+        void share(base::SampleRef<T>& sample, value_t* item)
+        {
+            if ( buffer->Ref(item) )
+                sample.assign(this, item);
+            else {
+                sample.storage() = *item;
+                sample.useStorage();
+            }
+        }
     };
 }}
 
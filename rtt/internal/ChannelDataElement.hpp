@@ -41,6 +41,7 @@
 
 #include "../base/ChannelElement.hpp"
 #include "../base/DataObjectInterface.hpp"
+#include "../os/Atomic.hpp"
 
 namespace RTT { namespace internal {
 
@@ -51,6 +52,8 @@ namespace RTT { namespace internal {
     {
         bool written, mread;
         typename base::DataObjectInterface<T>::shared_ptr data;
+        // statistics, see getStatistics().
+        os::AtomicInt mwrites, mreads, moverwrites;
 
     public:
         typedef typename base::ChannelElement<T>::param_t param_t;
@@ -63,12 +66,29 @@ namespace RTT { namespace internal {
          * It always returns true. */
         virtual bool write(param_t sample)
         {
+            mwrites.inc();
+            if (written && !mread)
+                moverwrites.inc();
             data->Set(sample);
             written = true;
             mread = false;
             return this->signal();
         }
 
+        /** Update the data sample stored in this element,
+         * without signalling the reader.
+         * It always returns true. */
+        virtual bool writeWithoutSignal(param_t sample)
+        {
+            mwrites.inc();
+            if (written && !mread)
+                moverwrites.inc();
+            data->Set(sample);
+            written = true;
+            mread = false;
+            return true;
+        }
+
         /** Reads the last sample given to write()
          *
          * @return false if no sample has ever been written, true otherwise
@@ -80,6 +100,7 @@ namespace RTT { namespace internal {
                 if ( !mread ) {
 		    data->Get(sample);
                     mread = true;
+                    mreads.inc();
                     return NewData;
                 }
 
@@ -112,6 +133,18 @@ namespace RTT { namespace internal {
             return data->Get();
         }
 
+        virtual bool getStatistics(base::ChannelStatistics& stats)
+        {
+            stats.writes = mwrites.read();
+            stats.reads = mreads.read();
+            stats.drops = 0;
+            stats.overwrites = moverwrites.read();
+            stats.size = (written && !mread) ? 1 : 0;
+            stats.high_water = written ? 1 : 0;
+            stats.capacity = 1;
+            return true;
+        }
+
     };
 }}
 
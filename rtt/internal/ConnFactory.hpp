@@ -40,6 +40,7 @@
 #define ORO_CONN_FACTORY_HPP
 
 #include <string>
+#include <boost/type_traits/has_trivial_assign.hpp>
 #include "Channels.hpp"
 #include "ConnInputEndPoint.hpp"
 #include "ConnOutputEndPoint.hpp"
@@ -50,6 +51,7 @@
 
 #include "../base/DataObject.hpp"
 #include "../base/DataObjectUnSync.hpp"
+#include "../base/DataObjectSeqLock.hpp"
 #include "../base/Buffer.hpp"
 #include "../base/BufferUnSync.hpp"
 #include "../Logger.hpp"
@@ -144,10 +146,21 @@ namespace RTT
                 switch (policy.lock_policy)
                 {
 #ifndef OROBLD_OS_NO_ASM
+                case ConnPolicy::SEQLOCK:
+                    // readers may copy a slot while it is written, which only
+                    // works for types without pointers to owned memory.
+                    if ( boost::has_trivial_assign<T>::value ) {
+                        data_object.reset( new base::DataObjectSeqLock<T>(initial_value, policy.size > 1 ? policy.size : 3) );
+                    } else {
+                        RTT::log(Info) << "SEQLOCK connection policy is unavailable for this data type, using LOCK_FREE" << RTT::endlog();
+                        data_object.reset( new base::DataObjectLockFree<T>(initial_value) );
+                    }
+                    break;
                 case ConnPolicy::LOCK_FREE:
                     data_object.reset( new base::DataObjectLockFree<T>(initial_value) );
                     break;
 #else
+		case ConnPolicy::SEQLOCK:
 		case ConnPolicy::LOCK_FREE:
 		    RTT::log(Warning) << "lock free connection policy is unavailable on this system, defaulting to LOCKED" << RTT::endlog();
 #endif
@@ -162,24 +175,27 @@ namespace RTT
                 ChannelDataElement<T>* result = new ChannelDataElement<T>(data_object);
                 return result;
             }
-            else if (policy.type == ConnPolicy::BUFFER || policy.type == ConnPolicy::CIRCULAR_BUFFER)
+            else if (policy.type == ConnPolicy::BUFFER || policy.type == ConnPolicy::CIRCULAR_BUFFER || policy.type == ConnPolicy::BROADCAST)
             {
+                // A broadcast group can only be formed between local ports (see buildBroadcastChannelOutput),
+                // everywhere else it behaves like a circular buffer.
+                bool circular = policy.type != ConnPolicy::BUFFER;
                 base::BufferInterface<T>* buffer_object = 0;
                 switch (policy.lock_policy)
                 {
 #ifndef OROBLD_OS_NO_ASM
                 case ConnPolicy::LOCK_FREE:
-                    buffer_object = new base::BufferLockFree<T>(policy.size, initial_value, policy.type == ConnPolicy::CIRCULAR_BUFFER);
+                    buffer_object = new base::BufferLockFree<T>(policy.size, initial_value, circular);
                     break;
 #else
 		case ConnPolicy::LOCK_FREE:
 		    RTT::log(Warning) << "lock free connection policy is unavailable on this system, defaulting to LOCKED" << RTT::endlog();
 #endif
                 case ConnPolicy::LOCKED:
-                    buffer_object = new base::BufferLocked<T>(policy.size, initial_value, policy.type == ConnPolicy::CIRCULAR_BUFFER);
+                    buffer_object = new base::BufferLocked<T>(policy.size, initial_value, circular);
                     break;
                 case ConnPolicy::UNSYNC:
-                    buffer_object = new base::BufferUnSync<T>(policy.size, initial_value, policy.type == ConnPolicy::CIRCULAR_BUFFER);
+                    buffer_object = new base::BufferUnSync<T>(policy.size, initial_value, circular);
                     break;
                 }
                 return new ChannelBufferElement<T>(typename base::BufferInterface<T>::shared_ptr(buffer_object));
@@ -261,6 +277,47 @@ namespace RTT
             return data_object;
         }
 
+        /**
+         * Variant of buildBufferedChannelOutput for local broadcast connections.
+         * All broadcast connections of \a output_port share one buffer, the new
+         * connection joins the buffer of an existing broadcast connection if
+         * there is one.
+         * @param output_port The output port to which the connection will be added.
+         * @param port The input port to which the connection is added.
+         * @param conn_id A unique connection id which identifies this connection
+         * @param policy The policy of the connection. The size is only used
+         * when no broadcast connection exists yet.
+         * @return null if the group of \a output_port has no room for another reader.
+         */
+        template<typename T>
+        static base::ChannelElementBase::shared_ptr buildBroadcastChannelOutput(OutputPort<T>& output_port, InputPort<T>& port, ConnID* conn_id, ConnPolicy const& policy)
+        {
+            assert(conn_id);
+            typename base::BroadcastBuffer<T>::shared_ptr buffer;
+            std::list<ConnectionManager::ChannelDescriptor> channels = output_port.getManager()->getChannels();
+            for (std::list<ConnectionManager::ChannelDescriptor>::iterator it = channels.begin(); it != channels.end() && !buffer; ++it)
+            {
+                if ( it->get<2>().type != ConnPolicy::BROADCAST || it->get<2>().transport != 0 )
+                    continue;
+                ChannelBroadcastElement<T>* member = dynamic_cast<ChannelBroadcastElement<T>*>( it->get<1>()->getOutput().get() );
+                if (member)
+                    buffer = member->getBuffer();
+            }
+            if (!buffer)
+                buffer.reset( new base::BroadcastBuffer<T>(policy.size, output_port.getLastWrittenValue()) );
+
+            bool with_last = policy.init && output_port.keepsLastWrittenValue();
+            ChannelBroadcastElement<T>* data_object = new ChannelBroadcastElement<T>(buffer, with_last);
+            base::ChannelElementBase::shared_ptr result = data_object;
+            if ( !data_object->joined() ) {
+                log(Error) << "Too many broadcast connections on port " << output_port.getName() << endlog();
+                return 0;
+            }
+            base::ChannelElementBase::shared_ptr endpoint = new ConnOutputEndpoint<T>(&port, conn_id);
+            result->setOutput(endpoint);
+            return result;
+        }
+
         /**
          * Creates a connection from a local output_port to a local or remote input_port.
          * This function contains all logic to decide on how connections must be created to
@@ -291,7 +348,10 @@ namespace RTT
                     return false;
                 }
                 // local ports, create buffer here.
-                output_half = buildBufferedChannelOutput<T>(*input_p, output_port.getPortID(), policy, output_port.getLastWrittenValue());
+                if (policy.type == ConnPolicy::BROADCAST)
+                    output_half = buildBroadcastChannelOutput<T>(output_port, *input_p, output_port.getPortID(), policy);
+                else
+                    output_half = buildBufferedChannelOutput<T>(*input_p, output_port.getPortID(), policy, output_port.getLastWrittenValue());
             }
             else
             {
@@ -112,6 +112,17 @@ namespace RTT
             }
         }
 
+        /** Forwards to the data storage element of this connection, such that
+         * it can share its storage with \a sample.
+         */
+        virtual FlowStatus readRef(base::SampleRef<T>& sample, bool copy_old_data)
+        {
+            typename base::ChannelElement<T>::shared_ptr input = this->getInput();
+            if (input)
+                return input->readRef(sample, copy_old_data);
+            return NoData;
+        }
+
         virtual bool signal()
         {
             InputPort<T>* port = this->port;
@@ -49,6 +49,8 @@
 #include "../base/PortInterface.hpp"
 #include "../os/MutexLock.hpp"
 #include "../base/InputPortInterface.hpp"
+#include "../DataFlowInterface.hpp"
+#include "../TaskContext.hpp"
 #include <cassert>
 
 namespace RTT
@@ -76,6 +78,41 @@ namespace RTT
             descriptor.get<1>()->clear();
         }
 
+        /**
+         * Helper function to find the statistics of a connection of \a port.
+         * The element that stores the data and the peer port may be at either
+         * side of the element in \a descriptor.
+         */
+        void channelStatistics(PortInterface* port, ConnectionManager::ChannelDescriptor const& descriptor, ChannelStatistics& stats) {
+            bool found = false;
+            PortInterface* peer = 0;
+            ChannelElementBase::shared_ptr element = descriptor.get<1>();
+            for (ChannelElementBase::shared_ptr it = element; it; it = it->getOutput()) {
+                found = found || it->getStatistics(stats);
+                if ( it->getPort() && it->getPort() != port )
+                    peer = it->getPort();
+            }
+            for (ChannelElementBase::shared_ptr it = element->getInput(); it; it = it->getInput()) {
+                found = found || it->getStatistics(stats);
+                if ( it->getPort() && it->getPort() != port )
+                    peer = it->getPort();
+            }
+            if ( peer && peer->getInterface() && peer->getInterface()->getOwner() )
+                stats.peer = peer->getInterface()->getOwner()->getName() + "." + peer->getName();
+            else if ( peer )
+                stats.peer = peer->getName();
+            else
+                stats.peer = descriptor.get<2>().name_id;
+        }
+
+        void ConnectionManager::getStatistics(std::vector<ChannelStatistics>& stats) const
+        { RTT::os::MutexLock lock(connection_lock);
+            for (std::list<ChannelDescriptor>::const_iterator it = connections.begin(); it != connections.end(); ++it) {
+                stats.push_back( ChannelStatistics() );
+                channelStatistics(mport, *it, stats.back());
+            }
+        }
+
         void ConnectionManager::clear()
         { RTT::os::MutexLock lock(connection_lock);
             std::for_each(connections.begin(), connections.end(), &clearChannel);
@@ -61,6 +61,7 @@
 #include <rtt/os/Mutex.hpp>
 #include <rtt/os/MutexLock.hpp>
 #include <list>
+#include <vector>
 
 
 namespace RTT
@@ -186,6 +187,17 @@ namespace RTT
                 return cur_channel.get<1>().get();
             }
 
+            /**
+             * Returns a reference to the current channel, taken under the
+             * connection lock, such that it stays valid when the channel
+             * is removed concurrently.
+             * @see getCurrentChannel
+             */
+            base::ChannelElementBase::shared_ptr lockCurrentChannel() const {
+                RTT::os::MutexLock lock(connection_lock);
+                return cur_channel.get<1>();
+            }
+
             /**
              * Returns a list of all channels managed by this object.
              */
@@ -193,6 +205,14 @@ namespace RTT
                 return connections;
             }
 
+            /**
+             * Appends the statistics of each connection to \a stats.
+             * The statistics are counted by the channel element which
+             * stores the data of a connection. Connections without such
+             * an element in this process only report their peer.
+             */
+            void getStatistics(std::vector<base::ChannelStatistics>& stats) const;
+
             /**
              * Clears (removes) all data in the manager's connections.
              * After this call, all channels will return NoData, until new
@@ -243,7 +263,7 @@ namespace RTT
              * Lock that should be taken before the list of connections is
              * accessed or modified
              */
-            RTT::os::Mutex connection_lock;
+            mutable RTT::os::Mutex connection_lock;
         };
 
     }
@@ -708,6 +708,22 @@ namespace RTT
       {
       }
 
+    /**
+     * Returns the DataSource of the first argument.
+     */
+    typename DataSource<first_arg_t>::shared_ptr getFirst() const
+      {
+        return mdsa;
+      }
+
+    /**
+     * Returns the DataSource of the second argument.
+     */
+    typename DataSource<second_arg_t>::shared_ptr getSecond() const
+      {
+        return mdsb;
+      }
+
     virtual value_t get() const
       {
         first_arg_t a = mdsa->get();
@@ -767,6 +783,14 @@ namespace RTT
       {
       }
 
+    /**
+     * Returns the DataSource of the argument.
+     */
+    typename DataSource<arg_t>::shared_ptr getArgument() const
+      {
+        return mdsa;
+      }
+
     virtual value_t get() const
       {
         return mdata = fun( mdsa->get() );
@@ -0,0 +1,223 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  ExecutionEngineService.cpp
+
+                        ExecutionEngineService.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "ExecutionEngineService.hpp"
+#include "../ExecutionEngine.hpp"
+#include "../TaskContext.hpp"
+#include "../base/ActivityInterface.hpp"
+#include "../os/ThreadInterface.hpp"
+#include <sstream>
+
+namespace RTT
+{
+    namespace internal
+    {
+        ExecutionEngineService::ExecutionEngineService(TaskContext* owner)
+            : Service( "engine", owner )
+        {
+            doc("Tunes and monitors the message processing of the ExecutionEngine of this component and its data flow.");
+            addOperation("setMessageBudget", &ExecutionEngineService::setMessageBudget, this)
+                    .doc("Limits the number of messages processed in one step. The others are processed in the next step.")
+                    .arg("max_messages", "The maximum number of messages per step, zero for no limit.");
+            addOperation("getMessageBudget", &ExecutionEngineService::getMessageBudget, this)
+                    .doc("Returns the maximum number of messages processed in one step, zero for no limit.");
+            addOperation("setMessageTimeBudget", &ExecutionEngineService::setMessageTimeBudget, this)
+                    .doc("Limits the time spent in processing messages in one step. The others are processed in the next step.")
+                    .arg("max_time", "The maximum time in seconds, zero for no limit.");
+            addOperation("getMessageTimeBudget", &ExecutionEngineService::getMessageTimeBudget, this)
+                    .doc("Returns the maximum time in seconds spent in processing messages in one step, zero for no limit.");
+            addOperation("getMessageQueueDepth", &ExecutionEngineService::getMessageQueueDepth, this)
+                    .doc("Returns the number of messages waiting to be processed.");
+            addOperation("getMaxMessageQueueDepth", &ExecutionEngineService::getMaxMessageQueueDepth, this)
+                    .doc("Returns the largest number of messages that were waiting at the start of a step.");
+            addOperation("getMessagesProcessed", &ExecutionEngineService::getMessagesProcessed, this)
+                    .doc("Returns the number of messages processed since the statistics were reset.");
+            addOperation("getLastMessagesProcessed", &ExecutionEngineService::getLastMessagesProcessed, this)
+                    .doc("Returns the number of messages processed in the last step that processed messages.");
+            addOperation("getLastMessageProcessingTime", &ExecutionEngineService::getLastMessageProcessingTime, this)
+                    .doc("Returns the time in seconds spent in the last step that processed messages.");
+            addOperation("getMaxMessageProcessingTime", &ExecutionEngineService::getMaxMessageProcessingTime, this)
+                    .doc("Returns the longest time in seconds spent in processing messages in one step.");
+            addOperation("resetMessageStatistics", &ExecutionEngineService::resetMessageStatistics, this)
+                    .doc("Resets the message statistics.");
+            addOperation("setThreadStatisticsEnabled", &ExecutionEngineService::setThreadStatisticsEnabled, this)
+                    .doc("Enables or disables the collection of wake up latency and step time statistics in the thread of this component. Returns false if this component is not run by a thread which collects statistics.")
+                    .arg("enable", "True to collect statistics.");
+            addOperation("isThreadStatisticsEnabled", &ExecutionEngineService::isThreadStatisticsEnabled, this)
+                    .doc("Returns true if the thread of this component collects statistics.");
+            addOperation("getMaxWakeupLatency", &ExecutionEngineService::getMaxWakeupLatency, this)
+                    .doc("Returns the largest delay in seconds between the programmed and the actual start of a period.");
+            addOperation("getMeanWakeupLatency", &ExecutionEngineService::getMeanWakeupLatency, this)
+                    .doc("Returns the mean delay in seconds between the programmed and the actual start of a period.");
+            addOperation("getMaxStepTime", &ExecutionEngineService::getMaxStepTime, this)
+                    .doc("Returns the longest time in seconds spent in one period.");
+            addOperation("getMeanStepTime", &ExecutionEngineService::getMeanStepTime, this)
+                    .doc("Returns the mean time in seconds spent in one period.");
+            addOperation("getThreadOverruns", &ExecutionEngineService::getThreadOverruns, this)
+                    .doc("Returns the number of periods in which the thread woke up too late.");
+            addOperation("resetThreadStatistics", &ExecutionEngineService::resetThreadStatistics, this)
+                    .doc("Resets the thread statistics.");
+            addOperation("dumpThreadStatistics", &ExecutionEngineService::dumpThreadStatistics, this)
+                    .doc("Describes the thread statistics, including the histograms of the wake up latency and the step time.");
+            addOperation("dumpConnectionStatistics", &DataFlowInterface::dumpConnectionStatistics, owner->ports())
+                    .doc("Describes the data flow statistics (writes, reads, drops, overwrites, fill level) of each connection of each port.");
+        }
+
+        ExecutionEngineService::~ExecutionEngineService()
+        {
+        }
+
+        ExecutionEngine* ExecutionEngineService::engine() const
+        {
+            // the engine of our owner may be replaced, so don't cache it.
+            return getOwnerExecutionEngine();
+        }
+
+        void ExecutionEngineService::setMessageBudget(unsigned int max_messages) {
+            engine()->setMessageBudget(max_messages);
+        }
+
+        unsigned int ExecutionEngineService::getMessageBudget() const {
+            return engine()->getMessageBudget();
+        }
+
+        void ExecutionEngineService::setMessageTimeBudget(Seconds max_time) {
+            engine()->setMessageTimeBudget(max_time);
+        }
+
+        Seconds ExecutionEngineService::getMessageTimeBudget() const {
+            return engine()->getMessageTimeBudget();
+        }
+
+        unsigned int ExecutionEngineService::getMessageQueueDepth() const {
+            return engine()->getMessageQueueDepth();
+        }
+
+        unsigned int ExecutionEngineService::getMaxMessageQueueDepth() const {
+            return engine()->getMaxMessageQueueDepth();
+        }
+
+        unsigned int ExecutionEngineService::getMessagesProcessed() const {
+            return engine()->getMessagesProcessed();
+        }
+
+        unsigned int ExecutionEngineService::getLastMessagesProcessed() const {
+            return engine()->getLastMessagesProcessed();
+        }
+
+        Seconds ExecutionEngineService::getLastMessageProcessingTime() const {
+            return engine()->getLastMessageProcessingTime();
+        }
+
+        Seconds ExecutionEngineService::getMaxMessageProcessingTime() const {
+            return engine()->getMaxMessageProcessingTime();
+        }
+
+        void ExecutionEngineService::resetMessageStatistics() {
+            engine()->resetMessageStatistics();
+        }
+
+        os::ThreadInterface* ExecutionEngineService::thread() const {
+            base::ActivityInterface* act = engine()->getActivity();
+            return act ? act->thread() : 0;
+        }
+
+        os::ThreadStatistics ExecutionEngineService::threadStatistics() const {
+            os::ThreadStatistics stats;
+            os::ThreadInterface* t = thread();
+            if (t)
+                t->getStatistics(stats);
+            return stats;
+        }
+
+        bool ExecutionEngineService::setThreadStatisticsEnabled(bool enable) {
+            os::ThreadInterface* t = thread();
+            return t && t->setStatisticsEnabled(enable);
+        }
+
+        bool ExecutionEngineService::isThreadStatisticsEnabled() const {
+            os::ThreadInterface* t = thread();
+            return t && t->isStatisticsEnabled();
+        }
+
+        Seconds ExecutionEngineService::getMaxWakeupLatency() const {
+            return nsecs_to_Seconds( threadStatistics().wakeup.getMax() );
+        }
+
+        Seconds ExecutionEngineService::getMeanWakeupLatency() const {
+            return nsecs_to_Seconds( threadStatistics().wakeup.getMean() );
+        }
+
+        Seconds ExecutionEngineService::getMaxStepTime() const {
+            return nsecs_to_Seconds( threadStatistics().step.getMax() );
+        }
+
+        Seconds ExecutionEngineService::getMeanStepTime() const {
+            return nsecs_to_Seconds( threadStatistics().step.getMean() );
+        }
+
+        unsigned int ExecutionEngineService::getThreadOverruns() const {
+            return threadStatistics().overruns;
+        }
+
+        void ExecutionEngineService::resetThreadStatistics() {
+            os::ThreadInterface* t = thread();
+            if (t)
+                t->resetStatistics();
+        }
+
+        namespace {
+            void dumpHistogram(std::ostream& out, const char* name, const os::TimeHistogram& h) {
+                out << name << ": " << h.getCount() << " samples, min " << h.getMin()
+                   << "ns, mean " << h.getMean() << "ns, max " << h.getMax() << "ns" << std::endl;
+                for (unsigned int i = 0; i != os::TimeHistogram::Buckets; ++i)
+                    if ( h.getBucket(i) )
+                        out << "  >= " << os::TimeHistogram::getBucketStart(i) << "ns: " << h.getBucket(i) << std::endl;
+            }
+        }
+
+        std::string ExecutionEngineService::dumpThreadStatistics() const {
+            std::stringstream result;
+            os::ThreadStatistics stats = threadStatistics();
+            dumpHistogram(result, "wakeup latency", stats.wakeup);
+            dumpHistogram(result, "step time", stats.step);
+            result << "overruns: " << stats.overruns << std::endl;
+            return result.str();
+        }
+    }
+
+}
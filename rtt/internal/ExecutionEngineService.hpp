@@ -0,0 +1,102 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  ExecutionEngineService.hpp
+
+                        ExecutionEngineService.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_EXECUTION_ENGINE_SERVICE_HPP
+#define ORO_EXECUTION_ENGINE_SERVICE_HPP
+
+#include "../Service.hpp"
+#include "../os/Time.hpp"
+#include "../os/ThreadStatistics.hpp"
+#include <string>
+
+namespace RTT
+{
+    namespace internal
+    {
+
+        /**
+         * The 'engine' service of a TaskContext, which allows to tune
+         * and monitor the message processing of its ExecutionEngine
+         * and the timing of its thread at run-time, and describes the
+         * statistics of its data flow connections. It is not present by
+         * default, load it with TaskContext::loadService("engine").
+         * @see ExecutionEngine::setMessageBudget
+         */
+        class RTT_API ExecutionEngineService: public RTT::Service
+        {
+        public:
+            /**
+             * Creates the service of the ExecutionEngine of \a owner.
+             * You need to add the service to \a owner yourself.
+             */
+            ExecutionEngineService(TaskContext* owner);
+            virtual ~ExecutionEngineService();
+
+            void setMessageBudget(unsigned int max_messages);
+            unsigned int getMessageBudget() const;
+            void setMessageTimeBudget(Seconds max_time);
+            Seconds getMessageTimeBudget() const;
+            unsigned int getMessageQueueDepth() const;
+            unsigned int getMaxMessageQueueDepth() const;
+            unsigned int getMessagesProcessed() const;
+            unsigned int getLastMessagesProcessed() const;
+            Seconds getLastMessageProcessingTime() const;
+            Seconds getMaxMessageProcessingTime() const;
+            void resetMessageStatistics();
+            bool setThreadStatisticsEnabled(bool enable);
+            bool isThreadStatisticsEnabled() const;
+            Seconds getMaxWakeupLatency() const;
+            Seconds getMeanWakeupLatency() const;
+            Seconds getMaxStepTime() const;
+            Seconds getMeanStepTime() const;
+            unsigned int getThreadOverruns() const;
+            void resetThreadStatistics();
+            std::string dumpThreadStatistics() const;
+        private:
+            ExecutionEngine* engine() const;
+            /**
+             * The thread of our owner, null if it is not run by a thread.
+             */
+            os::ThreadInterface* thread() const;
+            os::ThreadStatistics threadStatistics() const;
+        };
+
+    }
+
+}
+
+#endif
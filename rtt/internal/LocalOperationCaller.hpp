@@ -51,6 +51,7 @@
 #include "../SendHandle.hpp"
 #include "../ExecutionEngine.hpp"
 #include "OperationCallerBinder.hpp"
+#include "SharedPool.hpp"
 #include <boost/fusion/include/vector_tie.hpp>
 #include "../os/oro_allocator.hpp"
 
@@ -135,13 +136,16 @@ namespace RTT
             SendHandle<Signature> do_send(shared_ptr cl) {
                 assert(this->myengine); // myengine must be either the caller's engine or GlobalEngine::Instance().
                 //std::cout << "Sending clone..."<<std::endl;
+                // self must be set before the clone is processed, since it may be
+                // disposed before process() returns.
+                cl->self = cl;
                 if ( this->myengine->process( cl.get() ) ) {
-                    cl->self = cl;
                     return SendHandle<Signature>( cl );
                 } else {
                     // cleanup. Done by shared_ptr.
                     //cl->~OperationCallerBase();
                     //oro_rt_free(cl);
+                    cl->dispose();
                     return SendHandle<Signature>();
                 }
             }
@@ -633,6 +637,7 @@ namespace RTT
             typedef boost::function_traits<Signature> traits;
 
             typedef boost::shared_ptr<LocalOperationCaller> shared_ptr;
+            typedef SharedPool<LocalOperationCaller> SendPool;
 
             /**
              * Create an empty LocalOperationCaller object.
@@ -699,10 +704,64 @@ namespace RTT
 
             typename LocalOperationCallerImpl<Signature>::shared_ptr cloneRT() const
             {
+                if ( msendpool ) {
+                    shared_ptr ret = msendpool->allocate();
+                    if ( ret ) {
+                        ret->prepareSend( *this );
+                        return ret;
+                    }
+                }
                 //void* obj = oro_rt_malloc(sizeof(LocalOperationCallerImpl<Signature>));
                 //return new(obj) LocalOperationCaller<Signature>(*this);
                 return boost::allocate_shared<LocalOperationCaller<Signature> >(os::rt_allocator<LocalOperationCaller<Signature> >(), *this);
             }
+
+            /**
+             * Reserves \a size clones for send(), such that sending does not
+             * allocate memory as long as less than \a size sends are in progress.
+             * The pool is shared with all copies of this object that are made
+             * afterwards. The clones are copies of this object, so they already
+             * hold its function, which is never copied again when sending.
+             * @param size The number of clones, zero to allocate each clone.
+             * @nrt
+             */
+            void setSendPool(unsigned int size)
+            {
+                // reset first, such that the clones do not own their pool.
+                msendpool.reset();
+                if ( size )
+                    msendpool.reset( new SendPool(size, *this) );
+            }
+
+            /**
+             * Returns the pool of clones used by send(), may be null.
+             */
+            boost::shared_ptr<SendPool> getSendPool() const
+            {
+                return msendpool;
+            }
+
+        private:
+            /**
+             * Prepares a pooled clone for a send() of \a orig. Only the
+             * engines, the signal and the state of the return value are
+             * assigned, none of which allocates memory. The arguments are
+             * assigned in place by store() afterwards.
+             */
+            void prepareSend(LocalOperationCaller const& orig)
+            {
+                this->myengine = orig.myengine;
+                this->caller = orig.caller;
+                this->ownerEngine = orig.ownerEngine;
+                this->met = orig.met;
+#ifdef ORO_SIGNALLING_OPERATIONS
+                this->msig = orig.msig;
+#endif
+                this->retv.executed = false;
+                this->retv.error = false;
+            }
+
+            boost::shared_ptr<SendPool> msendpool;
         };
     }
 }
@@ -0,0 +1,183 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  SharedPool.hpp
+
+                        SharedPool.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_SHARED_POOL_HPP
+#define ORO_SHARED_POOL_HPP
+
+#include "TsPool.hpp"
+#include <boost/shared_ptr.hpp>
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/static_assert.hpp>
+#include <cstddef>
+
+/**
+ * The room reserved in each element of a SharedPool for
+ * the reference counter of its boost::shared_ptr.
+ */
+#ifndef ORONUM_SHARED_POOL_COUNTER_SIZE
+#define ORONUM_SHARED_POOL_COUNTER_SIZE 96
+#endif
+
+namespace RTT
+{
+    namespace internal
+    {
+        /**
+         * A fixed size, lock-free pool of objects which are handed out
+         * as boost::shared_ptr without allocating memory. Each element of
+         * the pool reserves room for the reference counter of its shared_ptr,
+         * and only returns to the pool when that counter is released,
+         * which is after the last shared_ptr (or weak_ptr) to it is gone.
+         *
+         * The pool itself must be owned by a boost::shared_ptr. It stays
+         * alive as long as one of its elements is in use.
+         * @param T The type of the objects, which must be default constructible
+         * and assignable.
+         */
+        template<class T>
+        class SharedPool
+            : public boost::enable_shared_from_this< SharedPool<T> >
+        {
+        public:
+            typedef boost::shared_ptr<SharedPool<T> > shared_ptr;
+        private:
+            typedef typename boost::aligned_storage<ORONUM_SHARED_POOL_COUNTER_SIZE>::type Counter;
+
+            struct Slot
+            {
+                T object;
+                Counter counter;
+            };
+
+            /**
+             * Lets a shared_ptr place its counter in a Slot and returns
+             * the Slot to the pool when that counter is freed.
+             */
+            template<class U>
+            class SlotAllocator
+            {
+            public:
+                typedef U                 value_type;
+                typedef value_type*       pointer;
+                typedef const value_type* const_pointer;
+                typedef value_type&       reference;
+                typedef const value_type& const_reference;
+                typedef std::size_t       size_type;
+                typedef std::ptrdiff_t    difference_type;
+
+                template <class V>
+                struct rebind { typedef SlotAllocator<V> other; };
+
+                SlotAllocator(shared_ptr pool, Slot* slot) : mpool(pool), mslot(slot) {}
+                template <class V>
+                SlotAllocator(const SlotAllocator<V>& other) : mpool(other.mpool), mslot(other.mslot) {}
+
+                pointer allocate(size_type n, const void* = 0) {
+                    BOOST_STATIC_ASSERT( sizeof(U) <= sizeof(Counter) );
+                    assert( n == 1 );
+                    return static_cast<pointer>( static_cast<void*>( &mslot->counter ) );
+                }
+
+                void deallocate(pointer, size_type) {
+                    mpool->mslots.deallocate( mslot );
+                }
+
+                size_type max_size() const { return 1; }
+                void construct(pointer p, const value_type& x) { new(p) value_type(x); }
+                void destroy(pointer p) { p->~value_type(); }
+
+                bool operator==(const SlotAllocator& other) const { return mslot == other.mslot; }
+                bool operator!=(const SlotAllocator& other) const { return mslot != other.mslot; }
+
+                shared_ptr mpool;
+                Slot* mslot;
+            };
+
+            /**
+             * The object lives as long as its Slot, so nothing is to be done
+             * when the last shared_ptr releases it.
+             */
+            struct NoDelete
+            {
+                void operator()(T*) const {}
+            };
+
+            TsPool<Slot> mslots;
+
+        public:
+            /**
+             * Creates a pool of \a size objects.
+             * @param size The number of objects, at most 65535.
+             * @param sample Each object is a copy of \a sample.
+             */
+            SharedPool(unsigned int size, const T& sample = T())
+                : mslots(size)
+            {
+                Slot s;
+                s.object = sample;
+                mslots.data_sample(s);
+            }
+
+            /**
+             * Returns a free object of this pool, or a null pointer
+             * if all objects are in use. The object keeps the value it had
+             * when it was released.
+             * @rt
+             */
+            boost::shared_ptr<T> allocate()
+            {
+                Slot* slot = mslots.allocate();
+                if ( !slot )
+                    return boost::shared_ptr<T>();
+                return boost::shared_ptr<T>( &slot->object, NoDelete(), SlotAllocator<T>( this->shared_from_this(), slot ) );
+            }
+
+            /**
+             * Returns the number of objects of this pool.
+             */
+            unsigned int capacity() { return mslots.capacity(); }
+
+            /**
+             * Returns the number of free objects of this pool.
+             */
+            unsigned int size() { return mslots.size(); }
+        };
+    }
+}
+
+#endif
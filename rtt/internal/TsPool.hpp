@@ -47,6 +47,7 @@
 #define RTT_TSPOOL_HPP_
 
 #include "../os/CAS.hpp"
+#include "../os/oro_arch.h"
 #include <assert.h>
 
 namespace RTT
@@ -57,6 +58,9 @@ namespace RTT
         /**
          * A multi-reader multi-writer MemoryPool implementation.
          * It can hold max 65535 elements of type T.
+         * Every allocated element carries a reference count, such that
+         * it can be shared by multiple owners with ref() and is only
+         * returned to the pool by the last call to deallocate().
          */
         template<typename T>
         class TsPool
@@ -83,11 +87,13 @@ namespace RTT
             {
                 value_t value;
                 volatile Pointer_t next;
+                oro_atomic_t rc;
 
                 Item() :
                     value(value_t())
                 {
                     next.value = 0;
+                    ORO_ATOMIC_SETUP(&rc, 0);
                 }
             };
 
@@ -139,6 +145,7 @@ namespace RTT
                 for (unsigned int i = 0; i < pool_capacity; i++)
                 {
                     pool[i].next.ptr.index = i + 1;
+                    oro_atomic_set(&pool[i].rc, 0);
                 }
                 pool[pool_capacity - 1].next.ptr.index = (unsigned short) -1;
                 head.next.ptr.index = 0;
@@ -173,19 +180,43 @@ namespace RTT
                     newval.ptr.index = item->next.ptr.index;
                     newval.ptr.tag = oldval.ptr.tag + 1;
                 } while (!os::CAS(&head.next.value, oldval.value, newval.value));
+                oro_atomic_set(&item->rc, 1);
                 return &item->value;
             }
 
+            /**
+             * Adds an owner to an element returned by allocate().
+             * Each call to ref() must be matched by a call to deallocate().
+             * @param Value An element that is currently allocated.
+             * @return false if \a Value is null.
+             */
+            bool ref(T* Value)
+            {
+                if (Value == 0)
+                {
+                    return false;
+                }
+                assert(owns(Value));
+                oro_atomic_inc(&reinterpret_cast<Item*> (Value)->rc);
+                return true;
+            }
+
+            /**
+             * Drops one owner of an element. The element is returned
+             * to the pool when its last owner deallocates it.
+             */
             bool deallocate(T* Value)
             {
                 if (Value == 0)
                 {
                     return false;
                 }
-                assert(Value >= (T*) &pool[0] && Value <= (T*) &pool[pool_capacity]);
+                assert(owns(Value));
                 volatile Pointer_t oldval;
                 Pointer_t head_next;
                 Item* item = reinterpret_cast<Item*> (Value);
+                if ( !oro_atomic_dec_and_test(&item->rc) )
+                    return true;
                 do
                 {
                     oldval.value = head.next.value;
@@ -215,6 +246,14 @@ namespace RTT
                 return ret;
             }
 
+            /**
+             * Checks if \a Value points to an element of this pool.
+             */
+            bool owns(const T* Value) const
+            {
+                return Value >= (const T*) &pool[0] && Value < (const T*) &pool[pool_capacity];
+            }
+
             /**
              * The maximum number of elements available for allocation.
              * @return The maximum size.
@@ -85,6 +85,8 @@ namespace RTT {
         template<class T, class Enable>
         struct DSWrap;
         template<class T>
+        class AtomicMPSCQueue;
+        template<class T>
         class AtomicMWSRQueue;
         template<class T>
         class AtomicQueue;
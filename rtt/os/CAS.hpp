@@ -55,6 +55,16 @@ namespace RTT
         return expected == oro_cmpxchg(addr, expected, value);
     }
 
+    /**
+     * Orders the loads and stores before and after it. A locked
+     * operation on a local variable is a full memory barrier on all
+     * supported architectures and does not touch shared cache lines.
+     */
+    inline void fence() {
+        volatile unsigned int local = 0;
+        CAS(&local, 0u, 1u);
+    }
+
 }}
 
 #endif
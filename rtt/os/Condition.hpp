@@ -46,6 +46,7 @@
 #ifdef ORO_OS_USE_BOOST_THREAD
 // BOOST_DATE_TIME_POSIX_TIME_STD_CONFIG is defined in rtt-config.h
 #include <boost/thread/condition.hpp>
+#include <boost/thread/thread_time.hpp>
 #include <boost/date_time/posix_time/posix_time_types.hpp>
 #endif
 
@@ -199,15 +200,15 @@ namespace RTT
          */
         bool wait_until(Mutex& m, nsecs abs_time)
         {
-            // abs_time is since epoch, so set p_time to epoch, then add our abs_time.
-            boost::posix_time::ptime p_time = boost::posix_time::from_time_t(0);
-            boost::posix_time::nanosec abs_p_time = boost::posix_time::nanoseconds(abs_time);
-            // wakeup time = epoch date + time since epoch
-            p_time = p_time + abs_p_time;
-            return c.timed_wait(m, p_time, &Condition::retfalse );
+            // abs_time is on the clock of rtos_get_time_ns(), which need not
+            // count from the epoch: convert the remaining time to a deadline
+            // on the clock boost waits on.
+            nsecs remaining = abs_time - rtos_get_time_ns();
+            if ( remaining < 0 )
+                remaining = 0;
+            boost::system_time p_time = boost::get_system_time() + boost::posix_time::nanoseconds(remaining);
+            return c.timed_wait(m, p_time);
         }
-    private:
-        static bool retfalse() { return false; }
 
 #endif
 
@@ -41,6 +41,7 @@
 #include "threads.hpp"
 #include "../Logger.hpp"
 #include "MutexLock.hpp"
+#include "CAS.hpp"
 
 #include "../rtt-config.h"
 #include "../internal/CatchConfig.hpp"
@@ -125,8 +126,14 @@ namespace RTT {
                             if (task->period != 0) // periodic
                             {
                                 MutexLock lock(task->breaker);
+                                // programmed wake up time of this period, if known.
+                                NANO_TIME wakeup = 0;
+                                NANO_TIME start = 0;
                                 while(task->running && !task->prepareForExit )
                                 {
+                                    bool stats = task->mstats_enabled;
+                                    if (stats)
+                                        start = rtos_get_time_ns();
                                     TRY
                                     (
                                         SCOPE_ON
@@ -139,6 +146,9 @@ namespace RTT {
                                         throw;
                                     )
 
+                                    if (stats)
+                                        task->recordStatistics(wakeup, start, false);
+
                                     // Check changes in period
                                     if ( cur_period != task->period) {
                                         // reconfigure period before going to sleep
@@ -156,14 +166,23 @@ namespace RTT {
                                     // rtos_task_wait_period will return immediately if
                                     // the task is not periodic (ie period == 0)
                                     // return non-zero to indicate overrun.
+                                    NANO_TIME mark = rtos_task_get_period_mark(task->getTask());
                                     if (rtos_task_wait_period(task->getTask()) != 0)
                                     {
+                                        // a late wake up is counted as overrun, not as latency.
+                                        wakeup = 0;
+                                        if (stats)
+                                            task->recordStatistics(0, 0, true);
                                         ++overruns;
                                         if (overruns == task->maxOverRun)
                                             break; // break while(task->running)
                                     }
-                                    else if (overruns != 0)
-                                        --overruns;
+                                    else {
+                                        // the nominal wake up time of the next step.
+                                        wakeup = mark;
+                                        if (overruns != 0)
+                                            --overruns;
+                                    }
                                 } // while(task->running)
                                 if (overruns == task->maxOverRun || task->prepareForExit)
                                     break; // break while(1) {}
@@ -241,7 +260,7 @@ namespace RTT {
 #ifdef OROPKG_OS_THREAD_SCOPE
         ,d(NULL)
 #endif
-                    , stopTimeout(0)
+                    , stopTimeout(0), mstats_seq(0), mstats_enabled(false), mstats_reset(false)
         {
             this->setup(_priority, cpu_affinity, name);
         }
@@ -648,6 +667,60 @@ namespace RTT {
             rtos_task_set_wait_period_policy(&rtos_task, p);  
         }
 
+        void Thread::recordStatistics(NANO_TIME wakeup, NANO_TIME start, bool overrun)
+        {
+            NANO_TIME end = overrun ? 0 : rtos_get_time_ns();
+            mstats_seq = mstats_seq + 1; // odd: being written
+            fence();
+            if (mstats_reset) {
+                mstats.reset();
+                mstats_reset = false;
+            }
+            if (overrun)
+                ++mstats.overruns;
+            else {
+                if (wakeup != 0)
+                    mstats.wakeup.add(start - wakeup);
+                mstats.step.add(end - start);
+            }
+            fence();
+            mstats_seq = mstats_seq + 1; // even: complete
+        }
+
+        bool Thread::setStatisticsEnabled(bool enable)
+        {
+            // only the periodic loop records statistics.
+            if ( enable && getPeriodNS() == 0 )
+                return false;
+            mstats_enabled = enable;
+            return true;
+        }
+
+        bool Thread::isStatisticsEnabled() const
+        {
+            return mstats_enabled;
+        }
+
+        bool Thread::getStatistics(ThreadStatistics& stats) const
+        {
+            unsigned int before, after;
+            do {
+                before = mstats_seq;
+                fence();
+                stats = mstats;
+                fence();
+                after = mstats_seq;
+            } while ( (before & 1) || before != after );
+            if (mstats_reset)
+                stats.reset();
+            return true;
+        }
+
+        void Thread::resetStatistics()
+        {
+            mstats_reset = true;
+        }
+
     }
 }
 
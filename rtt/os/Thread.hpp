@@ -240,6 +240,14 @@ namespace RTT
 
             virtual void setWaitPeriodPolicy(int p);
 
+            virtual bool setStatisticsEnabled(bool enable);
+
+            virtual bool isStatisticsEnabled() const;
+
+            virtual bool getStatistics(ThreadStatistics& stats) const;
+
+            virtual void resetStatistics();
+
         protected:
             /**
              * Exit and destroy the thread
@@ -284,6 +292,15 @@ namespace RTT
              */
             void configure();
 
+            /**
+             * Adds the samples of one period to mstats.
+             * @param wakeup The programmed wake up time of this period,
+             * zero if it is not known.
+             * @param start The time at which step() was called.
+             * @param overrun True if the thread woke up too late.
+             */
+            void recordStatistics(NANO_TIME wakeup, NANO_TIME start, bool overrun);
+
             static unsigned int default_stack_size;
 
             /**
@@ -353,6 +370,16 @@ namespace RTT
              */
             double stopTimeout;
 
+            /**
+             * Statistics of the periodic loop. Only written by the thread
+             * itself, and read by copying under the mstats_seq sequence
+             * number, which is odd while the thread writes.
+             */
+            ThreadStatistics mstats;
+            volatile unsigned int mstats_seq;
+            bool mstats_enabled;
+            volatile bool mstats_reset;
+
 #ifdef OROPKG_OS_THREAD_SCOPE
             // Pointer to Threadscope device
             dev::DigitalOutInterface * d;
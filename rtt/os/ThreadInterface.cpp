@@ -59,3 +59,22 @@ bool ThreadInterface::isSelf() const
 {
     return rtos_task_is_self( this->getTask() ) == 1;
 }
+
+bool ThreadInterface::setStatisticsEnabled(bool)
+{
+    return false;
+}
+
+bool ThreadInterface::isStatisticsEnabled() const
+{
+    return false;
+}
+
+bool ThreadInterface::getStatistics(ThreadStatistics&) const
+{
+    return false;
+}
+
+void ThreadInterface::resetStatistics()
+{
+}
@@ -42,6 +42,7 @@
 #include "fosi.h"
 #include "threads.hpp"
 #include "Time.hpp"
+#include "ThreadStatistics.hpp"
 #include "../rtt-config.h"
 
 namespace RTT
@@ -205,6 +206,30 @@ namespace RTT
              */
             virtual void yield() = 0;
 
+            /**
+             * Enables or disables the collection of ThreadStatistics in
+             * the periodic loop of this thread. It is disabled by default,
+             * which costs one test per period.
+             * @return false if this thread does not collect statistics,
+             * which is also the case for a non periodic thread.
+             */
+            virtual bool setStatisticsEnabled(bool enable);
+
+            virtual bool isStatisticsEnabled() const;
+
+            /**
+             * Copies the statistics collected since the last reset
+             * into \a stats. This does not block the thread.
+             * @return false if this thread does not collect statistics.
+             */
+            virtual bool getStatistics(ThreadStatistics& stats) const;
+
+            /**
+             * Clears the statistics. The thread applies this at its next
+             * sample, but getStatistics() reports empty statistics right away.
+             */
+            virtual void resetStatistics();
+
             /**
              * The unique thread number (within the same process).
              */
@@ -213,7 +238,10 @@ namespace RTT
                 return threadnb;
             }
 
-            bool isSelf() const;
+            /**
+             * Returns true if the calling thread is this thread.
+             */
+            virtual bool isSelf() const;
         protected:
             /**
              * Threads are given an unique number,
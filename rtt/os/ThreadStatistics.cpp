@@ -0,0 +1,69 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  ThreadStatistics.cpp
+
+                        ThreadStatistics.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "ThreadStatistics.hpp"
+
+namespace RTT
+{
+    namespace os
+    {
+        TimeHistogram::TimeHistogram()
+        {
+            reset();
+        }
+
+        void TimeHistogram::reset()
+        {
+            count = 0;
+            min = max = total = 0;
+            for (unsigned int i = 0; i != Buckets; ++i)
+                buckets[i] = 0;
+        }
+
+        ThreadStatistics::ThreadStatistics()
+            : overruns(0)
+        {
+        }
+
+        void ThreadStatistics::reset()
+        {
+            wakeup.reset();
+            step.reset();
+            overruns = 0;
+        }
+    }
+}
@@ -0,0 +1,148 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  ThreadStatistics.hpp
+
+                        ThreadStatistics.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_OS_THREAD_STATISTICS_HPP
+#define ORO_OS_THREAD_STATISTICS_HPP
+
+#include "Time.hpp"
+#include "../rtt-config.h"
+
+namespace RTT
+{
+    namespace os
+    {
+        /**
+         * Counts durations in buckets of fixed size and keeps their
+         * minimum, maximum and mean. Bucket 0 counts durations
+         * below 1us, bucket i counts durations from 2^(i-1)us up to
+         * 2^i us and the last bucket counts everything longer.
+         * Adding a sample does not allocate or lock.
+         */
+        class RTT_API TimeHistogram
+        {
+        public:
+            /**
+             * The number of buckets. The last one starts at about 0.26s.
+             */
+            static const unsigned int Buckets = 20;
+
+            TimeHistogram();
+
+            /**
+             * Adds a duration in nanoseconds. Negative durations
+             * are counted as zero.
+             */
+            void add(nsecs sample)
+            {
+                if (sample < 0)
+                    sample = 0;
+                if (count == 0 || sample < min)
+                    min = sample;
+                if (sample > max)
+                    max = sample;
+                total += sample;
+                ++count;
+                unsigned int b = 0;
+                for (nsecs us = sample >> 10; us != 0 && b != Buckets - 1; us >>= 1)
+                    ++b;
+                ++buckets[b];
+            }
+
+            void reset();
+
+            /**
+             * The number of samples since the last reset.
+             */
+            unsigned int getCount() const { return count; }
+            nsecs getMin() const { return min; }
+            nsecs getMax() const { return max; }
+            /**
+             * The mean of all samples, zero if there are none.
+             */
+            nsecs getMean() const { return count ? total / count : 0; }
+
+            /**
+             * The number of samples in bucket \a i.
+             */
+            unsigned int getBucket(unsigned int i) const { return i < Buckets ? buckets[i] : 0; }
+
+            /**
+             * The lower limit of bucket \a i in nanoseconds.
+             * Bucket sizes are powers of two of 1024ns, which
+             * is close enough to one microsecond.
+             */
+            static nsecs getBucketStart(unsigned int i) { return i == 0 ? 0 : nsecs(1024) << (i - 1); }
+        private:
+            unsigned int count;
+            nsecs min;
+            nsecs max;
+            nsecs total;
+            unsigned int buckets[Buckets];
+        };
+
+        /**
+         * The timing statistics of the periodic loop of a thread.
+         * @see ThreadInterface::getStatistics
+         */
+        struct RTT_API ThreadStatistics
+        {
+            ThreadStatistics();
+
+            /**
+             * The delay between the programmed wake up of the thread
+             * and the start of its step. It stays empty on targets which
+             * do not expose the programmed wake up time, see
+             * rtos_task_get_period_mark().
+             */
+            TimeHistogram wakeup;
+
+            /**
+             * The execution time of a step.
+             */
+            TimeHistogram step;
+
+            /**
+             * The number of periods in which the thread woke up too late.
+             */
+            unsigned int overruns;
+
+            void reset();
+        };
+    }
+}
+
+#endif
@@ -139,7 +139,9 @@ namespace RTT {
     TimeService::nsecs
     TimeService::getNSecs() const
     {
-        return ticks2nsecs(offset) + (use_clock) ? (rtos_get_time_ns()) : (0); 
+        // without an offset, the ticks need not be converted.
+        nsecs off = offset ? ticks2nsecs(offset) : 0;
+        return use_clock ? rtos_get_time_ns() + off : off;
     }
 
     TimeService::nsecs
@@ -166,7 +166,9 @@ namespace RTT
         /**
          * Get current nsecs of the System clock
          *
-         * @return current nsecs of the system clock
+         * @return current nsecs of the system clock. On gnulinux, this
+         * only counts from the Unix epoch if the library was configured
+         * with OS_GNULINUX_CLOCK=REALTIME.
          */
         nsecs getNSecs() const;
 
@@ -70,23 +70,37 @@ namespace RTT {
                 // We can't use infinite as the OS may internally use time_spec, which can not
                 // represent as much in the future (until 2038) // XXX Year-2038 Bug
                 wake_up_time = (TimeService::InfiniteNSecs/4)-1;
-                for (TimerIds::iterator it = mtimers.begin(); it != mtimers.end(); ++it) {
-                    if ( it->first != 0 && it->first < wake_up_time  ) {
-                        wake_up_time = it->first;
-                        next_timer_id = it - mtimers.begin();
+                if ( mbackend == MinHeap ) {
+                    if ( !mheap.empty() ) {
+                        next_timer_id = mheap.front();
+                        wake_up_time = mtimers[next_timer_id].first;
+                    }
+                } else {
+                    for (TimerIds::iterator it = mtimers.begin(); it != mtimers.end(); ++it) {
+                        if ( it->first != 0 && it->first < wake_up_time  ) {
+                            wake_up_time = it->first;
+                            next_timer_id = it - mtimers.begin();
+                        }
                     }
                 }
             }// MutexLock
 
             // Wait
             int ret = 0;
-            if ( wake_up_time > mTimeserv->getNSecs() )
-                ret = msem.waitUntil( wake_up_time ); // case of no timers or running timers
+            Time now = mTimeserv->getNSecs();
+            if ( wake_up_time > now )
+                // msem waits on the clock of rtos_get_time_ns(), which
+                // does not follow the offset or stop of the TimeService.
+                ret = msem.waitUntil( rtos_get_time_ns() + (wake_up_time - now) ); // case of no timers or running timers
             else
                 ret = -1; // case of timer overrun.
 
             // Timeout handling
             if (ret == -1) {
+                if ( mbackend == MinHeap ) {
+                    fireExpired();
+                    continue;
+                }
                 // a timer expired
                 // First: reset/reprogram the timer that expired:
                 {
@@ -95,6 +109,8 @@ namespace RTT {
                     if ( next_timer_id < int(mtimers.size()) ) {
                         // now clear or reprogram it.
                         TimerIds::iterator tim = mtimers.begin() + next_timer_id;
+                        if ( tim->first )
+                            addTimeout( tim->first, mTimeserv->getNSecs() );
                         if ( tim->second ) {
                             // periodic timer
                             tim->first += tim->second;
@@ -113,6 +129,118 @@ namespace RTT {
         }
     }
 
+    void Timer::fireExpired()
+    {
+        {
+            MutexLock locker(m);
+            Time now = mTimeserv->getNSecs();
+            // take over the storage reserved by setMaxTimers(), without allocating.
+            if ( mexpired_spare.capacity() > mexpired.capacity() )
+                mexpired.swap( mexpired_spare );
+            mexpired.clear();
+            // First take all expired timers from the heap, such that a periodic
+            // timer which is late fires only once in this wake up.
+            while ( !mheap.empty() && mtimers[ mheap.front() ].first <= now ) {
+                TimerId id = mheap.front();
+                addTimeout( mtimers[id].first, now );
+                mexpired.push_back( id );
+                heapSwap( 0, mheap.size() - 1 );
+                mheap.pop_back();
+                mheap_pos[id] = -1;
+                heapDown( 0 );
+            }
+            // Then clear or reprogram them.
+            for (std::vector<TimerId>::iterator it = mexpired.begin(); it != mexpired.end(); ++it) {
+                if ( mtimers[*it].second ) {
+                    mtimers[*it].first += mtimers[*it].second;
+                    update( *it );
+                } else
+                    mtimers[*it].first = 0;
+            }
+        }
+        // mexpired is only modified by this thread, so the timeout()
+        // callbacks may reprogram the timers.
+        for (std::vector<TimerId>::iterator it = mexpired.begin(); it != mexpired.end(); ++it)
+            timeout( *it );
+    }
+
+    void Timer::addTimeout(Time due_time, Time now)
+    {
+        Time lateness = now > due_time ? now - due_time : 0;
+        ++mtimeouts;
+        mlateness_total += lateness;
+        if ( lateness > mlateness_max )
+            mlateness_max = lateness;
+    }
+
+    bool Timer::update(TimerId timer_id)
+    {
+        if ( mbackend != MinHeap )
+            return true;
+        int pos = mheap_pos[timer_id];
+        if ( mtimers[timer_id].first == 0 ) {
+            // remove it.
+            if ( pos == -1 )
+                return false;
+            int last = mheap.size() - 1;
+            heapSwap( pos, last );
+            mheap.pop_back();
+            mheap_pos[timer_id] = -1;
+            if ( pos != last ) {
+                heapDown( pos );
+                heapUp( pos );
+            }
+            return false;
+        }
+        if ( pos == -1 ) {
+            pos = mheap.size();
+            mheap.push_back( timer_id );
+            mheap_pos[timer_id] = pos;
+        }
+        heapDown( pos );
+        heapUp( mheap_pos[timer_id] );
+        return mheap.front() == timer_id;
+    }
+
+    bool Timer::heapLess(int a, int b) const
+    {
+        return mtimers[ mheap[a] ].first < mtimers[ mheap[b] ].first;
+    }
+
+    void Timer::heapSwap(int a, int b)
+    {
+        std::swap( mheap[a], mheap[b] );
+        mheap_pos[ mheap[a] ] = a;
+        mheap_pos[ mheap[b] ] = b;
+    }
+
+    void Timer::heapUp(int pos)
+    {
+        while ( pos > 0 ) {
+            int parent = (pos - 1) / 2;
+            if ( !heapLess( pos, parent ) )
+                break;
+            heapSwap( pos, parent );
+            pos = parent;
+        }
+    }
+
+    void Timer::heapDown(int pos)
+    {
+        int size = mheap.size();
+        while ( true ) {
+            int child = 2 * pos + 1;
+            if ( child >= size )
+                break;
+            if ( child + 1 < size && heapLess( child + 1, child ) )
+                ++child;
+            if ( !heapLess( child, pos ) )
+                break;
+            heapSwap( pos, child );
+            pos = child;
+        }
+    }
+
     bool Timer::breakLoop()
     {
         mdo_quit = true;
@@ -120,11 +248,17 @@ namespace RTT {
         return true;
     }
 
-    Timer::Timer(TimerId max_timers, int scheduler, int priority)
-        : mThread(0), msem(0), mdo_quit(false)
+    Timer::Timer(TimerId max_timers, int scheduler, int priority, Backend backend)
+        : mThread(0), msem(0), mdo_quit(false), mbackend(backend),
+          mtimeouts(0), mlateness_max(0), mlateness_total(0)
     {
         mTimeserv = TimeService::Instance();
         mtimers.resize(max_timers);
+        if ( mbackend == MinHeap ) {
+            mheap.reserve(max_timers);
+            mheap_pos.resize(max_timers, -1);
+            mexpired.reserve(max_timers);
+        }
         if (scheduler != -1) {
             mThread = new Activity(scheduler, priority, 0.0, this, "Timer");
             mThread->start();
@@ -144,13 +278,28 @@ namespace RTT {
 
     void Timer::setMaxTimers(TimerId max)
     {
+        // the timer thread may be iterating mexpired without the lock,
+        // so it takes over this storage itself, see fireExpired().
+        std::vector<TimerId> expired;
+        if ( mbackend == MinHeap )
+            expired.reserve(max);
         MutexLock locker(m);
         mtimers.resize(max, std::make_pair(Time(0), Time(0)) );
+        if ( mbackend == MinHeap ) {
+            mexpired_spare.swap( expired );
+            // rebuild the heap from the remaining timers.
+            mheap.clear();
+            mheap.reserve(max);
+            mheap_pos.assign(max, -1);
+            for (TimerId id = 0; id < max; ++id)
+                if ( mtimers[id].first )
+                    update( id );
+        }
     }
 
     bool Timer::startTimer(TimerId timer_id, double period)
     {
-        if ( timer_id < 0 || timer_id > int(mtimers.size()) || period < 0.0)
+        if ( timer_id < 0 || timer_id >= int(mtimers.size()) || period < 0.0)
         {
             log(Error) << "Invalid timer id or period" << endlog();
             return false;
@@ -158,18 +307,22 @@ namespace RTT {
 
         Time due_time = mTimeserv->getNSecs() + Seconds_to_nsecs( period );
 
+        bool first;
         {
             MutexLock locker(m);
             mtimers[timer_id].first = due_time;
             mtimers[timer_id].second = Seconds_to_nsecs( period );
+            first = update( timer_id );
         }
-        msem.signal();
+        // only wake up the timer thread if its next wake up time changed.
+        if ( first )
+            msem.signal();
         return true;
     }
 
     bool Timer::arm(TimerId timer_id, double wait_time)
     {
-        if ( timer_id < 0 || timer_id > int(mtimers.size()) || wait_time < 0.0)
+        if ( timer_id < 0 || timer_id >= int(mtimers.size()) || wait_time < 0.0)
         {
             log(Error) << "Invalid timer id or wait time" << endlog();
             return false;
@@ -178,19 +331,23 @@ namespace RTT {
         Time now = mTimeserv->getNSecs();
         Time due_time = now + Seconds_to_nsecs( wait_time );
 
+        bool first;
         {
             MutexLock locker(m);
             mtimers[timer_id].first  = due_time;
             mtimers[timer_id].second = 0;
+            first = update( timer_id );
         }
-        msem.signal();
+        // only wake up the timer thread if its next wake up time changed.
+        if ( first )
+            msem.signal();
         return true;
     }
 
     bool Timer::isArmed(TimerId timer_id) const
     {
         MutexLock locker(m);
-        if (timer_id < 0 || timer_id > int(mtimers.size()) )
+        if (timer_id < 0 || timer_id >= int(mtimers.size()) )
         {
             log(Error) << "Invalid timer id" << endlog();
             return false;
@@ -201,7 +358,7 @@ namespace RTT {
     double Timer::timeRemaining(TimerId timer_id) const
     {
         MutexLock locker(m);
-        if (timer_id < 0 || timer_id > int(mtimers.size()) )
+        if (timer_id < 0 || timer_id >= int(mtimers.size()) )
         {
             log(Error) << "Invalid timer id" << endlog();
             return 0.0;
@@ -217,16 +374,48 @@ namespace RTT {
     bool Timer::killTimer(TimerId timer_id)
     {
         MutexLock locker(m);
-        if (timer_id < 0 || timer_id > int(mtimers.size()) )
+        if (timer_id < 0 || timer_id >= int(mtimers.size()) )
         {
             log(Error) << "Invalid timer id" << endlog();
             return false;
         }
         mtimers[timer_id].first = 0;
         mtimers[timer_id].second = 0;
+        update( timer_id );
         return true;
     }
 
+    Timer::Backend Timer::getBackend() const
+    {
+        return mbackend;
+    }
+
+    unsigned int Timer::getTimeoutCount() const
+    {
+        MutexLock locker(m);
+        return mtimeouts;
+    }
+
+    Seconds Timer::getMaxLateness() const
+    {
+        MutexLock locker(m);
+        return nsecs_to_Seconds( mlateness_max );
+    }
+
+    Seconds Timer::getMeanLateness() const
+    {
+        MutexLock locker(m);
+        if ( mtimeouts == 0 )
+            return 0.0;
+        return nsecs_to_Seconds( mlateness_total / mtimeouts );
+    }
 
+    void Timer::resetStatistics()
+    {
+        MutexLock locker(m);
+        mtimeouts = 0;
+        mlateness_max = 0;
+        mlateness_total = 0;
+    }
 
 }
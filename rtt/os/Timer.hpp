@@ -62,6 +62,16 @@ namespace RTT
      * If you do not attach an activity, the Timer will create a thread
      * of its own and start it. That thread will be stopped and cleaned up
      * when the Timer is destroyed.
+     *
+     * The Timer can find its next timeout by scanning all its timers
+     * (LinearScan) or by keeping the armed timers sorted on their
+     * expiry time (MinHeap). The latter is to be preferred when a large
+     * number of timers is used.
+     *
+     * Timeouts are kept in the time of the TimeService, so they follow
+     * its secondsChange() and enableSystemClock(). The timer thread only
+     * notices such a change when it wakes up for its next timeout, as it
+     * waits for that timeout on the clock of rtos_get_time_ns().
      */
     class RTT_API Timer
         : public base::RunnableInterface
@@ -71,6 +81,24 @@ namespace RTT
          * A positive numeric ID representing a timer.
          */
         typedef int TimerId;
+
+        /**
+         * The way a Timer looks up the timer that expires next.
+         */
+        enum Backend {
+            /**
+             * Scans all timers in each wake up and
+             * fires one timer per wake up. Arming is O(1), finding
+             * the next timer is O(n).
+             */
+            LinearScan,
+            /**
+             * Keeps the armed timers in a binary heap, indexed by timer id.
+             * Arming and firing a timer is O(log n), and all expired timers
+             * are fired in one wake up, in order of their expiry time.
+             */
+            MinHeap
+        };
     protected:
         TimeService* mTimeserv;
         base::ActivityInterface* mThread;
@@ -86,6 +114,31 @@ namespace RTT
         TimerIds mtimers;
         bool mdo_quit;
 
+        Backend mbackend;
+        /**
+         * MinHeap backend: The ids of the armed timers, the root
+         * of the heap is the timer which expires first.
+         */
+        std::vector<TimerId> mheap;
+        /**
+         * MinHeap backend: The position of each timer in mheap,
+         * or -1 if it is not armed.
+         */
+        std::vector<int> mheap_pos;
+        /**
+         * MinHeap backend: The timers which expired in the current wake up.
+         */
+        std::vector<TimerId> mexpired;
+        /**
+         * MinHeap backend: Storage for mexpired reserved by setMaxTimers(),
+         * which the timer thread takes over in its next wake up.
+         */
+        std::vector<TimerId> mexpired_spare;
+
+        unsigned int mtimeouts;
+        Time mlateness_max;
+        Time mlateness_total;
+
         bool initialize();
         void finalize();
         void step();
@@ -95,6 +148,29 @@ namespace RTT
 
         bool breakLoop();
 
+        /**
+         * Fires all expired timers of the MinHeap backend.
+         */
+        void fireExpired();
+
+        /**
+         * Updates the statistics for a timer that expired at \a due_time
+         * and times out at \a now.
+         */
+        void addTimeout(Time due_time, Time now);
+
+        /**
+         * Inserts, moves or removes \a timer_id in the heap of
+         * the MinHeap backend, according to its expiry time. Does
+         * nothing for the LinearScan backend.
+         * @return true if \a timer_id is the next timer to expire.
+         */
+        bool update(TimerId timer_id);
+        bool heapLess(int a, int b) const;
+        void heapSwap(int a, int b);
+        void heapUp(int pos);
+        void heapDown(int pos);
+
     public:
         /**
          * Create a timer object which can hold \a max_timers timers.
@@ -107,8 +183,9 @@ namespace RTT
          * @param scheduler The Orocos scheduler type for this timer. ORO_SCHED_OTHER or ORO_SCHED_RT or
          * -1 to attach your own thread.
          * @param priority The priority within the \a scheduler of this timer.
+         * @param backend The way this timer looks up the next timer to expire.
          */
-        Timer(TimerId max_timers, int scheduler = -1, int priority = 0);
+        Timer(TimerId max_timers, int scheduler = -1, int priority = 0, Backend backend = LinearScan);
 
         ~Timer();
 
@@ -163,6 +240,34 @@ namespace RTT
          */
         bool killTimer(TimerId timer_id);
 
+        /**
+         * Returns the way this timer looks up the next timer to expire.
+         */
+        Backend getBackend() const;
+
+        /**
+         * Returns the number of timeouts since the creation of
+         * this object or the last call to resetStatistics().
+         */
+        unsigned int getTimeoutCount() const;
+
+        /**
+         * Returns the largest delay between the expiry time of a timer
+         * and the call to timeout(), in seconds.
+         */
+        Seconds getMaxLateness() const;
+
+        /**
+         * Returns the average delay between the expiry time of a timer
+         * and the call to timeout(), in seconds.
+         */
+        Seconds getMeanLateness() const;
+
+        /**
+         * Clears the timeout count and lateness statistics.
+         */
+        void resetStatistics();
+
     };
 }}
 
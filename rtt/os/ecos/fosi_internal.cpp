@@ -174,6 +174,12 @@ namespace RTT
       return 0;
     }
 
+    INTERNAL_QUAL NANO_TIME rtos_task_get_period_mark( const RTOS_TASK* task )
+    {
+      // the wake up alarm does not expose its next trigger time.
+      return 0;
+    }
+
     INTERNAL_QUAL void rtos_task_delete(RTOS_TASK* mytask) {
       // Free name
       free(mytask->name);
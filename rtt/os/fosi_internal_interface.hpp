@@ -179,6 +179,16 @@ namespace RTT {
              */
             int rtos_task_wait_period( RTOS_TASK* task );
 
+            /**
+             * Returns the time at which the next call to rtos_task_wait_period()
+             * is programmed to wake up a periodic task.
+             * @param task The RTOS task to inspect.
+             * @return the wake up time in nano seconds, on the clock of
+             * rtos_get_time_ns(), or zero if the task is not periodic or if
+             * the RTOS does not expose it.
+             */
+            NANO_TIME rtos_task_get_period_mark( const RTOS_TASK* task );
+
             /**
              * This function must join the thread created with
              * rtos_task_create and then clean up the RTOS_TASK struct.
@@ -36,8 +36,50 @@
  ***************************************************************************/
 
 
-#include "fosi.h"
+#include "../fosi.h"
 
 
 
 
+
+#ifdef ORO_OS_GNULINUX_CLOCK_TSC
+#include <cpuid.h>
+
+#define ORO_TSC_SHIFT 24
+
+struct oro_tsc_calibration oro_tsc = { 1ULL << ORO_TSC_SHIFT, ORO_TSC_SHIFT, 0 };
+
+/**
+ * Measures the TSC frequency against CLOCK_MONOTONIC_RAW before any
+ * user code can read the time. Leaves oro_tsc untouched (identity
+ * conversion on CLOCK_MONOTONIC_RAW) if the TSC is not invariant.
+ */
+static void __attribute__((constructor)) oro_tsc_calibrate(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+    TIME_SPEC t0, t1, delay;
+    TICK_TIME c0, c1;
+    NANO_TIME ns;
+
+    if ( __get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 || eax < 0x80000007 )
+        return;
+    __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+    if ( (edx & (1u << 8)) == 0 )
+        return;
+
+    delay.tv_sec = 0;
+    delay.tv_nsec = 20000000;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &t0);
+    c0 = rtos_tsc_read();
+    while ( nanosleep(&delay, &delay) != 0 && errno == EINTR )
+        ;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &t1);
+    c1 = rtos_tsc_read();
+
+    ns = (t1.tv_sec - t0.tv_sec) * 1000000000LL + (t1.tv_nsec - t0.tv_nsec);
+    if ( ns <= 0 || c1 <= c0 )
+        return;
+    oro_tsc.mult = (unsigned long long)( ((unsigned __int128) ns << ORO_TSC_SHIFT) / (unsigned __int128)(c1 - c0) );
+    oro_tsc.usable = 1;
+}
+#endif
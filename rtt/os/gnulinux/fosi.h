@@ -87,8 +87,9 @@ extern "C"
 #define ORO_SCHED_OTHER SCHED_OTHER /** Linux normal scheduler */
 
 
-	// high-resolution time to timespec
-	// hrt is in ticks
+	// nanoseconds to timespec.
+	// This conversion predates the clock backends below and always takes
+	// nanoseconds, not TSC ticks.
 	static inline TIME_SPEC ticks2timespec(TICK_TIME hrt)
 	{
 		TIME_SPEC timevl;
@@ -97,11 +98,24 @@ extern "C"
 		return timevl;
 	}
 
+    /**
+     * The clock of rtos_get_time_ns() and of all absolute timeouts
+     * (periodic threads, condition variables, semaphores and mutexes).
+     * Absolute sleeps are only possible on CLOCK_REALTIME and
+     * CLOCK_MONOTONIC, so the MONOTONIC_RAW and TSC tick sources
+     * still wait on CLOCK_MONOTONIC.
+     */
+#ifdef ORO_OS_GNULINUX_CLOCK_REALTIME
+#define ORO_OS_GNULINUX_CLOCK_ID CLOCK_REALTIME
+#else
+#define ORO_OS_GNULINUX_CLOCK_ID CLOCK_MONOTONIC
+#endif
+
     static inline NANO_TIME rtos_get_time_ns( void )
     {
 
         TIME_SPEC tv;
-        clock_gettime(CLOCK_REALTIME, &tv);
+        clock_gettime(ORO_OS_GNULINUX_CLOCK_ID, &tv);
         // we can not include the C++ Time.hpp header !
 #ifdef __cplusplus
         return NANO_TIME( tv.tv_sec ) * 1000000000LL + NANO_TIME( tv.tv_nsec );
@@ -110,13 +124,55 @@ extern "C"
 #endif
     }
 
+#ifdef ORO_OS_GNULINUX_CLOCK_TSC
+#ifndef __x86_64__
+#error "OS_GNULINUX_CLOCK=TSC is only supported on x86_64 processors."
+#endif
+    /**
+     * Conversion from TSC ticks to nanoseconds: nsecs = (ticks * mult) >> shift.
+     * Calibrated against CLOCK_MONOTONIC_RAW when the library is loaded
+     * (see fosi.c). If the processor has no invariant TSC, \a usable is
+     * zero, ticks are read from CLOCK_MONOTONIC_RAW and the conversion is
+     * the identity.
+     */
+    struct oro_tsc_calibration {
+        unsigned long long mult;
+        unsigned int shift;
+        int usable;
+    };
+    extern struct oro_tsc_calibration oro_tsc;
+
+    static inline TICK_TIME rtos_tsc_read( void )
+    {
+        unsigned int lo, hi;
+        __asm__ __volatile__ ( "rdtsc" : "=a" (lo), "=d" (hi) );
+        return ( TICK_TIME ) ( ( ( unsigned long long ) hi << 32 ) | lo );
+    }
+#endif
+
     /**
-     * This function should return ticks,
-     * but we use ticks == nsecs in userspace
+     * Returns the ticks of the configured clock source. These are
+     * nanoseconds, except for the TSC source, which returns raw
+     * processor cycles. Use ticks2nano() to convert.
+     *
+     * With the MONOTONIC_RAW and TSC sources, the ticks follow
+     * CLOCK_MONOTONIC_RAW while rtos_get_time_ns() follows
+     * CLOCK_MONOTONIC, which NTP may slew. The two drift apart slowly,
+     * so only compare ticks with ticks.
      */
-    static inline NANO_TIME rtos_get_time_ticks()
+    static inline TICK_TIME rtos_get_time_ticks()
     {
+#if defined(ORO_OS_GNULINUX_CLOCK_TSC) || defined(ORO_OS_GNULINUX_CLOCK_MONOTONIC_RAW)
+        TIME_SPEC tv;
+#ifdef ORO_OS_GNULINUX_CLOCK_TSC
+        if ( oro_tsc.usable )
+            return rtos_tsc_read();
+#endif
+        clock_gettime(CLOCK_MONOTONIC_RAW, &tv);
+        return ( TICK_TIME ) tv.tv_sec * 1000000000LL + ( TICK_TIME ) tv.tv_nsec;
+#else
         return rtos_get_time_ns();
+#endif
     }
 
     static inline int rtos_nanosleep( const TIME_SPEC * rqtp, TIME_SPEC * rmtp )
@@ -126,20 +182,44 @@ extern "C"
     }
 
     /**
-     * No conversions are needed in userspace.
-     * The HBGenerator needs this for accurate timekeeping,
-     * which is an anachronism in userspace.
+     * Ticks are nanoseconds, unless the TSC clock source is
+     * selected. The HBGenerator needs this for accurate timekeeping.
      */
     static inline
     long long nano2ticks( long long nano )
     {
+#ifdef ORO_OS_GNULINUX_CLOCK_TSC
+        return ( long long ) ( ( ( __int128 ) nano << oro_tsc.shift ) / ( __int128 ) oro_tsc.mult );
+#else
         return nano;
+#endif
     }
 
     static inline
     long long ticks2nano( long long count )
     {
+#ifdef ORO_OS_GNULINUX_CLOCK_TSC
+        return ( long long ) ( ( ( __int128 ) count * ( __int128 ) oro_tsc.mult ) >> oro_tsc.shift );
+#else
         return count;
+#endif
+    }
+
+    /**
+     * sem_timedwait() and pthread_mutex_timedlock() only take
+     * CLOCK_REALTIME deadlines. This translates an absolute time of
+     * ORO_OS_GNULINUX_CLOCK_ID into that clock.
+     */
+    static inline TIME_SPEC rtos_abs_realtime( NANO_TIME abs_time )
+    {
+#ifndef ORO_OS_GNULINUX_CLOCK_REALTIME
+        TIME_SPEC now;
+        if ( abs_time != InfiniteNSecs ) {
+            clock_gettime(CLOCK_REALTIME, &now);
+            abs_time += ( ( NANO_TIME ) now.tv_sec * 1000000000LL + ( NANO_TIME ) now.tv_nsec ) - rtos_get_time_ns();
+        }
+#endif
+        return ticks2timespec( abs_time );
     }
 
 	typedef sem_t rt_sem_t;
@@ -193,7 +273,7 @@ extern "C"
 
     static inline int rtos_sem_wait_until(rt_sem_t* m, NANO_TIME abs_time )
     {
-        TIME_SPEC arg_time = ticks2timespec( abs_time );
+        TIME_SPEC arg_time = rtos_abs_realtime( abs_time );
         return sem_timedwait( m, &arg_time);
     }
 
@@ -245,13 +325,13 @@ extern "C"
 
     static inline int rtos_mutex_lock_until( rt_mutex_t* m, NANO_TIME abs_time)
     {
-        TIME_SPEC arg_time = ticks2timespec( abs_time );
+        TIME_SPEC arg_time = rtos_abs_realtime( abs_time );
         return pthread_mutex_timedlock(m, &arg_time);
     }
 
     static inline int rtos_mutex_rec_lock_until( rt_mutex_t* m, NANO_TIME abs_time)
     {
-        TIME_SPEC arg_time = ticks2timespec( abs_time );
+        TIME_SPEC arg_time = rtos_abs_realtime( abs_time );
         return pthread_mutex_timedlock(m, &arg_time);
     }
 
@@ -287,7 +367,14 @@ extern "C"
 
     static inline int rtos_cond_init(rt_cond_t *cond)
     {
-        return pthread_cond_init(cond, NULL);
+        pthread_condattr_t attr;
+        int ret;
+        pthread_condattr_init(&attr);
+        // timed waits take rtos_get_time_ns() deadlines.
+        pthread_condattr_setclock(&attr, ORO_OS_GNULINUX_CLOCK_ID);
+        ret = pthread_cond_init(cond, &attr);
+        pthread_condattr_destroy(&attr);
+        return ret;
     }
 
     static inline int rtos_cond_destroy(rt_cond_t *cond)
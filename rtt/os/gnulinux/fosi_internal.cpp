@@ -225,7 +225,7 @@ namespace RTT
 	    // set period
 	    mytask->period = nanosecs;
 	    // set next wake-up time.
-	    mytask->periodMark = ticks2timespec( nano2ticks( rtos_get_time_ns() + nanosecs ) );
+	    mytask->periodMark = ticks2timespec( rtos_get_time_ns() + nanosecs );
 	}
 
 	INTERNAL_QUAL void rtos_task_set_period( RTOS_TASK* mytask, NANO_TIME nanosecs )
@@ -248,7 +248,7 @@ namespace RTT
 	    NANO_TIME wake= task->periodMark.tv_sec * 1000000000LL + task->periodMark.tv_nsec;
 
         // inspired by nanosleep man page for this construct:
-        while ( clock_nanosleep(CLOCK_REALTIME, TIMER_ABSTIME, &(task->periodMark), NULL) != 0 && errno == EINTR ) {
+        while ( clock_nanosleep(ORO_OS_GNULINUX_CLOCK_ID, TIMER_ABSTIME, &(task->periodMark), NULL) != 0 && errno == EINTR ) {
             errno = 0;
         }
 
@@ -256,7 +256,7 @@ namespace RTT
         {
           // program next period:
           // 1. convert period to timespec
-          TIME_SPEC ts = ticks2timespec( nano2ticks( task->period) );
+          TIME_SPEC ts = ticks2timespec( task->period );
           // 2. Add ts to periodMark (danger: tn guards for overflows!)
           NANO_TIME tn = (task->periodMark.tv_nsec + ts.tv_nsec);
           task->periodMark.tv_nsec = tn % 1000000000LL;
@@ -264,7 +264,7 @@ namespace RTT
         }
         else
         {
-          TIME_SPEC ts = ticks2timespec( nano2ticks( task->period) );
+          TIME_SPEC ts = ticks2timespec( task->period );
           TIME_SPEC now = ticks2timespec( rtos_get_time_ns() );
           NANO_TIME tn = (now.tv_nsec + ts.tv_nsec);
           task->periodMark.tv_nsec = tn % 1000000000LL;
@@ -274,6 +274,13 @@ namespace RTT
 	    return now > wake ? -1 : 0;
 	}
 
+	INTERNAL_QUAL NANO_TIME rtos_task_get_period_mark( const RTOS_TASK* task )
+	{
+	    if ( task->period == 0 )
+            return 0;
+	    return task->periodMark.tv_sec * 1000000000LL + task->periodMark.tv_nsec;
+	}
+
 	INTERNAL_QUAL void rtos_task_delete(RTOS_TASK* mytask) {
         pthread_join( mytask->thread, 0);
         pthread_attr_destroy( &(mytask->attr) );
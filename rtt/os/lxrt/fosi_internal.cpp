@@ -335,6 +335,12 @@ namespace RTT
             return 0;
         }
 
+        INTERNAL_QUAL NANO_TIME rtos_task_get_period_mark( const RTOS_TASK* mytask )
+        {
+            // the periodic timeline is kept by the RTAI kernel.
+            return 0;
+        }
+
         INTERNAL_QUAL void rtos_task_delete(RTOS_TASK* mytask) {
             if ( pthread_join((mytask->thread),0) != 0 )
                 Logger::log() << Logger::Critical << "Failed to join "<< mytask->name <<"."<< Logger::endl;
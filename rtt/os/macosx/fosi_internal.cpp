@@ -199,6 +199,11 @@ namespace RTT
 	    return -1;
 	}
 
+	INTERNAL_QUAL NANO_TIME rtos_task_get_period_mark( const RTOS_TASK* task )
+	{
+	    return task->period == 0 ? 0 : task->periodMark;
+	}
+
 	INTERNAL_QUAL void rtos_task_delete(RTOS_TASK* mytask)
 	{
             pthread_join( mytask->thread, 0);
@@ -16,10 +16,12 @@ namespace RTT {
         class StartStopManager;
         class Thread;
         class ThreadInterface;
+        class TimeHistogram;
         class TimeService;
         class Timer;
         struct CleanupFunction;
         struct InitFunction;
+        struct ThreadStatistics;
     }
     namespace detail {
         using namespace os;
@@ -260,6 +260,11 @@ void ErrorHandler(LPTSTR lpszFunction)
       return 0;
     }
 
+    INTERNAL_QUAL NANO_TIME rtos_task_get_period_mark( const RTOS_TASK* task )
+    {
+      return task->period == 0 ? 0 : task->periodMark;
+    }
+
     INTERNAL_QUAL void rtos_task_delete(RTOS_TASK* mytask) {
       // printf("T:%u -> ", (unsigned int) mytask);
       //printf(" rtos_task_delete ");
@@ -415,6 +415,12 @@ namespace RTT
             return 0;
         }
 
+        INTERNAL_QUAL NANO_TIME rtos_task_get_period_mark( const RTOS_TASK* mytask )
+        {
+            // the periodic timeline is kept by the Xenomai kernel.
+            return 0;
+        }
+
         INTERNAL_QUAL int rtos_task_set_cpu_affinity(RTOS_TASK * task, unsigned cpu_affinity)
         {
             log(Error) << "rtos_task_set_cpu_affinity: Xenomai tasks don't allow to migrate to another CPU once created." << endlog();
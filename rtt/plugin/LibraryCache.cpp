@@ -0,0 +1,177 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  LibraryCache.cpp
+
+                        LibraryCache.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "LibraryCache.hpp"
+#include "../Logger.hpp"
+#include "../os/MutexLock.hpp"
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <sstream>
+
+using namespace RTT;
+using namespace RTT::plugin;
+using namespace std;
+
+namespace {
+    const char* const cache_header = "# RTT library cache 1";
+    const char* const kind_names[] = { "none", "plugin", "typekit", "component" };
+}
+
+static LibraryCache::shared_ptr instance2;
+
+LibraryCache::LibraryCache() : dirty(false) {}
+LibraryCache::~LibraryCache() {}
+
+LibraryCache::shared_ptr LibraryCache::Instance() {
+    if (!instance2)
+        instance2.reset( new LibraryCache() );
+    return instance2;
+}
+
+void LibraryCache::Release() {
+    if (instance2)
+        instance2->save();
+    instance2.reset();
+}
+
+long LibraryCache::modificationTime(std::string const& filename) {
+    try {
+        return boost::filesystem::last_write_time( boost::filesystem::path(filename) );
+    } catch (std::exception&) {
+        return 0;
+    }
+}
+
+bool LibraryCache::setCacheFile(std::string const& file) {
+    os::MutexLock lock_it( lock );
+    entries.clear();
+    dirty = false;
+    cache_file = file;
+    if ( file.empty() )
+        return true;
+
+    ifstream in( file.c_str() );
+    if ( !in ) {
+        log(Info) << "Library cache '" << file << "' does not exist yet: it will be created." <<endlog();
+        return true;
+    }
+    string line;
+    if ( !getline(in, line) || line != cache_header ) {
+        log(Warning) << "Ignoring library cache '" << file << "': unknown format." <<endlog();
+        dirty = true;
+        return false;
+    }
+    // each line is: path <tab> mtime <tab> kind [<tab> name]*
+    while ( getline(in, line) ) {
+        vector<string> fields;
+        string::size_type start = 0, pos;
+        while ( (pos = line.find('\t', start)) != string::npos ) {
+            fields.push_back( line.substr(start, pos - start) );
+            start = pos + 1;
+        }
+        fields.push_back( line.substr(start) );
+        if ( fields.size() < 3 )
+            continue;
+        Entry entry;
+        istringstream( fields[1] ) >> entry.mtime;
+        for (int k = None; k <= Component; ++k)
+            if ( fields[2] == kind_names[k] )
+                entry.kind = Kind(k);
+        entry.names.assign( fields.begin() + 3, fields.end() );
+        entries[ fields[0] ] = entry;
+    }
+    log(Info) << "Read " << entries.size() << " entries from library cache '" << file << "'." <<endlog();
+    return true;
+}
+
+std::string LibraryCache::getCacheFile() const {
+    os::MutexLock lock_it( lock );
+    return cache_file;
+}
+
+bool LibraryCache::isEnabled() const {
+    os::MutexLock lock_it( lock );
+    return !cache_file.empty();
+}
+
+bool LibraryCache::save() {
+    os::MutexLock lock_it( lock );
+    if ( cache_file.empty() || !dirty )
+        return true;
+    ofstream out( cache_file.c_str() );
+    if ( !out ) {
+        log(Error) << "Could not write library cache '" << cache_file << "'." <<endlog();
+        return false;
+    }
+    out << cache_header << '\n';
+    for (Entries::const_iterator it = entries.begin(); it != entries.end(); ++it) {
+        out << it->first << '\t' << it->second.mtime << '\t' << kind_names[ it->second.kind ];
+        for (vector<string>::const_iterator n = it->second.names.begin(); n != it->second.names.end(); ++n)
+            out << '\t' << *n;
+        out << '\n';
+    }
+    dirty = false;
+    return true;
+}
+
+bool LibraryCache::lookup(std::string const& filename, Entry& entry) const {
+    os::MutexLock lock_it( lock );
+    if ( cache_file.empty() )
+        return false;
+    Entries::const_iterator it = entries.find( filename );
+    if ( it == entries.end() || it->second.mtime != modificationTime( filename ) )
+        return false;
+    entry = it->second;
+    return true;
+}
+
+void LibraryCache::insert(std::string const& filename, Kind kind, std::vector<std::string> const& names) {
+    os::MutexLock lock_it( lock );
+    if ( cache_file.empty() )
+        return;
+    Entry& entry = entries[ filename ];
+    entry.mtime = modificationTime( filename );
+    entry.kind = kind;
+    entry.names = names;
+    dirty = true;
+}
+
+void LibraryCache::clear() {
+    os::MutexLock lock_it( lock );
+    entries.clear();
+    dirty = true;
+}
@@ -0,0 +1,165 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  LibraryCache.hpp
+
+                        LibraryCache.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_LIBRARYCACHE_HPP_
+#define ORO_LIBRARYCACHE_HPP_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <boost/shared_ptr.hpp>
+
+#include "../rtt-config.h"
+#include "../os/Mutex.hpp"
+
+namespace RTT {
+    namespace plugin {
+        /**
+         * An on-disk index of the libraries found by the PluginLoader and
+         * the ComponentLoader. For each library file, it records its
+         * modification time, what kind of library it is and the plugin
+         * name or component types it provides. A library of which the
+         * modification time changed is scanned again.
+         *
+         * The cache is disabled until setCacheFile() is called. The RTT
+         * startup code does so with the contents of the RTT_COMPONENT_CACHE
+         * variable, if set. The cache is written back by save() and
+         * when the process terminates.
+         *
+         * With the cache enabled, the ComponentLoader no longer opens each
+         * component library during an import, but only when a component of
+         * one of its types is created. Libraries which turned out not to be
+         * a plugin are no longer opened by the PluginLoader.
+         */
+        class RTT_API LibraryCache
+        {
+        public:
+            /**
+             * The kind of an indexed library.
+             */
+            enum Kind { None, Plugin, Typekit, Component };
+
+            /**
+             * What is known about one library file.
+             */
+            struct Entry {
+                Entry() : mtime(0), kind(None) {}
+                /**
+                 * Modification time of the file when it was indexed.
+                 */
+                long mtime;
+                Kind kind;
+                /**
+                 * The advertised plugin name or the component types.
+                 */
+                std::vector<std::string> names;
+            };
+
+            typedef boost::shared_ptr<LibraryCache> shared_ptr;
+
+            LibraryCache();
+            ~LibraryCache();
+
+            /**
+             * Returns the process wide cache.
+             * @return A singleton.
+             */
+            static shared_ptr Instance();
+
+            /**
+             * Saves the cache and releases the singleton.
+             */
+            static void Release();
+
+            /**
+             * Enables the cache and reads the entries stored in \a file.
+             * A missing file is not an error, it is created by save().
+             * @param file The cache file, or the empty string to disable the cache.
+             * @return false if \a file exists but could not be read.
+             */
+            bool setCacheFile(std::string const& file);
+
+            /**
+             * Returns the file set by setCacheFile().
+             */
+            std::string getCacheFile() const;
+
+            /**
+             * Returns true if a cache file was set.
+             */
+            bool isEnabled() const;
+
+            /**
+             * Writes the cache to the cache file if it was modified.
+             * @return false if the file could not be written.
+             */
+            bool save();
+
+            /**
+             * Looks up the entry of a library.
+             * @param filename The full path of the library.
+             * @param entry Is filled in when the entry was found.
+             * @return false if the cache is disabled, if \a filename was
+             * not indexed yet or if it was modified since.
+             */
+            bool lookup(std::string const& filename, Entry& entry) const;
+
+            /**
+             * Stores what was found about a library.
+             * @param filename The full path of the library.
+             * @param kind What kind of library it is.
+             * @param names The plugin name or the component types it provides.
+             */
+            void insert(std::string const& filename, Kind kind, std::vector<std::string> const& names = std::vector<std::string>() );
+
+            /**
+             * Forgets all entries. The cache file is rewritten by the next save().
+             */
+            void clear();
+        private:
+            typedef std::map<std::string, Entry> Entries;
+            Entries entries;
+            std::string cache_file;
+            bool dirty;
+            mutable os::Mutex lock;
+
+            static long modificationTime(std::string const& filename);
+        };
+    }
+}
+
+#endif /* ORO_LIBRARYCACHE_HPP_ */
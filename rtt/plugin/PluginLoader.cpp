@@ -44,6 +44,7 @@
  */
 
 #include "PluginLoader.hpp"
+#include "LibraryCache.hpp"
 #include "../TaskContext.hpp"
 #include "../Logger.hpp"
 #include <boost/filesystem.hpp>
@@ -293,6 +294,12 @@ namespace {
             removeDuplicates( plugin_paths );
             log(Info) <<"No RTT_COMPONENT_PATH set. Using default: " << plugin_paths <<endlog();
         }
+        // read the library cache before the first library is scanned.
+        char* cache = getenv("RTT_COMPONENT_CACHE");
+        if (cache && *cache) {
+            log(Info) <<"RTT_COMPONENT_CACHE was set to: " << cache << endlog();
+            LibraryCache::Instance()->setCacheFile(cache);
+        }
         // we set the plugin path such that we can search for sub-directories/projects lateron
         PluginLoader::Instance()->setPluginPath(plugin_paths);
         // we load the plugins/typekits which are in each plugin path directory (but not subdirectories).
@@ -311,6 +318,7 @@ namespace {
     void unloadPlugins()
     {
         PluginLoader::Release();
+        LibraryCache::Release();
     }
 
     os::CleanupFunction plugin_unloader( &unloadPlugins );
@@ -434,10 +442,16 @@ bool PluginLoader::loadPluginsInternal( std::string const& path_list, std::strin
 #else
                     libname = itr->path().filename();
 #endif
+                    LibraryCache::Entry entry;
                     if(!isCompatiblePlugin(libname))
                     {
                         log(Debug) << "not a compatible plugin: ignored."<<endlog();
                     }
+                    else if ( LibraryCache::Instance()->lookup( itr->path().string(), entry )
+                              && entry.kind != LibraryCache::Plugin && entry.kind != LibraryCache::Typekit )
+                    {
+                        log(Debug) << "not a plugin according to the library cache: ignored."<<endlog();
+                    }
                     else
                     {
                         found = true;
@@ -735,10 +749,14 @@ bool PluginLoader::loadInProcess(string file, string shortname, string kind, boo
             }
         }
         loadedLibs.push_back(loading_lib);
+        LibraryCache::Instance()->insert( file, loading_lib.is_typekit ? LibraryCache::Typekit : LibraryCache::Plugin,
+                                          vector<string>(1, plugname) );
         return true;
     } else {
         if (log_error)
             log(Error) <<"Not a plugin: " << error << endlog();
+        // remember, such that it is not opened again.
+        LibraryCache::Instance()->insert( file, LibraryCache::None );
     }
     dlclose(handle);
     return false;
@@ -0,0 +1,484 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  ExpressionCompiler.cpp
+
+                        ExpressionCompiler.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "ExpressionCompiler.hpp"
+#include "../internal/DataSources.hpp"
+#include "../internal/mystd.hpp"
+#include <boost/shared_ptr.hpp>
+#include <functional>
+#include <typeinfo>
+#include <vector>
+
+namespace RTT
+{ namespace scripting {
+
+    using namespace internal;
+    using base::DataSourceBase;
+
+    namespace {
+        enum Type { Bool, Int, UInt, Float, Double, NTypes };
+        enum Op { Load, Copy, Neg, Not, Add, Sub, Mul, Div, Mod, Lt, Le, Gt, Ge, Eq, Ne, And, Or };
+
+        /**
+         * The instruction code combines the operation and the type of its arguments.
+         */
+#define ORO_OPC(op, type) ((op) * NTypes + (type))
+
+        union Reg {
+            bool b;
+            int i;
+            unsigned int u;
+            float f;
+            double d;
+        };
+
+        /**
+         * An instruction writes register \a d. \a a and \a b are the
+         * registers of the arguments, or the index of the leaf for Load.
+         * Copy is only used by a CompiledDataSource, to read a variable
+         * into \a d.
+         */
+        struct Instr {
+            unsigned short code, d, a, b;
+        };
+
+        /**
+         * A register which holds a constant of the expression.
+         */
+        struct ConstReg {
+            unsigned short reg;
+            Reg value;
+        };
+
+        template<class T> struct TypeOf;
+        template<> struct TypeOf<bool> { enum { value = Bool }; static bool& reg(Reg& r) { return r.b; } };
+        template<> struct TypeOf<int> { enum { value = Int }; static int& reg(Reg& r) { return r.i; } };
+        template<> struct TypeOf<unsigned int> { enum { value = UInt }; static unsigned int& reg(Reg& r) { return r.u; } };
+        template<> struct TypeOf<float> { enum { value = Float }; static float& reg(Reg& r) { return r.f; } };
+        template<> struct TypeOf<double> { enum { value = Double }; static double& reg(Reg& r) { return r.d; } };
+
+        /**
+         * The instructions and constants of a compiled expression, which are
+         * shared by its copies.
+         */
+        struct Program {
+            std::vector<Instr> code;
+            std::vector<ConstReg> consts;
+            unsigned int nregs;
+            unsigned int result;
+            Program() : nregs(0), result(0) {}
+        };
+
+        /**
+         * Resolves a leaf to the DataSource<T> to load it from, and, if
+         * it is a plain variable, to the address of its value, which can
+         * be read without calling get().
+         */
+        template<class T>
+        void resolve( DataSourceBase* ds, const void*& direct, const void*& source )
+        {
+            source = static_cast<const DataSource<T>*>( ds );
+            if ( typeid(*ds) == typeid(ValueDataSource<T>) || typeid(*ds) == typeid(UnboundDataSource< ValueDataSource<T> >) )
+                direct = &static_cast<ValueDataSource<T>*>( ds )->rvalue();
+        }
+
+        /**
+         * An instruction of a CompiledDataSource, with its operands resolved
+         * to the registers or variables it reads. For Load, \a a is the leaf.
+         */
+        struct Step {
+            unsigned int code;
+            void* d;
+            const void* a;
+            const void* b;
+        };
+
+#define ORO_ARG(CT, p) (*static_cast<const CT*>( c->p ))
+#define ORO_RES(CT) (*static_cast<CT*>( c->d ))
+#define ORO_LOAD(T, CT) \
+        case ORO_OPC(Load, T): ORO_RES(CT) = static_cast<const DataSource<CT>*>( c->a )->get(); break;
+#define ORO_COPY(T, CT) \
+        case ORO_OPC(Copy, T): ORO_RES(CT) = ORO_ARG(CT, a); break;
+#define ORO_COMPARE(T, CT) \
+        case ORO_OPC(Eq, T): ORO_RES(bool) = ORO_ARG(CT, a) == ORO_ARG(CT, b); break; \
+        case ORO_OPC(Ne, T): ORO_RES(bool) = ORO_ARG(CT, a) != ORO_ARG(CT, b); break;
+#define ORO_ORDER(T, CT) \
+        case ORO_OPC(Lt, T): ORO_RES(bool) = ORO_ARG(CT, a) <  ORO_ARG(CT, b); break; \
+        case ORO_OPC(Le, T): ORO_RES(bool) = ORO_ARG(CT, a) <= ORO_ARG(CT, b); break; \
+        case ORO_OPC(Gt, T): ORO_RES(bool) = ORO_ARG(CT, a) >  ORO_ARG(CT, b); break; \
+        case ORO_OPC(Ge, T): ORO_RES(bool) = ORO_ARG(CT, a) >= ORO_ARG(CT, b); break;
+#define ORO_ARITH(T, CT) \
+        case ORO_OPC(Neg, T): ORO_RES(CT) = - ORO_ARG(CT, a); break; \
+        case ORO_OPC(Add, T): ORO_RES(CT) = ORO_ARG(CT, a) + ORO_ARG(CT, b); break; \
+        case ORO_OPC(Sub, T): ORO_RES(CT) = ORO_ARG(CT, a) - ORO_ARG(CT, b); break; \
+        case ORO_OPC(Mul, T): ORO_RES(CT) = ORO_ARG(CT, a) * ORO_ARG(CT, b); break;
+
+        /**
+         * The interpreter loop.
+         */
+        void run( const Step* c, const Step* end )
+        {
+            for ( ; c != end; ++c ) {
+                switch ( c->code ) {
+                ORO_LOAD(Bool, bool)
+                ORO_LOAD(Int, int)
+                ORO_LOAD(UInt, unsigned int)
+                ORO_LOAD(Float, float)
+                ORO_LOAD(Double, double)
+                ORO_COPY(Bool, bool)
+                ORO_COPY(Int, int)
+                ORO_COPY(UInt, unsigned int)
+                ORO_COPY(Float, float)
+                ORO_COPY(Double, double)
+                case ORO_OPC(Not, Bool): ORO_RES(bool) = !ORO_ARG(bool, a); break;
+                case ORO_OPC(And, Bool): ORO_RES(bool) = ORO_ARG(bool, a) && ORO_ARG(bool, b); break;
+                case ORO_OPC(Or, Bool):  ORO_RES(bool) = ORO_ARG(bool, a) || ORO_ARG(bool, b); break;
+                ORO_COMPARE(Bool, bool)
+                ORO_COMPARE(Int, int)
+                ORO_COMPARE(UInt, unsigned int)
+                ORO_COMPARE(Float, float)
+                ORO_COMPARE(Double, double)
+                ORO_ORDER(Int, int)
+                ORO_ORDER(UInt, unsigned int)
+                ORO_ORDER(Float, float)
+                ORO_ORDER(Double, double)
+                ORO_ARITH(Int, int)
+                ORO_ARITH(UInt, unsigned int)
+                ORO_ARITH(Float, float)
+                ORO_ARITH(Double, double)
+                // same as divides3<int,int,int>: propagate zero.
+                case ORO_OPC(Div, Int):  ORO_RES(int) = ORO_ARG(int, b) == 0 ? 0 : ORO_ARG(int, a) / ORO_ARG(int, b); break;
+                case ORO_OPC(Div, UInt): ORO_RES(unsigned int) = ORO_ARG(unsigned int, a) / ORO_ARG(unsigned int, b); break;
+                case ORO_OPC(Div, Float): ORO_RES(float) = ORO_ARG(float, a) / ORO_ARG(float, b); break;
+                case ORO_OPC(Div, Double): ORO_RES(double) = ORO_ARG(double, a) / ORO_ARG(double, b); break;
+                case ORO_OPC(Mod, Int):  ORO_RES(int) = ORO_ARG(int, a) % ORO_ARG(int, b); break;
+                case ORO_OPC(Mod, UInt): ORO_RES(unsigned int) = ORO_ARG(unsigned int, a) % ORO_ARG(unsigned int, b); break;
+                default:
+                    assert( false && "ExpressionCompiler: unknown instruction" );
+                }
+            }
+        }
+
+        /**
+         * The DataSource which evaluates a compiled expression. It resolves
+         * the shared Program to its own registers and leaves, such that plain
+         * variables are read in place instead of being loaded. A variable
+         * which is followed by a leaf that is loaded with get() is copied
+         * instead, since that leaf may assign it: the tree evaluation reads
+         * it before the leaf.
+         */
+        template<class T>
+        class CompiledDataSource
+            : public DataSource<T>
+        {
+            boost::shared_ptr<Program> prog;
+            std::vector<DataSourceBase::shared_ptr> leaves;
+            mutable std::vector<Reg> regs;
+            std::vector<Step> steps;
+            mutable T mdata;
+        public:
+            CompiledDataSource( boost::shared_ptr<Program> p, std::vector<DataSourceBase::shared_ptr> const& l )
+                : prog(p), leaves(l), regs( p->nregs ), mdata()
+            {
+                std::vector<const void*> where( regs.size() );
+                for ( std::size_t i = 0; i != regs.size(); ++i )
+                    where[i] = &regs[i];
+                for ( std::size_t i = 0; i != prog->consts.size(); ++i )
+                    regs[ prog->consts[i].reg ] = prog->consts[i].value;
+                // plain variables are not loaded, their address is used instead,
+                // unless a later leaf is loaded with get().
+                std::vector<const void*> source( prog->code.size() );
+                std::vector<bool> copied( prog->code.size() );
+                bool called = false;
+                for ( std::size_t i = prog->code.size(); i-- != 0; ) {
+                    const Instr& c = prog->code[i];
+                    if ( c.code / NTypes != Load )
+                        continue;
+                    DataSourceBase* leaf = leaves[c.a].get();
+                    const void* direct = 0;
+                    switch ( c.code % NTypes ) {
+                    case Bool:   resolve<bool>( leaf, direct, source[i] ); break;
+                    case Int:    resolve<int>( leaf, direct, source[i] ); break;
+                    case UInt:   resolve<unsigned int>( leaf, direct, source[i] ); break;
+                    case Float:  resolve<float>( leaf, direct, source[i] ); break;
+                    case Double: resolve<double>( leaf, direct, source[i] ); break;
+                    }
+                    if ( !direct ) {
+                        called = true;
+                    } else if ( called ) {
+                        source[i] = direct;
+                        copied[i] = true;
+                    } else {
+                        where[c.d] = direct;
+                        source[i] = 0;
+                    }
+                }
+                for ( std::size_t i = 0; i != prog->code.size(); ++i ) {
+                    const Instr& c = prog->code[i];
+                    Step s;
+                    s.code = c.code;
+                    s.d = &regs[c.d];
+                    if ( c.code / NTypes == Load ) {
+                        if ( !source[i] )
+                            continue;
+                        if ( copied[i] )
+                            s.code = ORO_OPC(Copy, c.code % NTypes);
+                        s.a = source[i];
+                        s.b = 0;
+                    } else {
+                        s.a = where[c.a];
+                        s.b = where[c.b];
+                    }
+                    steps.push_back( s );
+                }
+            }
+
+            T get() const
+            {
+                run( &steps[0], &steps[0] + steps.size() );
+                return mdata = TypeOf<T>::reg( regs[prog->result] );
+            }
+
+            T value() const
+            {
+                return mdata;
+            }
+
+            typename DataSource<T>::const_reference_t rvalue() const
+            {
+                return mdata;
+            }
+
+            void reset()
+            {
+                for ( std::size_t i = 0; i != leaves.size(); ++i )
+                    leaves[i]->reset();
+            }
+
+            CompiledDataSource<T>* clone() const
+            {
+                return new CompiledDataSource<T>( prog, leaves );
+            }
+
+            CompiledDataSource<T>* copy( std::map<const DataSourceBase*, DataSourceBase*>& alreadyCloned ) const
+            {
+                std::vector<DataSourceBase::shared_ptr> copies( leaves.size() );
+                for ( std::size_t i = 0; i != leaves.size(); ++i )
+                    copies[i] = leaves[i]->copy( alreadyCloned );
+                return new CompiledDataSource<T>( prog, copies );
+            }
+        };
+
+        template<class T> struct Arith;
+
+        /**
+         * Translates an expression tree into a Program.
+         */
+        class Builder
+        {
+        public:
+            Program& prog;
+            std::vector<DataSourceBase::shared_ptr> leaves;
+            unsigned int operators;
+            bool overflow;
+
+            Builder( Program& p ) : prog(p), operators(0), overflow(false) {}
+
+            int allocate()
+            {
+                if ( prog.nregs >= 0xffff || prog.code.size() >= 0xffff ) {
+                    overflow = true;
+                    return 0;
+                }
+                return prog.nregs++;
+            }
+
+            int emit( int op, int type, int a, int b = 0 )
+            {
+                Instr c;
+                c.code = ORO_OPC(op, type);
+                c.d = allocate();
+                c.a = a;
+                c.b = b;
+                prog.code.push_back( c );
+                return c.d;
+            }
+
+            template<class T>
+            int leaf( DataSourceBase* ds )
+            {
+                // constants are stored in their register when the expression is created.
+                ConstantDataSource<T>* k = dynamic_cast<ConstantDataSource<T>*>( ds );
+                if ( k ) {
+                    ConstReg c;
+                    c.reg = allocate();
+                    TypeOf<T>::reg( c.value ) = k->rvalue();
+                    prog.consts.push_back( c );
+                    return c.reg;
+                }
+                leaves.push_back( ds );
+                return emit( Load, TypeOf<T>::value, leaves.size() - 1 );
+            }
+
+            template<class F, class A>
+            bool unary( DataSourceBase* ds, Op op, int& reg )
+            {
+                UnaryDataSource<F>* n = dynamic_cast<UnaryDataSource<F>*>( ds );
+                if ( !n )
+                    return false;
+                int a = build<A>( n->getArgument().get() );
+                reg = emit( op, TypeOf<A>::value, a );
+                ++operators;
+                return true;
+            }
+
+            template<class F, class A>
+            bool binary( DataSourceBase* ds, Op op, int& reg )
+            {
+                BinaryDataSource<F>* n = dynamic_cast<BinaryDataSource<F>*>( ds );
+                if ( !n )
+                    return false;
+                int a = build<A>( n->getFirst().get() );
+                int b = build<A>( n->getSecond().get() );
+                reg = emit( op, TypeOf<A>::value, a, b );
+                ++operators;
+                return true;
+            }
+
+            template<class A>
+            bool compare( DataSourceBase* ds, int& reg )
+            {
+                return binary< std::equal_to<A>, A >( ds, Eq, reg )
+                    || binary< std::not_equal_to<A>, A >( ds, Ne, reg )
+                    || binary< std::less<A>, A >( ds, Lt, reg )
+                    || binary< std::less_equal<A>, A >( ds, Le, reg )
+                    || binary< std::greater<A>, A >( ds, Gt, reg )
+                    || binary< std::greater_equal<A>, A >( ds, Ge, reg );
+            }
+
+            template<class T>
+            int build( DataSourceBase* ds );
+        };
+
+        template<>
+        bool Builder::compare<bool>( DataSourceBase* ds, int& reg )
+        {
+            return binary< std::equal_to<bool>, bool >( ds, Eq, reg )
+                || binary< std::not_equal_to<bool>, bool >( ds, Ne, reg );
+        }
+
+        template<>
+        int Builder::build<bool>( DataSourceBase* ds )
+        {
+            int reg;
+            if ( unary< std::logical_not<bool>, bool >( ds, Not, reg )
+                 || binary< std::logical_and<bool>, bool >( ds, And, reg )
+                 || binary< std::logical_or<bool>, bool >( ds, Or, reg )
+                 || compare<bool>( ds, reg )
+                 || compare<int>( ds, reg )
+                 || compare<unsigned int>( ds, reg )
+                 || compare<float>( ds, reg )
+                 || compare<double>( ds, reg ) )
+                return reg;
+            return leaf<bool>( ds );
+        }
+
+        template<class T>
+        int Builder::build( DataSourceBase* ds )
+        {
+            int reg;
+            // identity is a nop.
+            UnaryDataSource< identity<T> >* id = dynamic_cast<UnaryDataSource< identity<T> >*>( ds );
+            if ( id )
+                return build<T>( id->getArgument().get() );
+            if ( unary< std::negate<T>, T >( ds, Neg, reg )
+                 || binary< std::plus<T>, T >( ds, Add, reg )
+                 || binary< std::minus<T>, T >( ds, Sub, reg )
+                 || binary< std::multiplies<T>, T >( ds, Mul, reg )
+                 || Arith<T>::divide( *this, ds, reg ) )
+                return reg;
+            return leaf<T>( ds );
+        }
+
+        /**
+         * The division and modulo operators differ per type.
+         */
+        template<class T> struct Arith {
+            static bool divide( Builder& b, DataSourceBase* ds, int& reg ) {
+                return b.binary< divides3<T,T,T>, T >( ds, Div, reg )
+                    || b.binary< std::modulus<T>, T >( ds, Mod, reg );
+            }
+        };
+        template<> struct Arith<float> {
+            static bool divide( Builder& b, DataSourceBase* ds, int& reg ) {
+                return b.binary< std::divides<float>, float >( ds, Div, reg );
+            }
+        };
+        template<> struct Arith<double> {
+            static bool divide( Builder& b, DataSourceBase* ds, int& reg ) {
+                return b.binary< std::divides<double>, double >( ds, Div, reg );
+            }
+        };
+
+        template<class T>
+        DataSourceBase::shared_ptr compileAs( DataSourceBase::shared_ptr expr )
+        {
+            DataSource<T>* ds = dynamic_cast<DataSource<T>*>( expr.get() );
+            if ( !ds )
+                return 0;
+            boost::shared_ptr<Program> prog( new Program() );
+            Builder builder( *prog );
+            prog->result = builder.build<T>( ds );
+            if ( builder.operators == 0 || builder.overflow )
+                return expr;
+            return new CompiledDataSource<T>( prog, builder.leaves );
+        }
+    }
+
+    DataSourceBase::shared_ptr ExpressionCompiler::compile( DataSourceBase::shared_ptr expr )
+    {
+        DataSourceBase::shared_ptr ret;
+        if ( !expr )
+            return expr;
+        if ( (ret = compileAs<bool>( expr )) || (ret = compileAs<int>( expr ))
+             || (ret = compileAs<unsigned int>( expr )) || (ret = compileAs<float>( expr ))
+             || (ret = compileAs<double>( expr )) )
+            return ret;
+        return expr;
+    }
+}}
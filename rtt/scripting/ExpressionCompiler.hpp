@@ -0,0 +1,74 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  ExpressionCompiler.hpp
+
+                        ExpressionCompiler.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_EXPRESSIONCOMPILER_HPP
+#define ORO_EXPRESSIONCOMPILER_HPP
+
+#include "rtt-scripting-config.h"
+#include "../base/DataSourceBase.hpp"
+
+namespace RTT
+{ namespace scripting {
+
+    /**
+     * Flattens the expression trees built by the ExpressionParser.
+     *
+     * The operators of the RealTimeTypekit on bool, int, unsigned int,
+     * float and double are built as a tree of BinaryDataSource and
+     * UnaryDataSource objects, in which each node evaluates its children
+     * with a virtual get() call. compile() replaces such a tree by one
+     * DataSource which evaluates the operators as an array of instructions
+     * on a register file, in a single loop. Constants are stored in the
+     * instruction array. All other DataSources in the tree, such as variables,
+     * method calls or expressions on user types, remain leaves which
+     * are read with get().
+     */
+    class RTT_SCRIPTING_API ExpressionCompiler
+    {
+    public:
+        /**
+         * Compiles an expression.
+         * @param expr The root of an expression tree.
+         * @return A DataSource of the same type which evaluates to the same
+         * value as \a expr, or \a expr itself if it does not contain an
+         * operator that can be compiled.
+         */
+        static base::DataSourceBase::shared_ptr compile( base::DataSourceBase::shared_ptr expr );
+    };
+}}
+
+#endif
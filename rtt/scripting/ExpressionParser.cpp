@@ -45,6 +45,7 @@
 #include "PeerParser.hpp"
 #include "../types/Types.hpp"
 #include "SendHandleAlias.hpp"
+#include "ExpressionCompiler.hpp"
 
 #include <boost/lambda/lambda.hpp>
 
@@ -582,7 +583,13 @@ namespace RTT
   DataSourceBase::shared_ptr ExpressionParser::getResult()
   {
     assert( !parsestack.empty() );
-    return parsestack.top();
+    // flatten operators on primitive types, only once per result.
+    DataSourceBase::shared_ptr ret = ExpressionCompiler::compile( parsestack.top() );
+    if ( ret != parsestack.top() ) {
+        parsestack.pop();
+        parsestack.push( ret );
+    }
+    return ret;
   }
 
   boost::shared_ptr<AttributeBase> ExpressionParser::getHandle()
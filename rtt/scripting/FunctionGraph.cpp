@@ -57,7 +57,8 @@ namespace RTT {
 
 
     FunctionGraph::FunctionGraph(const std::string& _name, bool unload_on_stop)
-        : myName(_name), retn(0), pausing(false), mstep(false), munload_on_stop(unload_on_stop)
+        : startpc(0), exitpc(0), current(0), previous(0),
+          myName(_name), retn(0), pausing(false), mstep(false), munload_on_stop(unload_on_stop)
     {
         // the start vertex of our function graph
         startv = add_vertex( program );
@@ -67,7 +68,7 @@ namespace RTT {
     }
 
     FunctionGraph::FunctionGraph( const FunctionGraph& orig )
-        :  program( orig.getGraph() ), myName( orig.getName() )
+        :  startpc(0), exitpc(0), current(0), previous(0), program( orig.getGraph() ), myName( orig.getName() )
     {
         // The nodes are copied, which causes a clone of their contents.
         graph_traits<Graph>::vertex_iterator v1,v2, it;
@@ -108,6 +109,33 @@ namespace RTT {
         graph_traits<Graph>::vertices_size_type cnt = 0;
         for(tie(vi,vend) = vertices(program); vi != vend; ++vi)
             put(index, *vi, cnt++);
+
+        // lower the graph into a table indexed by vertex_index, such that
+        // executing does not need to walk the graph.
+        boost::property_map<Graph, vertex_command_t>::type
+            cmap = get(vertex_command, program);
+        boost::property_map<Graph, edge_condition_t>::type
+            emap = get(edge_condition, program);
+        nodes.resize( cnt );
+        for(tie(vi,vend) = vertices(program); vi != vend; ++vi)
+            nodes[ get(index, *vi) ] = *vi;
+        code.resize( cnt );
+        branches.clear();
+        graph_traits<Graph>::out_edge_iterator ei, ei_end;
+        for ( unsigned int i = 0; i != cnt; ++i ) {
+            code[i].node = &cmap[ nodes[i] ];
+            code[i].first = branches.size();
+            // keep the order of the out edges, the first valid one is taken.
+            for ( tie(ei, ei_end) = boost::out_edges( nodes[i], program ); ei != ei_end; ++ei) {
+                Branch b;
+                b.cond = &emap[*ei];
+                b.target = get(index, boost::target(*ei, program) );
+                branches.push_back( b );
+            }
+            code[i].last = branches.size();
+        }
+        startpc = get(index, startv);
+        exitpc = get(index, exitv);
         this->reset();
     }
 
@@ -225,48 +253,47 @@ namespace RTT {
     }
 
 
-    bool FunctionGraph::executeUntil()
+    bool FunctionGraph::enterCurrent()
     {
-        graph_traits<Graph>::out_edge_iterator ei, ei_end;
-        // the map contains _references_ to all vertex_command properties
-        boost::property_map<Graph, vertex_command_t>::type
-            cmap = get(vertex_command, program);
-        boost::property_map<Graph, edge_condition_t>::type
-            emap = get(edge_condition, program);
+        const Instruction& ins = code[current];
+        for ( unsigned int i = ins.first; i != ins.last; ++i )
+            branches[i].cond->reset();
+        try {
+            ins.node->startExecution();
+        } catch(...) {
+            pStatus = Status::error;
+            return false;
+        }
+        return true;
+    }
 
+    bool FunctionGraph::executeUntil()
+    {
         do {
             // Check this always on entry of executeUntil :
             // initialise current node if needed and reset all its out_edges
             // if previous == current, we DO NOT RESET, because we want to check
             // if previous command has completed !
-            if ( previous != current )
-                {
-                    for ( tie(ei, ei_end) = boost::out_edges( current, program ); ei != ei_end; ++ei)
-                        emap[*ei].reset();
-                    try {
-                        cmap[current].startExecution();
-                    } catch(...) {
-                        pStatus = Status::error;
-                        return false;
-                    }
-                }
+            if ( previous != current && !this->enterCurrent() )
+                return false;
 
             // initial conditions :
             previous = current;
+            const Instruction& ins = code[current];
             // execute the current command.
             try {
-                cmap[current].execute();
+                ins.node->execute();
             } catch(...) {
                 pStatus = Status::error;
                 return false;
             }
 
             // Branch selecting Logic :
-            if ( cmap[current].isValid() ) {
-                for ( tie(ei, ei_end) = boost::out_edges( current, program ); ei != ei_end; ++ei) {
+            if ( ins.node->isValid() ) {
+                for ( unsigned int i = ins.first; i != ins.last; ++i ) {
                     try {
-                        if ( emap[*ei].evaluate() ) {
-                            current = boost::target(*ei, program);
+                        if ( branches[i].cond->evaluate() ) {
+                            current = branches[i].target;
                             // a new node has been found ...
                             // so continue
                             break; // exit from for loop.
@@ -280,7 +307,7 @@ namespace RTT {
         } while ( previous != current && pStatus == Status::running && !pausing); // keep going if we found a new node
 
         // check finished state
-        if (current == exitv) {
+        if (current == exitpc) {
             this->stop();
             return !munload_on_stop;
         }
@@ -289,42 +316,30 @@ namespace RTT {
 
     bool FunctionGraph::executeStep()
     {
-        graph_traits<Graph>::out_edge_iterator ei, ei_end;
-        // the map contains _references_ to all vertex_command properties
-        boost::property_map<Graph, vertex_command_t>::type
-            cmap = get(vertex_command, program);
-        boost::property_map<Graph, edge_condition_t>::type
-            emap = get(edge_condition, program);
-
         // initialise current node if needed and reset all its out_edges
         if ( previous != current )
         {
-            for ( tie(ei, ei_end) = boost::out_edges( current, program ); ei != ei_end; ++ei)
-                emap[*ei].reset();
-            try {
-                cmap[current].startExecution();
-            } catch(...) {
-                pStatus = Status::error;
+            if ( !this->enterCurrent() )
                 return false;
-            }
             previous = current;
         }
 
+        const Instruction& ins = code[current];
         // execute the current command.
         try {
-            cmap[current].execute();
+            ins.node->execute();
         } catch(...) {
             pStatus = Status::error;
             return false;
         }
 
         // Branch selecting Logic :
-        if ( cmap[current].isValid() ) {
-            for ( tie(ei, ei_end) = boost::out_edges( current, program ); ei != ei_end; ++ei) {
+        if ( ins.node->isValid() ) {
+            for ( unsigned int i = ins.first; i != ins.last; ++i ) {
                 try {
-                    if ( emap[*ei].evaluate() ) {
-                        current = boost::target(*ei, program);
-                        if (current == exitv)
+                    if ( branches[i].cond->evaluate() ) {
+                        current = branches[i].target;
+                        if (current == exitpc)
                             this->stop();
                         // a new node has been found ...
                         // it will be executed in the next step.
@@ -337,14 +352,14 @@ namespace RTT {
             }
         }
         // check finished state
-        if (current == exitv)
+        if (current == exitpc)
             this->stop();
         return true; // no new branch found yet !
     }
 
     void FunctionGraph::reset() {
-        current = startv;
-        previous = exitv;
+        current = startpc;
+        previous = exitpc;
         this->stop();
     }
 
@@ -377,7 +392,7 @@ namespace RTT {
 
     int FunctionGraph::getLineNumber() const
     {
-        return get(vertex_command, program)[current].getLineNumber();
+        return code[current].node->getLineNumber();
     }
 
     FunctionGraph* FunctionGraph::copy( std::map<const DataSourceBase*, DataSourceBase*>& replacementdss ) const
@@ -417,10 +432,8 @@ namespace RTT {
 
         ret->startv = o2cmap[startv];
         ret->exitv = o2cmap[exitv];
-        ret->current = o2cmap[current];
-        ret->previous = o2cmap[previous];
 
-        // so that ret itself can be copied again :
+        // so that ret itself can be copied again, this also resets ret :
         ret->finish();
 
 //         std::cerr << "Resulted in :" <<std::endl;
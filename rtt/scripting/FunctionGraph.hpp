@@ -73,14 +73,49 @@ namespace RTT
 
     private:
         /**
-         * The node which is executed now
+         * A vertex of the graph, with the range of its out edges
+         * in \a branches.
          */
-        Vertex current;
+        struct Instruction {
+            VertexNode* node;
+            unsigned int first;
+            unsigned int last;
+        };
 
         /**
-         * The node that was run before this one.
+         * An out edge of a vertex, with the index of its target
+         * in \a code.
          */
-        Vertex previous;
+        struct Branch {
+            EdgeCondition* cond;
+            unsigned int target;
+        };
+
+        /**
+         * The graph lowered to a flat table by finish(), which is
+         * walked by executeUntil() and executeStep(). It points into
+         * \a program, which may not be modified afterwards.
+         */
+        std::vector<Instruction> code;
+        std::vector<Branch> branches;
+        std::vector<Vertex> nodes;
+        unsigned int startpc;
+        unsigned int exitpc;
+
+        /**
+         * The index of the node which is executed now
+         */
+        unsigned int current;
+
+        /**
+         * The index of the node that was run before this one.
+         */
+        unsigned int previous;
+
+        /**
+         * Resets the out edges of the current node and starts it.
+         */
+        bool enterCurrent();
 
     protected:
         /**
@@ -156,7 +191,9 @@ namespace RTT
         virtual bool needsStart() const { return !munload_on_stop; }
 
         /**
-         * To be called after a function is constructed.
+         * To be called after a function is constructed. It lowers
+         * the graph into the table which is executed, so the graph
+         * may no longer be modified afterwards.
          */
         void finish();
 
@@ -211,12 +248,12 @@ namespace RTT
 
         Vertex currentNode() const
         {
-            return current;
+            return nodes[current];
         }
 
         Vertex previousNode() const
         {
-            return previous;
+            return nodes[previous];
         }
 
         Vertex exitNode() const
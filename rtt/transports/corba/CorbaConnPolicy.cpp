@@ -72,3 +72,11 @@ RTT::ConnPolicy toRTT(RTT::corba::CConnPolicy const& corba_policy)
     policy.name_id     = corba_policy.name_id;
     return policy;
 }
+
+RTT::corba::CBatchPolicy toCORBABatch(RTT::ConnPolicy const& policy)
+{
+    RTT::corba::CBatchPolicy corba_batch;
+    corba_batch.batch_size    = policy.batch_size;
+    corba_batch.batch_latency = policy.batch_latency;
+    return corba_batch;
+}
@@ -58,3 +58,11 @@ RTT::corba::CConnPolicy RTT_CORBA_API toCORBA(RTT::ConnPolicy const& policy);
  */
 RTT::ConnPolicy RTT_CORBA_API toRTT(RTT::corba::CConnPolicy const& corba_policy);
 
+/**
+ * Returns the batch_size and batch_latency of a RTT ConnPolicy object,
+ * which are not part of a Corba CConnPolicy object.
+ * @param policy RTT policy
+ * @return Corba batch policy
+ */
+RTT::corba::CBatchPolicy RTT_CORBA_API toCORBABatch(RTT::ConnPolicy const& policy);
+
@@ -41,6 +41,9 @@
 namespace RTT {
     using namespace corba;
     CorbaDispatcher::DispatchMap CorbaDispatcher::DispatchI;
+    CorbaDispatcher::DispatchPool CorbaDispatcher::Pool;
+    unsigned int CorbaDispatcher::poolSize = 0;
+    volatile int CorbaDispatcher::poolReady = 0;
     RTT_CORBA_API os::Mutex* CorbaDispatcher::mlock = 0;
 
     int CorbaDispatcher::defaultScheduler = ORO_SCHED_RT;
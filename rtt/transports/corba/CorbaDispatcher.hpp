@@ -40,30 +40,86 @@
 #define ORO_CORBA_DISPATCHER_HPP
 
 #include "../../os/MutexLock.hpp"
+#include "../../os/Atomic.hpp"
+#include "../../os/CAS.hpp"
 #include "../../Activity.hpp"
+#include "../../os/Timer.hpp"
 #include "../../base/ChannelElementBase.hpp"
 #include "../../Logger.hpp"
 #include "../../internal/List.hpp"
 #include "DataFlowI.h"
 #include "../../DataFlowInterface.hpp"
 #include "../../TaskContext.hpp"
+#include <vector>
+#include <algorithm>
+#include <sstream>
 
 namespace RTT {
     namespace corba {
         /**
          * This object sends over data flow messages
          * from local buffers to a remote channel element.
+         *
+         * By default, one dispatcher thread is created for each data flow
+         * interface with remote connections. When setPoolSize() was called,
+         * a fixed pool of dispatcher threads is shared by all interfaces
+         * instead, and every channel is handled by the dispatcher its
+         * address hashes to.
+         *
+         * Signalled channels are pushed on a lock-free intrusive list,
+         * which the dispatcher empties in one go. A flag in the channel
+         * tells in constant time if it is already in that list.
          */
         class CorbaDispatcher : public Activity
         {
             typedef std::map<DataFlowInterface*,CorbaDispatcher*> DispatchMap;
             RTT_CORBA_API static DispatchMap DispatchI;
 
-            typedef internal::List<base::ChannelElementBase::shared_ptr> RCList;
-            RCList RClist;
+            typedef std::vector<CorbaDispatcher*> DispatchPool;
+            RTT_CORBA_API static DispatchPool Pool;
+            RTT_CORBA_API static unsigned int poolSize;
+            /**
+             * Set once Pool is filled, such that Instance() can read
+             * Pool without taking the lock.
+             */
+            RTT_CORBA_API static volatile int poolReady;
+
+            /**
+             * The channels which are waiting to be transferred, most
+             * recently signalled first.
+             */
+            CRemoteChannelElement_i* volatile ready;
+
+            /**
+             * Statistics, see getStatistics().
+             */
+            os::AtomicInt mdepth;
+            int mmax_depth;
+            unsigned int mdispatched;
 
             bool do_exit;
 
+            /**
+             * Dispatches the held channels again when the
+             * earliest batch latency of them expires.
+             */
+            class FlushTimer : public os::Timer
+            {
+                CorbaDispatcher* mowner;
+            public:
+                FlushTimer(CorbaDispatcher* owner, int scheduler, int priority)
+                    : os::Timer(1, scheduler, priority), mowner(owner) {}
+                void timeout(TimerId) { mowner->flushHeld(); }
+            };
+            FlushTimer* mflush_timer;
+
+            /**
+             * The channels which hold back an incomplete batch,
+             * see holdChannel().
+             */
+            std::vector<CRemoteChannelElement_i*> mheld;
+            os::Mutex mheld_lock;
+
             RTT_CORBA_API static os::Mutex* mlock;
 
             RTT_CORBA_API static int defaultScheduler;
@@ -71,18 +127,51 @@ namespace RTT {
 
             CorbaDispatcher( const std::string& name)
             : Activity(defaultScheduler, defaultPriority, 0.0, 0, name),
-              RClist(20,2),
-              do_exit(false)
+              ready(0), mmax_depth(0), mdispatched(0),
+              do_exit(false), mflush_timer(0)
               {}
 
             CorbaDispatcher( const std::string& name, int scheduler, int priority)
             : Activity(scheduler, priority, 0.0, 0, name),
-              RClist(20,2),
-              do_exit(false)
+              ready(0), mmax_depth(0), mdispatched(0),
+              do_exit(false), mflush_timer(0)
               {}
 
             ~CorbaDispatcher() {
                 this->stop();
+                delete mflush_timer;
+                for (std::vector<CRemoteChannelElement_i*>::iterator it = mheld.begin(); it != mheld.end(); ++it) {
+                    (*it)->dispatch_held = false;
+                    (*it)->_remove_ref();
+                }
+                // drop the references to channels which were not transferred.
+                CRemoteChannelElement_i* chan = takeReady();
+                while ( chan ) {
+                    CRemoteChannelElement_i* next = chan->dispatch_next;
+                    chan->dispatch_queued = 0;
+                    chan->_remove_ref();
+                    chan = next;
+                }
+            }
+
+            /**
+             * Takes all ready channels from the list, in the order
+             * in which they were signalled.
+             */
+            CRemoteChannelElement_i* takeReady() {
+                CRemoteChannelElement_i* list;
+                do {
+                    list = ready;
+                } while ( !os::CAS(&ready, list, (CRemoteChannelElement_i*)0) );
+                // reverse the list
+                CRemoteChannelElement_i* result = 0;
+                while ( list ) {
+                    CRemoteChannelElement_i* next = list->dispatch_next;
+                    list->dispatch_next = result;
+                    result = list;
+                    list = next;
+                }
+                return result;
             }
 
         public:
@@ -90,13 +179,34 @@ namespace RTT {
              * Create a new dispatcher for a given data flow interface.
              * This method will only lock and allocate when a new dispatcher must be created,
              * otherwise, the access is lock-free and real-time.
-             * One dispatcher per \a iface is created.
+             * One dispatcher per \a iface is created, unless a pool size was set.
              * @param iface The interface to dispatch data flow messages for.
+             * @param scheduler The scheduler of a newly created dispatcher thread.
+             * @param priority The priority of a newly created dispatcher thread.
              * @return
              */
             static CorbaDispatcher* Instance(DataFlowInterface* iface, int scheduler = defaultScheduler, int priority = defaultPriority) {
                 if (!mlock)
                     mlock = new os::Mutex();
+                if ( poolSize != 0 ) {
+                    if ( !poolReady ) {
+                        os::MutexLock lock(*mlock);
+                        if ( Pool.empty() ) {
+                            DispatchPool pool;
+                            for (unsigned int i = 0; i != poolSize; ++i) {
+                                std::stringstream name;
+                                name << "CorbaDispatch." << i;
+                                pool.push_back( new CorbaDispatcher( name.str(), scheduler, priority ) );
+                                pool.back()->start();
+                            }
+                            Pool.swap(pool);
+                        }
+                        // publishes Pool to the threads which do not lock.
+                        os::CAS(&poolReady, 0, 1);
+                    } else
+                        os::fence();
+                    return Pool[ hash(iface) % Pool.size() ];
+                }
                 DispatchMap::iterator result = DispatchI.find(iface);
                 if ( result == DispatchI.end() ) {
                     os::MutexLock lock(*mlock);
@@ -118,8 +228,37 @@ namespace RTT {
                 return result->second;
             }
 
+            /**
+             * Shares a pool of \a size dispatcher threads between all data flow
+             * interfaces, instead of creating one thread per interface.
+             * This must be called before the first remote connection is made.
+             * @param size The number of threads in the pool. Zero restores the
+             * default of one dispatcher per interface.
+             * @return false if dispatchers were already created.
+             */
+            static bool setPoolSize(unsigned int size) {
+                if (!mlock)
+                    mlock = new os::Mutex();
+                os::MutexLock lock(*mlock);
+                if ( !Pool.empty() || !DispatchI.empty() ) {
+                    log(Error) << "CorbaDispatcher: can not change the pool size after the first remote connection was made." <<endlog();
+                    return false;
+                }
+                poolSize = size;
+                return true;
+            }
+
+            /**
+             * Returns the number of threads in the dispatcher pool, or zero
+             * if each data flow interface has its own dispatcher.
+             */
+            static unsigned int getPoolSize() {
+                return poolSize;
+            }
+
             /**
              * Releases and cleans up a specific interface from dispatching.
+             * Pooled dispatchers are only released by ReleaseAll().
              * @param iface
              */
             static void Release(DataFlowInterface* iface) {
@@ -129,9 +268,10 @@ namespace RTT {
                     delete result->second;
                     DispatchI.erase(result);
                 }
-                if ( DispatchI.empty() )
+                if ( DispatchI.empty() && Pool.empty() ) {
                     delete mlock;
-                mlock = 0;
+                    mlock = 0;
+                }
             }
 
             /**
@@ -144,25 +284,102 @@ namespace RTT {
                     DispatchI.erase(result);
                     result = DispatchI.begin();
                 }
+                poolReady = 0;
+                for (DispatchPool::iterator it = Pool.begin(); it != Pool.end(); ++it)
+                    delete *it;
+                Pool.clear();
                 delete mlock;
                 mlock = 0;
             }
 
-	    static void hasElement(base::ChannelElementBase::shared_ptr c0, base::ChannelElementBase::shared_ptr c1, bool& result)
-	    {
-		result = result || (c0 == c1);
-	    }
+            /**
+             * The queue statistics of one dispatcher.
+             */
+            struct Statistics {
+                /** The name of the dispatcher thread. */
+                std::string name;
+                /** The number of channels waiting to be transferred. */
+                int depth;
+                /** The largest number of channels that were transferred in one go. */
+                int max_depth;
+                /** The number of channel transfers done. */
+                unsigned int dispatched;
+            };
+
+            /**
+             * Returns the queue statistics of all dispatchers.
+             */
+            static std::vector<Statistics> getStatistics() {
+                std::vector<Statistics> result;
+                if (!mlock)
+                    return result;
+                os::MutexLock lock(*mlock);
+                for (DispatchPool::iterator it = Pool.begin(); it != Pool.end(); ++it)
+                    result.push_back( (*it)->getQueueStatistics() );
+                for (DispatchMap::iterator it = DispatchI.begin(); it != DispatchI.end(); ++it)
+                    result.push_back( it->second->getQueueStatistics() );
+                return result;
+            }
 
+            /**
+             * Describes the queue statistics of all dispatchers, one line
+             * per dispatcher. Served components export this as their
+             * 'dumpCorbaDispatcherStatistics' operation.
+             */
+            static std::string dumpStatistics() {
+                std::stringstream result;
+                std::vector<Statistics> stats = getStatistics();
+                for (std::vector<Statistics>::const_iterator it = stats.begin(); it != stats.end(); ++it)
+                    result << it->name << ": depth " << it->depth << ", max depth " << it->max_depth
+                           << ", dispatched " << it->dispatched << std::endl;
+                return result.str();
+            }
+
+            /**
+             * Returns the queue statistics of this dispatcher.
+             */
+            Statistics getQueueStatistics() {
+                Statistics stats;
+                stats.name = this->getName();
+                stats.depth = mdepth.read();
+                stats.max_depth = mmax_depth;
+                stats.dispatched = mdispatched;
+                return stats;
+            }
+
+            /**
+             * Queues \a chan for transferring its samples by this
+             * dispatcher or, when a pool is used, by the dispatcher
+             * \a chan hashes to. Does nothing if \a chan is already queued.
+             * This method does not block and does not allocate.
+             */
             void dispatchChannel( base::ChannelElementBase::shared_ptr chan ) {
-		bool has_element = false;
-		RClist.apply(boost::bind(&CorbaDispatcher::hasElement, _1, chan, boost::ref(has_element)));
-                if (!has_element)
-	            RClist.append( chan );
-                this->trigger();
+                CRemoteChannelElement_i* rbase = dynamic_cast<CRemoteChannelElement_i*>(chan.get());
+                if ( !rbase )
+                    return;
+                poolTarget( rbase )->enqueue( rbase );
             }
 
+            /**
+             * Called by \a chan from transferSamples() when it holds back
+             * an incomplete batch. The channel is dispatched again after
+             * \a delay seconds, unless it is signalled before that.
+             * This does not block the dispatcher thread.
+             */
+            void holdChannel( CRemoteChannelElement_i* chan, Seconds delay ) {
+                poolTarget( chan )->hold( chan, delay );
+            }
+
+            /**
+             * Removes \a chan from the queue and from the held channels,
+             * and drops the references the dispatcher kept to it.
+             * A transfer which is already running is not interrupted.
+             */
             void cancelChannel( base::ChannelElementBase::shared_ptr chan ) {
-                RClist.erase( chan );
+                CRemoteChannelElement_i* rbase = dynamic_cast<CRemoteChannelElement_i*>(chan.get());
+                if ( !rbase )
+                    return;
+                poolTarget( rbase )->unlink( rbase );
             }
 
             bool initialize() {
@@ -172,12 +389,23 @@ namespace RTT {
             }
 
             void loop() {
-                while ( !RClist.empty() && !do_exit) {
-                    base::ChannelElementBase::shared_ptr chan = RClist.front();
-                    CRemoteChannelElement_i* rbase = dynamic_cast<CRemoteChannelElement_i*>(chan.get());
-                    if (rbase)
-                        rbase->transferSamples();
-                    RClist.erase( chan );
+                CRemoteChannelElement_i* chan;
+                while ( !do_exit && (chan = takeReady()) ) {
+                    int count = 0;
+                    while ( chan ) {
+                        CRemoteChannelElement_i* next = chan->dispatch_next;
+                        // clear the flag first, such that a signal during the
+                        // transfer queues the channel again.
+                        os::CAS(&chan->dispatch_queued, 1, 0);
+                        mdepth.dec();
+                        chan->transferSamples();
+                        chan->_remove_ref();
+                        ++count;
+                        chan = next;
+                    }
+                    mdispatched += count;
+                    if ( count > mmax_depth )
+                        mmax_depth = count;
                 }
             }
 
@@ -185,6 +413,106 @@ namespace RTT {
                 do_exit = true;
                 return true;
             }
+
+        private:
+            void hold( CRemoteChannelElement_i* chan, Seconds delay ) {
+                os::MutexLock lock(mheld_lock);
+                if ( !mflush_timer )
+                    mflush_timer = new FlushTimer( this, this->thread()->getScheduler(), this->thread()->getPriority() );
+                if ( !chan->dispatch_held ) {
+                    chan->dispatch_held = true;
+                    chan->_add_ref();
+                    mheld.push_back( chan );
+                }
+                if ( !mflush_timer->isArmed(0) || mflush_timer->timeRemaining(0) > delay )
+                    mflush_timer->arm(0, delay);
+            }
+
+            /**
+             * Dispatches all held channels again. Those of which the
+             * batch latency did not expire yet hold themselves again.
+             */
+            void flushHeld() {
+                std::vector<CRemoteChannelElement_i*> held;
+                {
+                    os::MutexLock lock(mheld_lock);
+                    held.swap( mheld );
+                    for (std::vector<CRemoteChannelElement_i*>::iterator it = held.begin(); it != held.end(); ++it)
+                        (*it)->dispatch_held = false;
+                }
+                for (std::vector<CRemoteChannelElement_i*>::iterator it = held.begin(); it != held.end(); ++it) {
+                    enqueue( *it );
+                    (*it)->_remove_ref();
+                }
+            }
+
+            void enqueue( CRemoteChannelElement_i* rbase ) {
+                // O(1) test if it is already waiting.
+                if ( os::CAS(&rbase->dispatch_queued, 0, 1) ) {
+                    // keep the channel alive while it is queued.
+                    rbase->_add_ref();
+                    mdepth.inc();
+                    push( rbase );
+                }
+                this->trigger();
+            }
+
+            void push( CRemoteChannelElement_i* rbase ) {
+                CRemoteChannelElement_i* head;
+                do {
+                    head = ready;
+                    rbase->dispatch_next = head;
+                } while ( !os::CAS(&ready, head, rbase) );
+            }
+
+            void unlink( CRemoteChannelElement_i* chan ) {
+                {
+                    os::MutexLock lock(mheld_lock);
+                    std::vector<CRemoteChannelElement_i*>::iterator it = std::find( mheld.begin(), mheld.end(), chan );
+                    if ( it != mheld.end() ) {
+                        mheld.erase( it );
+                        chan->dispatch_held = false;
+                        chan->_remove_ref();
+                    }
+                }
+                if ( !chan->dispatch_queued )
+                    return;
+                // Owning the whole list keeps the dispatcher from walking it
+                // meanwhile. All other channels are queued again, oldest first.
+                CRemoteChannelElement_i* list = takeReady();
+                bool requeued = false;
+                while ( list ) {
+                    CRemoteChannelElement_i* next = list->dispatch_next;
+                    if ( list == chan ) {
+                        os::CAS(&chan->dispatch_queued, 1, 0);
+                        mdepth.dec();
+                        chan->_remove_ref();
+                    } else {
+                        push( list );
+                        requeued = true;
+                    }
+                    list = next;
+                }
+                if ( requeued )
+                    this->trigger();
+            }
+
+            static std::size_t hash(const void* p) {
+                // heap objects are aligned, skip the low bits.
+                return reinterpret_cast<std::size_t>(p) >> 4;
+            }
+
+            /**
+             * Returns the dispatcher of the pool \a p hashes to, or this
+             * dispatcher if no pool is used. Pool is only read once
+             * poolReady published it, such that no lock is needed.
+             */
+            CorbaDispatcher* poolTarget(const void* p) {
+                if ( !poolReady )
+                    return this;
+                os::fence();
+                return Pool[ hash(p) % Pool.size() ];
+            }
         };
     }
 }
@@ -153,6 +153,11 @@ class CorbaOperationCallerCall: public ActionInterface
     corba::CAnyArguments_var nargs;
     // The type transporter for the return value
     CorbaTypeTransporter* mctt;
+    // The type transporters of the arguments
+    std::vector<CorbaTypeTransporter*> mctts;
+    // The operation on the server, looked up at the first call.
+    CPreparedOperation_var mprepared;
+    bool mprepare;
     bool mdocall;
 public:
     CorbaOperationCallerCall(CService_ptr fact,
@@ -161,8 +166,23 @@ public:
                     ExecutionEngine* caller,
                     CorbaTypeTransporter* ctt,
                     base::DataSourceBase::shared_ptr result, bool docall)
-    : mfact(CService::_duplicate(fact)), mop(op), margs(args), mcaller(caller), mresult(result), mctt(ctt), mdocall(docall)
+    : mfact(CService::_duplicate(fact)), mop(op), margs(args), mcaller(caller), mresult(result), mctt(ctt), mprepare(docall), mdocall(docall)
     {
+        for (size_t i=0; i < margs.size(); ++i ) {
+            const types::TypeInfo* ti = margs[i]->getTypeInfo();
+            mctts.push_back( dynamic_cast<CorbaTypeTransporter*>( ti->getProtocol(ORO_CORBA_PROTOCOL_ID) ) );
+            assert( mctts.back() );
+        }
+    }
+
+    ~CorbaOperationCallerCall() {
+        if ( !CORBA::is_nil(mprepared.in()) ) {
+            try {
+                mprepared->dispose();
+            } catch ( CORBA::Exception& ) {
+                // the server is gone.
+            }
+        }
     }
 
     void readArguments() {
@@ -170,24 +190,25 @@ public:
         // the latest values.
         nargs = new corba::CAnyArguments();
         nargs->length( margs.size() );
-        for (size_t i=0; i < margs.size(); ++i ) {
-            const types::TypeInfo* ti = margs[i]->getTypeInfo();
-            CorbaTypeTransporter* ctt = dynamic_cast<CorbaTypeTransporter*>( ti->getProtocol(ORO_CORBA_PROTOCOL_ID) );
-            assert( ctt );
-            ctt->updateAny(margs[i], nargs[i]);
-        }
+        for (size_t i=0; i < margs.size(); ++i )
+            mctts[i]->updateAny(margs[i], nargs[i]);
     }
 
     bool execute() {
         try {
             if (mdocall) {
-                CORBA::Any_var any = mfact->callOperation( mop.c_str(), nargs.inout() );
-                for (size_t i=0; i < margs.size(); ++i ) {
-                    const types::TypeInfo* ti = margs[i]->getTypeInfo();
-                    CorbaTypeTransporter* ctt = dynamic_cast<CorbaTypeTransporter*>( ti->getProtocol(ORO_CORBA_PROTOCOL_ID) );
-                    assert( ctt );
-                    ctt->updateFromAny( &nargs[i], margs[i] );
+                if (mprepare) {
+                    mprepare = false;
+                    try {
+                        mprepared = mfact->prepareOperation( mop.c_str() );
+                    } catch ( CORBA::SystemException& ) {
+                        // servers without prepareOperation() raise BAD_OPERATION.
+                        mprepared = CPreparedOperation::_nil();
+                    }
                 }
+                CORBA::Any_var any = CORBA::is_nil(mprepared.in()) ? mfact->callOperation( mop.c_str(), nargs.inout() ) : mprepared->call( nargs.inout() );
+                for (size_t i=0; i < margs.size(); ++i )
+                    mctts[i]->updateFromAny( &nargs[i], margs[i] );
                 // convert returned any to local type:
                 if (mctt)
                     return mctt->updateFromAny(&any.in(), mresult);
@@ -216,7 +237,7 @@ public:
         vector<DataSourceBase::shared_ptr> argcopy( margs.size() );
         unsigned int v=0;
         for (vector<DataSourceBase::shared_ptr>::iterator it = argcopy.begin(); it != argcopy.end(); ++it, ++v)
-            argcopy[v] = (*it)->copy(alreadyCloned);
+            *it = margs[v]->copy(alreadyCloned);
         return new CorbaOperationCallerCall(CService::_duplicate( mfact.in() ), mop, argcopy, mcaller, mctt, mresult->copy(alreadyCloned), mdocall);
     }
 };
@@ -369,7 +390,7 @@ public:
         vector<DataSourceBase::shared_ptr> argcopy( margs.size() );
         unsigned int v=0;
         for (vector<DataSourceBase::shared_ptr>::iterator it = argcopy.begin(); it != argcopy.end(); ++it, ++v)
-            argcopy[v] = (*it)->copy(alreadyCloned);
+            *it = margs[v]->copy(alreadyCloned);
         return new CorbaOperationCallerCollect(CSendHandle::_duplicate( msh.in() ), argcopy, misblocking);
     }
 };
@@ -392,6 +392,7 @@ CChannelElement_ptr CDataFlowInterface_i::buildChannelOutput(
     CRemoteChannelElement_i* this_element =
         transporter->createChannelElement_i(mdf, mpoa, corba_policy.pull);
     this_element->setCDataFlowInterface(this);
+    this_element->setBatchPolicy(policy2);
 
     /*
      * This part is for out-of band (needs to be factored out).
@@ -479,6 +480,7 @@ CChannelElement_ptr CDataFlowInterface_i::buildChannelInput(
     CRemoteChannelElement_i* this_element;
     PortableServer::ServantBase_var servant = this_element = transporter->createChannelElement_i(mdf, mpoa, corba_policy.pull);
     this_element->setCDataFlowInterface(this);
+    this_element->setBatchPolicy(policy2);
 
     // Attach the corba channel element first (so OOB is after corba).
     assert( dynamic_cast<ChannelElementBase*>(this_element) );
@@ -537,6 +539,26 @@ CChannelElement_ptr CDataFlowInterface_i::buildChannelInput(
         	      CORBA::SystemException
         	      ,::RTT::corba::CNoSuchPortException
         	    ))
+{
+    return connectPorts(writer_port, reader_interface, reader_port, toRTT(policy));
+}
+
+::CORBA::Boolean CDataFlowInterface_i::createBatchedConnection(
+        const char* writer_port, CDataFlowInterface_ptr reader_interface,
+        const char* reader_port, CConnPolicy & policy, const CBatchPolicy & batch) ACE_THROW_SPEC ((
+        	      CORBA::SystemException
+        	      ,::RTT::corba::CNoSuchPortException
+        	    ))
+{
+    RTT::ConnPolicy policy2 = toRTT(policy);
+    policy2.batch_size = batch.batch_size;
+    policy2.batch_latency = batch.batch_latency;
+    return connectPorts(writer_port, reader_interface, reader_port, policy2);
+}
+
+bool CDataFlowInterface_i::connectPorts(
+        const char* writer_port, CDataFlowInterface_ptr reader_interface,
+        const char* reader_port, RTT::ConnPolicy const& policy)
 {
     Logger::In in("CDataFlowInterface_i::createConnection");
     OutputPortInterface* writer = dynamic_cast<OutputPortInterface*>(mdf->getPort(writer_port));
@@ -560,7 +582,7 @@ CChannelElement_ptr CDataFlowInterface_i::buildChannelInput(
 
         log(Debug) << "CORBA: createConnection() is creating a LOCAL connection between " <<
            writer_port << " and " << reader_port << endlog();
-        return writer->createConnection(*reader, toRTT(policy));
+        return writer->createConnection(*reader, policy);
     }
     else
         log(Debug) << "CORBA: createConnection() is creating a REMOTE connection between " <<
@@ -577,7 +599,7 @@ CChannelElement_ptr CDataFlowInterface_i::buildChannelInput(
         RemoteInputPort port(writer->getTypeInfo(), reader_interface, reader_port, mpoa);
         port.setInterface( mdf ); // cheating !
         // Connect to proxy.
-        return writer->createConnection(port, toRTT(policy));
+        return writer->createConnection(port, policy);
     }
     catch(CORBA::COMM_FAILURE&) { throw; }
     catch(CORBA::TRANSIENT&) { throw; }
@@ -591,6 +613,12 @@ CRemoteChannelElement_i::CRemoteChannelElement_i(RTT::corba::CorbaTypeTransporte
     : transport(transport)
     , mpoa(PortableServer::POA::_duplicate(poa))
     , mdataflow(0)
+    , dispatch_queued(0)
+    , dispatch_next(0)
+    , dispatch_held(false)
+    , mbatch_size(0)
+    , mbatch_latency(0.0)
+    , mbatch_oneway(false)
     { }
 CRemoteChannelElement_i::~CRemoteChannelElement_i() {}
 PortableServer::POA_ptr CRemoteChannelElement_i::_default_POA()
@@ -47,6 +47,7 @@
 #include "CorbaConversion.hpp"
 #include "../../base/ChannelElement.hpp"
 #include "../../internal/DataSources.hpp"
+#include "../../ConnPolicy.hpp"
 #include "CorbaTypeTransporter.hpp"
 #include <list>
 #include <rtt/os/Mutex.hpp>
@@ -76,6 +77,26 @@ namespace RTT {
             PortableServer::POA_var mpoa;
             CDataFlowInterface_i* mdataflow;
 
+            friend class CorbaDispatcher;
+            /**
+             * The links of the ready list of the CorbaDispatcher.
+             * dispatch_queued is 1 while this element is in that list.
+             */
+            volatile int dispatch_queued;
+            CRemoteChannelElement_i* dispatch_next;
+            /**
+             * True while the CorbaDispatcher holds this element until
+             * its batch latency expires, see CorbaDispatcher::holdChannel().
+             */
+            bool dispatch_held;
+
+            /**
+             * Batching of pushed samples, see setBatchPolicy().
+             */
+            int mbatch_size;
+            double mbatch_latency;
+            bool mbatch_oneway;
+
         public:
             // standard constructor
             CRemoteChannelElement_i(corba::CorbaTypeTransporter const& transport,
@@ -94,6 +115,30 @@ namespace RTT {
                 mdataflow = dataflow;
             }
 
+            /**
+             * Reads the batch_size and batch_latency of \a policy.
+             * In push mode, the samples are then sent in batches of
+             * at most batch_size samples per remote call. Circular buffer
+             * and broadcast connections, which may lose samples anyway,
+             * use a oneway call. Other connections wait for the result.
+             */
+            void setBatchPolicy(ConnPolicy const& policy) {
+                mbatch_size = policy.batch_size;
+                mbatch_latency = policy.batch_latency;
+                mbatch_oneway = policy.type == ConnPolicy::CIRCULAR_BUFFER || policy.type == ConnPolicy::BROADCAST;
+            }
+
+            /**
+             * CORBA IDL function: sets the batch_size and batch_latency
+             * the remote side requested for this connection.
+             */
+            void setBatchPolicy(const CBatchPolicy& policy) ACE_THROW_SPEC ((
+          	      CORBA::SystemException
+          	    )) {
+                mbatch_size = policy.batch_size;
+                mbatch_latency = policy.batch_latency;
+            }
+
             PortableServer::POA_ptr _default_POA();
 
             void setRemoteSide(CRemoteChannelElement_ptr remote) ACE_THROW_SPEC ((
@@ -134,6 +179,12 @@ namespace RTT {
             ChannelList channel_list;
             // Lock that should be taken before access to channel_list
             RTT::os::Mutex channel_list_mtx;
+
+            /**
+             * Implements createConnection() and createBatchedConnection().
+             */
+            bool connectPorts( const char* writer_port, CDataFlowInterface_ptr reader_interface,
+                               const char* reader_port, RTT::ConnPolicy const& policy);
         public:
             // standard constructor
             CDataFlowInterface_i(DataFlowInterface* interface, PortableServer::POA_ptr poa);
@@ -209,6 +260,14 @@ namespace RTT {
                                              	      CORBA::SystemException
                                              	      ,::RTT::corba::CNoSuchPortException
                                              	    ));
+            ::CORBA::Boolean createBatchedConnection( const char* writer_port,
+                                               CDataFlowInterface_ptr reader_interface,
+                                               const char* reader_port,
+                                               RTT::corba::CConnPolicy & policy,
+                                               const RTT::corba::CBatchPolicy & batch) ACE_THROW_SPEC ((
+                                             	      CORBA::SystemException
+                                             	      ,::RTT::corba::CNoSuchPortException
+                                             	    ));
             bool removeConnection( const char* writer_port,
                                                CDataFlowInterface_ptr reader_interface,
                                                const char* reader_port) ACE_THROW_SPEC ((
@@ -74,6 +74,7 @@
 #include "../../internal/OperationCallerC.hpp"
 #include "../../internal/SendHandleC.hpp"
 #include "../../Logger.hpp"
+#include "../../os/MutexLock.hpp"
 
 using namespace RTT;
 using namespace RTT::detail;
@@ -211,6 +212,71 @@ void RTT_corba_CSendHandle_i::dispose (
     return;
 }
 
+RTT_corba_CPreparedOperation_i::RTT_corba_CPreparedOperation_i (const std::string& name, OperationInterfacePart* ofp)
+: mname(name), mofp(ofp), mretctt(0)
+{
+    OperationCallerC mc(mofp, mname, 0);
+    for (unsigned int i = 1; i <= mofp->arity(); ++i) {
+        const TypeInfo* ti = mofp->getArgumentType(i);
+        assert(ti);
+        CorbaTypeTransporter* ctt = dynamic_cast<CorbaTypeTransporter*> ( ti->getProtocol(ORO_CORBA_PROTOCOL_ID) );
+        // these are updated from the anys in each call and hold the results of reference arguments.
+        DataSourceBase::shared_ptr arg = ti->buildValue();
+        if ( !ctt || !arg )
+            throw wrong_types_of_args_exception(i, "type known to CORBA", ti->getTypeName());
+        margs.push_back( arg );
+        mctts.push_back( ctt );
+        mc.arg( margs.back() );
+    }
+    if ( !mc.ready() )
+        mc.check(); // will throw
+    mcall = mc.getCallDataSource();
+    mretctt = dynamic_cast<CorbaTypeTransporter*> ( mcall->getTypeInfo()->getProtocol(ORO_CORBA_PROTOCOL_ID) );
+    if ( !mretctt )
+        log(Warning) << "Could not return results of calls to " << mname << ": unknown return type by CORBA transport."<<endlog();
+}
+
+RTT_corba_CPreparedOperation_i::~RTT_corba_CPreparedOperation_i (void)
+{
+}
+
+::CORBA::Any * RTT_corba_CPreparedOperation_i::call (
+    ::RTT::corba::CAnyArguments & args)
+{
+    if ( args.length() != margs.size() )
+        throw ::RTT::corba::CWrongNumbArgException( margs.size(), args.length() );
+    os::MutexLock lock(mlock);
+    try {
+        for (size_t i = 0; i != margs.size(); ++i)
+            if ( !mctts[i]->updateFromAny( &args[i], margs[i] ) )
+                throw ::RTT::corba::CWrongTypeArgException( i + 1, margs[i]->getTypeName().c_str(), "a different type" );
+
+        CORBA::Any* retany;
+        if ( mretctt )
+            retany = mretctt->createAny( mcall ); // call evaluate internally
+        else {
+            mcall->evaluate();
+            retany = new CORBA::Any();
+        }
+
+        // Return results into args:
+        for (size_t i = 0; i != margs.size(); ++i)
+            mctts[i]->updateAny( margs[i], args[i] );
+        return retany;
+    } catch (std::runtime_error& e){
+        throw ::RTT::corba::CCallError(e.what());
+    }
+}
+
+void RTT_corba_CPreparedOperation_i::dispose (
+    void)
+{
+    PortableServer::POA_var mPOA = _default_POA();
+    PortableServer::ObjectId_var oid = mPOA->servant_to_id(this);
+    mPOA->deactivate_object( oid.in() );
+    return;
+}
+
 // Implementation skeleton constructor
 RTT_corba_COperationInterface_i::RTT_corba_COperationInterface_i (OperationInterface* gmf, PortableServer::POA_ptr the_poa)
     :mfact(gmf), mpoa( PortableServer::POA::_duplicate(the_poa))
@@ -450,3 +516,26 @@ void RTT_corba_COperationInterface_i::checkOperation (
     }
     return CSendHandle::_nil();
 }
+
+::RTT::corba::CPreparedOperation_ptr RTT_corba_COperationInterface_i::prepareOperation (
+    const char * operation)
+{
+    if ( mfact->hasMember( string( operation ) ) == false || mfact->isSynchronous(string(operation)) )
+        throw ::RTT::corba::CNoSuchNameException( operation );
+    try {
+        RTT_corba_CPreparedOperation_i* ret_i = new RTT_corba_CPreparedOperation_i( operation, mfact->getPart(operation) );
+        CPreparedOperation_var ret = ret_i->_this();
+        ret_i->_remove_ref(); // if POA drops this, it gets cleaned up.
+        return ret._retn();
+    } catch (no_asynchronous_operation_exception& ) {
+        throw ::RTT::corba::CNoSuchNameException( operation );
+    } catch ( name_not_found_exception& ) {
+        throw ::RTT::corba::CNoSuchNameException( operation );
+    } catch (wrong_types_of_args_exception& wta ) {
+        // an argument can not be transported, so the operation can not be called remotely.
+        log(Error) << "Can not prepare operation '" << operation << "': argument " << wta.whicharg
+                   << " of type " << wta.received_ << " is unknown to the CORBA transport." << endlog();
+        throw ::RTT::corba::CNoSuchNameException( operation );
+    }
+    return CPreparedOperation::_nil();
+}
@@ -77,11 +77,16 @@
 #endif
 #include "../../OperationInterface.hpp"
 #include "../../internal/SendHandleC.hpp"
+#include "../../os/Mutex.hpp"
+#include <string>
+#include <vector>
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 #pragma once
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
+namespace RTT { namespace corba { class CorbaTypeTransporter; } }
+
 class  RTT_corba_CSendHandle_i
   : public virtual POA_RTT::corba::CSendHandle,
   public virtual PortableServer::RefCountServantBase
@@ -120,6 +125,39 @@ public:
   void dispose ();
 };
 
+/**
+ * Calls one operation with argument data sources and transporters
+ * that were looked up when it was prepared.
+ */
+class  RTT_corba_CPreparedOperation_i
+  : public virtual POA_RTT::corba::CPreparedOperation,
+  public virtual PortableServer::RefCountServantBase
+{
+      std::string mname;
+      RTT::OperationInterfacePart* mofp;
+      std::vector<RTT::base::DataSourceBase::shared_ptr> margs;
+      std::vector<RTT::corba::CorbaTypeTransporter*> mctts;
+      RTT::base::DataSourceBase::shared_ptr mcall;
+      RTT::corba::CorbaTypeTransporter* mretctt;
+      // concurrent calls share margs.
+      RTT::os::Mutex mlock;
+public:
+  /**
+   * Looks up the argument types of \a ofp and creates the call.
+   * @throw name_not_found_exception, wrong_types_of_args_exception
+   */
+  RTT_corba_CPreparedOperation_i (const std::string& name, RTT::OperationInterfacePart* ofp);
+
+  virtual ~RTT_corba_CPreparedOperation_i (void);
+
+  virtual
+  ::CORBA::Any * call (
+      ::RTT::corba::CAnyArguments & args);
+
+  virtual
+  void dispose ();
+};
+
 class  RTT_corba_COperationInterface_i
   : public virtual POA_RTT::corba::COperationInterface
 {
@@ -180,6 +218,10 @@ class  RTT_corba_COperationInterface_i
   ::RTT::corba::CSendHandle_ptr sendOperation (
       const char * operation,
       const ::RTT::corba::CAnyArguments & args);
+
+  virtual
+  ::RTT::corba::CPreparedOperation_ptr prepareOperation (
+      const char * operation);
 };
 
 
@@ -42,6 +42,8 @@
 #include "DataFlowI.h"
 #include "CorbaTypeTransporter.hpp"
 #include "CorbaDispatcher.hpp"
+#include "../../os/Time.hpp"
+#include "../../os/TimeService.hpp"
 
 namespace RTT {
 
@@ -82,6 +84,17 @@ namespace RTT {
              */
             CORBA::Any* write_any;
 
+            /** This is used on the writing side to collect a batch of
+             * samples, see transferBatch().
+             */
+            CAnySequence write_batch;
+            /**
+             * The number of samples in write_batch which are held back,
+             * and the time the first of them was read.
+             */
+            CORBA::ULong write_batch_count;
+            os::TimeService::ticks write_batch_since;
+
             PortableServer::ObjectId_var oid;
 
 	public:
@@ -97,7 +110,8 @@ namespace RTT {
 	      const_ref_data_source(new internal::LateConstReferenceDataSource<T>),
               valid(true), pull(is_pull),
 	      msender(sender),
-              write_any(new CORBA::Any)
+              write_any(new CORBA::Any),
+              write_batch_count(0), write_batch_since(0)
             {
                 // Big note about cleanup: The RTT will dispose this object through
 	            // the ChannelElement<T> refcounting. So we only need to inform the
@@ -166,6 +180,8 @@ namespace RTT {
                         log(Error) << "caught CORBA exception while signalling our remote endpoint: " << e._name() << endlog();
                         valid = false;
                     }
+                } else if ( mbatch_size > 1 && !this->getOutput() ) {
+                    transferBatch();
                 } else {
                     //log(Debug) <<"...read..."<<endlog();
                     while ( this->read(sample, false) == NewData && valid) {
@@ -179,6 +195,58 @@ namespace RTT {
 
             }
 
+            /**
+             * Sends the waiting samples in batches of at most mbatch_size
+             * samples per remote call. If a batch latency is set, an
+             * incomplete batch is held back until it is completed by the
+             * next dispatch, or until the dispatcher flushes it when the
+             * latency of its first sample expired.
+             */
+            void transferBatch() {
+                CORBA::ULong max = mbatch_size;
+                write_batch.length(max);
+                while ( valid ) {
+                    while ( write_batch_count < max && base::ChannelElement<T>::read(sample, false) == NewData ) {
+                        if ( write_batch_count == 0 )
+                            write_batch_since = os::TimeService::Instance()->getTicks();
+                        const_ref_data_source->setPointer(&sample);
+                        transport.updateAny(const_ref_data_source, write_batch[write_batch_count]);
+                        ++write_batch_count;
+                    }
+                    if ( write_batch_count == 0 )
+                        break;
+                    if ( write_batch_count < max && mbatch_latency > 0.0 ) {
+                        Seconds held = os::TimeService::Instance()->secondsSince(write_batch_since);
+                        if ( held < mbatch_latency ) {
+                            CorbaDispatcher::Instance(msender)->holdChannel( this, mbatch_latency - held );
+                            return;
+                        }
+                    }
+                    write_batch.length(write_batch_count);
+                    try
+                    {
+                        if ( mbatch_oneway )
+                            remote_side->writeBatchOneway(write_batch);
+                        else
+                            valid = remote_side->writeBatch(write_batch);
+                    }
+#ifdef CORBA_IS_OMNIORB
+                    catch(CORBA::SystemException& e)
+                    {
+                        log(Error) << "caught CORBA exception while marshalling: " << e._name() << " " << e.NP_minorString() << endlog();
+                        valid = false;
+                    }
+#endif
+                    catch(CORBA::Exception& e)
+                    {
+                        log(Error) << "caught CORBA exception while marshalling: " << e._name() << endlog();
+                        valid = false;
+                    }
+                    write_batch.length(max);
+                    write_batch_count = 0;
+                }
+            }
+
             /**
              * CORBA IDL function.
              */
@@ -201,6 +269,9 @@ namespace RTT {
           	      CORBA::SystemException
           	    ))
             {
+                // stop dispatching us before the connection is torn down.
+                CorbaDispatcher::Instance(msender)->cancelChannel( this );
+
                 base::ChannelElement<T>::disconnect(writer_to_reader);
 
                 // Because we support out-of-band transports, we must cleanup more thoroughly.
@@ -229,6 +300,8 @@ namespace RTT {
                 }
                 catch(CORBA::Exception&) {}
 
+                CorbaDispatcher::Instance(msender)->cancelChannel( this );
+
                 base::ChannelElement<T>::disconnect(writer_to_reader);
 
                 // Will fail at shutdown if all objects are already deactivated
@@ -345,6 +418,40 @@ namespace RTT {
                 return base::ChannelElement<T>::write(value_data_source->rvalue());
             }
 
+            /**
+             * CORBA IDL function.
+             * Writes all samples and signals the reader once.
+             */
+            CORBA::Boolean writeBatch(const CAnySequence& samples) ACE_THROW_SPEC ((
+          	      CORBA::SystemException
+          	    ))
+            {
+                typename base::ChannelElement<T>::shared_ptr output =
+                    this->getOutput();
+                if ( !output )
+                    return false;
+                bool result = true;
+                for (CORBA::ULong i = 0; result && i != samples.length(); ++i) {
+                    // a sample that can not be converted is dropped, not written as a stale value.
+                    if ( !transport.updateFromAny(&samples[i], value_data_source) ) {
+                        log(Error) << "could not convert sample " << i << " of a batch, it is dropped." << endlog();
+                        continue;
+                    }
+                    result = output->writeWithoutSignal(value_data_source->rvalue());
+                }
+                return output->signal() && result;
+            }
+
+            /**
+             * CORBA IDL function.
+             */
+            void writeBatchOneway(const CAnySequence& samples) ACE_THROW_SPEC ((
+          	      CORBA::SystemException
+          	    ))
+            {
+                writeBatch(samples);
+            }
+
             virtual bool data_sample(typename base::ChannelElement<T>::param_t sample)
             {
                 // we don't pass it on through CORBA (yet).
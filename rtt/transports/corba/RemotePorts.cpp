@@ -146,12 +146,32 @@ RTT::base::ChannelElementBase::shared_ptr RemoteInputPort::buildRemoteChannelOut
         return NULL;
     }
 
+    // Batches are only pushed to a remote side which knows writeBatch().
+    RTT::ConnPolicy local_policy = policy;
+    if ( policy.batch_size > 1 && !policy.pull ) {
+        try {
+            remote->setBatchPolicy( toCORBABatch(policy) );
+        }
+        catch(CORBA::BAD_OPERATION&)
+        {
+            log(Warning) << "Remote port " << getName() << " was built against an RTT without batched data flow: sending one sample per call." << endlog();
+            local_policy.batch_size = 0;
+        }
+        catch(CORBA::Exception& e)
+        {
+            log(Error) << "Caught CORBA exception while setting the batch policy of a remote channel output:" << endlog();
+            log(Error) << CORBA_EXCEPTION_INFO( e ) <<endlog();
+            return NULL;
+        }
+    }
+
     // Input side is now ok and waiting for us to complete. We build our corba channel element too
     // and connect it to the remote side and vice versa.
     CRemoteChannelElement_i*  local =
         static_cast<CorbaTypeTransporter*>(type->getProtocol(ORO_CORBA_PROTOCOL_ID))
                             ->createChannelElement_i(output_port.getInterface(), mpoa, policy.pull);
 
+    local->setBatchPolicy(local_policy);
     CRemoteChannelElement_var proxy = local->_this();
     local->setRemoteSide(remote);
     remote->setRemoteSide(proxy.in());
@@ -236,6 +256,20 @@ DataSourceBase::shared_ptr RemoteOutputPort::getDataSource() const
     return DataSourceBase::shared_ptr();
 }
 
+bool RemoteOutputPort::connectRemote( CDataFlowInterface_ptr cdfi, std::string const& sink_name, CConnPolicy& cpolicy, RTT::ConnPolicy const& policy )
+{
+    if ( policy.batch_size > 1 ) {
+        try {
+            return dataflow->createBatchedConnection( this->getName().c_str(), cdfi, sink_name.c_str(), cpolicy, toCORBABatch(policy) );
+        }
+        catch(CORBA::BAD_OPERATION&)
+        {
+            log(Warning) << "Remote port " << getName() << " was built against an RTT without batched data flow: sending one sample per call." << endlog();
+        }
+    }
+    return dataflow->createConnection( this->getName().c_str(), cdfi, sink_name.c_str(), cpolicy );
+}
+
 bool RemoteOutputPort::createConnection( RTT::base::InputPortInterface& sink, RTT::ConnPolicy const& policy )
 {
     try {
@@ -244,7 +278,7 @@ bool RemoteOutputPort::createConnection( RTT::base::InputPortInterface& sink, RT
         RemoteInputPort* rip = dynamic_cast<RemoteInputPort*>(&sink);
         if ( rip ){
             CDataFlowInterface_var cdfi = rip->getDataFlowInterface();
-            if ( dataflow->createConnection( this->getName().c_str(), cdfi.in() , sink.getName().c_str(), cpolicy ) ) {
+            if ( connectRemote( cdfi.in(), sink.getName(), cpolicy, policy ) ) {
                 policy.name_id = cpolicy.name_id;
                 return true;
             } else
@@ -253,7 +287,7 @@ bool RemoteOutputPort::createConnection( RTT::base::InputPortInterface& sink, RT
         // !!! only if sink is local:
         // this dynamic CDataFlowInterface lookup is tricky, we re/ab-use the DataFlowInterface pointer of sink !
         CDataFlowInterface_ptr cdfi = CDataFlowInterface_i::getRemoteInterface( sink.getInterface(), mpoa.in() );
-        if ( dataflow->createConnection( this->getName().c_str(), cdfi , sink.getName().c_str(), cpolicy ) ) {
+        if ( connectRemote( cdfi, sink.getName(), cpolicy, policy ) ) {
             policy.name_id = cpolicy.name_id;
             return true;
         }
@@ -96,6 +96,14 @@ namespace RTT {
         class RemoteOutputPort
             : public RemotePort<base::OutputPortInterface>
         {
+            /**
+             * Asks the remote output port to connect to \a cdfi, with
+             * createBatchedConnection() if \a policy sets a batch_size.
+             * Falls back to an unbatched connection if the remote side
+             * does not know batching.
+             */
+            bool connectRemote( CDataFlowInterface_ptr cdfi, std::string const& sink_name,
+                                CConnPolicy& cpolicy, ConnPolicy const& policy );
         public:
             RemoteOutputPort(types::TypeInfo const* type_info,
                     CDataFlowInterface_ptr dataflow,
@@ -55,6 +55,7 @@
 #include "TaskContextI.h"
 #include "DataFlowI.h"
 #include "POAUtility.h"
+#include "CorbaDispatcher.hpp"
 #include <iostream>
 #include <fstream>
 
@@ -143,6 +144,11 @@ namespace RTT
 //                                                               std::string(taskc->getName() + "OBJPOA").c_str(),
 //                                                               0, 0); // Not persistent, allow implicit.
 
+            // Export the dispatcher statistics before the servant reads the interface.
+            if ( !taskc->provides()->hasOperation("dumpCorbaDispatcherStatistics") )
+                taskc->addOperation("dumpCorbaDispatcherStatistics", &CorbaDispatcher::dumpStatistics, ClientThread)
+                    .doc("Describes the queue statistics (depth, max depth, dispatched) of each CORBA dispatcher thread.");
+
             // The servant : TODO : cleanup servant in destructor !
             RTT_corba_CTaskContext_i* serv;
             mtask_i = serv = new RTT_corba_CTaskContext_i( taskc, mpoa );
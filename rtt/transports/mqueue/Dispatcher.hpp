@@ -42,8 +42,30 @@
 #include "../../base/ChannelElementBase.hpp"
 #include "../../Logger.hpp"
 #include <map>
-#include <sys/select.h>
 #include <mqueue.h>
+#include <errno.h>
+#include <cstring>
+#include <unistd.h>
+
+/**
+ * POSIX message queue descriptors are file descriptors on Linux,
+ * so the dispatcher can monitor them with epoll instead of select().
+ * Define ORO_MQUEUE_USE_SELECT to force the use of select().
+ */
+#if defined(OROPKG_OS_GNULINUX) && !defined(ORO_MQUEUE_USE_SELECT)
+#define ORO_MQUEUE_USE_EPOLL
+#include <sys/epoll.h>
+#else
+#include <sys/select.h>
+#endif
+
+/**
+ * The maximum number of ready message queues the dispatcher
+ * handles per wake up when using epoll.
+ */
+#ifndef ORONUM_MQUEUE_DISPATCH_EVENTS
+#define ORONUM_MQUEUE_DISPATCH_EVENTS 64
+#endif
 
 namespace RTT { namespace mqueue { class Dispatcher; } }
 
@@ -58,6 +80,11 @@ namespace RTT {
          * received new data.
          * Reasonably, there should be one dispatcher for each
          * peer component sending us data.
+         *
+         * On Linux, the message queues are monitored with epoll,
+         * which has no limit on the number or value of the descriptors
+         * and only returns the queues that are ready. On other systems,
+         * select() is used.
          */
         class Dispatcher : public Activity
         {
@@ -69,9 +96,13 @@ namespace RTT {
             typedef std::map<mqd_t,base::ChannelElementBase*> MQMap;
             MQMap mqmap;
 
+#ifdef ORO_MQUEUE_USE_EPOLL
+            int epollfd;         /* The epoll instance that monitors all queues of mqmap */
+#else
             fd_set socks;        /* Socket file descriptors we want to wake up for, using select() */
 
             int highsock;        /* Highest #'d file descriptor, needed for select() */
+#endif
 
             bool do_exit;
 
@@ -79,16 +110,53 @@ namespace RTT {
 
             Dispatcher( const std::string& name)
             : Activity(ORO_SCHED_RT, os::HighestPriority, 0.0, 0, name),
-              highsock(0), do_exit(false)
-              {}
+#ifdef ORO_MQUEUE_USE_EPOLL
+              epollfd( epoll_create1(EPOLL_CLOEXEC) ),
+#else
+              highsock(0),
+#endif
+              do_exit(false)
+              {
+#ifdef ORO_MQUEUE_USE_EPOLL
+                  if ( epollfd == -1 )
+                      log(Error) << "Dispatcher failed to create epoll instance: " << strerror(errno) << endlog();
+#endif
+              }
 
             ~Dispatcher() {
                 Logger::In in("Dispatcher");
                 log(Info) << "Dispacher cleans up: no more work."<<endlog();
                 stop();
+#ifdef ORO_MQUEUE_USE_EPOLL
+                if ( epollfd != -1 )
+                    close( epollfd );
+#endif
                 DispatchI = 0;
             }
 
+            /**
+             * Signals the channel of the queue \a it points to in mqmap.
+             * The channel reads one message,
+             * or up to the batch_size of its ConnPolicy.
+             * Must be called with maplock held.
+             */
+            void dispatch(MQMap::iterator it) {
+                //log(Debug) << "New data on " << it->first <<endlog();
+                it->second->signal();
+            }
+
+#ifdef ORO_MQUEUE_USE_EPOLL
+            void read_events(struct epoll_event* events, int count) {
+                /* Only the ready queues are returned. A queue may have been
+                   removed in the meantime, in which case it is no longer in the map. */
+                os::MutexLock lock(maplock);
+                for (int i = 0; i < count; ++i) {
+                    MQMap::iterator it = mqmap.find( mqd_t(events[i].data.fd) );
+                    if ( it != mqmap.end() )
+                        dispatch(it);
+                }
+            }
+#else
             void build_select_list() {
 
                 /* First put together fd_set for select(), which will
@@ -122,11 +190,11 @@ namespace RTT {
                 os::MutexLock lock(maplock);
                 for (MQMap::iterator it = mqmap.begin(); it != mqmap.end(); ++it) {
                     if ( FD_ISSET( it->first, &socks) ) {
-                        //log(Debug) << "New data on " << it->first <<endlog();
-                        it->second->signal();
+                        dispatch(it);
                     }
                 }
             }
+#endif
 
         public:
             typedef boost::intrusive_ptr<Dispatcher> shared_ptr;
@@ -148,8 +216,17 @@ namespace RTT {
                 log(Debug) <<"Dispatcher is monitoring mqdes "<< mqdes <<endlog();
                 os::MutexLock lock(maplock);
                 // we add a refcount per channel we monitor.
-                if (mqmap.count(mqdes) == 0)
+                if (mqmap.count(mqdes) == 0) {
                     refcount.inc();
+#ifdef ORO_MQUEUE_USE_EPOLL
+                    struct epoll_event event;
+                    event.events = EPOLLIN;
+                    event.data.u64 = 0;
+                    event.data.fd = int(mqdes);
+                    if ( epoll_ctl( epollfd, EPOLL_CTL_ADD, int(mqdes), &event) == -1 )
+                        log(Error) <<"Dispatcher failed to monitor mqdes "<< mqdes << ": " << strerror(errno) <<endlog();
+#endif
+                }
                 mqmap[mqdes] = chan;
             }
 
@@ -158,6 +235,10 @@ namespace RTT {
                 log(Debug) <<"Dispatcher drops mqdes "<< mqdes <<endlog();
                 os::MutexLock lock(maplock);
                 if (mqmap.count(mqdes)) {
+#ifdef ORO_MQUEUE_USE_EPOLL
+                    struct epoll_event event; // ignored, but may not be null on older kernels.
+                    epoll_ctl( epollfd, EPOLL_CTL_DEL, int(mqdes), &event);
+#endif
                     mqmap.erase( mqmap.find(mqdes) );
                     refcount.dec();
                 }
@@ -168,6 +249,26 @@ namespace RTT {
                 return true;
             }
 
+#ifdef ORO_MQUEUE_USE_EPOLL
+            void loop() {
+                struct epoll_event events[ORONUM_MQUEUE_DISPATCH_EVENTS];
+                int readsocks;       /* Number of queues ready for reading */
+                while (1) { /* epoll loop */
+                    /* Wake up every 50ms to check do_exit. */
+                    readsocks = epoll_wait(epollfd, events, ORONUM_MQUEUE_DISPATCH_EVENTS, 50);
+
+                    if (readsocks < 0 && errno != EINTR) {
+                        log(Error) <<"Dispatcher failed to wait on message queues. Stopped thread."<<endlog();
+                        return;
+                    }
+                    if (readsocks > 0)
+                        read_events(events, readsocks);
+
+                    if ( do_exit )
+                        return;
+                } /* while(1) */
+            }
+#else
             void loop() {
                 struct timeval timeout;  /* Timeout for select */
                 int readsocks;       /* Number of sockets ready for reading */
@@ -204,6 +305,7 @@ namespace RTT {
                         return;
                 } /* while(1) */
             }
+#endif
 
             bool breakLoop() {
                 do_exit = true;
@@ -212,4 +314,3 @@ namespace RTT {
         };
     }
 }
-
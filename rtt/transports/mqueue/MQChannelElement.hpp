@@ -126,7 +126,9 @@ namespace RTT
              * In the sending case, signal could trigger a dispatcher thread
              * that does the read/write cycle, but that seems only causing overhead.
              * The receiving case must use a thread which blocks on all mq
-             * file descriptors.
+             * file descriptors. If the ConnPolicy set a batch_size, the
+             * receiver reads all waiting messages, up to batch_size, and
+             * signals the input port once for the whole batch.
              * @return true in case the forwarding could be done, false otherwise.
              */
             bool signal()
@@ -142,8 +144,23 @@ namespace RTT
                 } else {
                     typename base::ChannelElement<T>::shared_ptr output =
                         this->getOutput();
-                    if (output && mqRead(read_sample))
+                    if ( !output || !mqRead(read_sample) )
+                        return false;
+                    if ( mbatch_size < 2 )
                         return output->write(read_sample->rvalue());
+                    // only read the messages that are waiting, since the read blocks.
+                    bool result = output->writeWithoutSignal(read_sample->rvalue());
+                    int count = 1;
+                    int pending = mqPending();
+                    while ( result && pending > 0 && count < mbatch_size ) {
+                        if ( !mqRead(read_sample) )
+                            break;
+                        result = output->writeWithoutSignal(read_sample->rvalue());
+                        ++count;
+                        if ( --pending == 0 )
+                            pending = mqPending();
+                    }
+                    return output->signal() && result;
                 }
                 return false;
             }
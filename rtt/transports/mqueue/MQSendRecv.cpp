@@ -61,7 +61,7 @@ using namespace RTT::mqueue;
 
 
 MQSendRecv::MQSendRecv(types::TypeMarshaller const& transport) :
-    mtransport(transport), marshaller_cookie(0), buf(0), mis_sender(false), minit_done(false), max_size(0), mdata_size(0)
+    mtransport(transport), marshaller_cookie(0), buf(0), mis_sender(false), minit_done(false), max_size(0), mdata_size(0), mbatch_size(0)
 {
 }
 
@@ -71,6 +71,7 @@ void MQSendRecv::setupStream(base::DataSourceBase::shared_ptr ds, base::PortInte
     Logger::In in("MQSendRecv");
 
     mdata_size = policy.data_size;
+    mbatch_size = policy.batch_size;
     max_size = policy.data_size ? policy.data_size : mtransport.getSampleSize(ds);
     marshaller_cookie = mtransport.createCookie();
     mis_sender = is_sender;
@@ -181,8 +182,13 @@ void MQSendRecv::cleanupStream()
 void MQSendRecv::mqNewSample(RTT::base::DataSourceBase::shared_ptr ds)
 {
     // only deduce if user did not specify it explicitly:
-    if (mdata_size == 0)
-        max_size = mtransport.getSampleSize(ds);
+    if (mdata_size == 0) {
+        int new_size = mtransport.getSampleSize(ds);
+        // keep the current buffer if the sample size did not change.
+        if (buf && new_size == max_size)
+            return;
+        max_size = new_size;
+    }
     delete[] buf;
     buf = new char[max_size];
     memset(buf, 0, max_size); // necessary to trick valgrind
@@ -251,6 +257,14 @@ bool MQSendRecv::mqRead(RTT::base::DataSourceBase::shared_ptr ds)
     return false;
 }
 
+int MQSendRecv::mqPending()
+{
+    struct mq_attr attr;
+    if (mq_getattr(mqdes, &attr) == -1)
+        return 0;
+    return attr.mq_curmsgs;
+}
+
 bool MQSendRecv::mqWrite(RTT::base::DataSourceBase::shared_ptr ds)
 {
     std::pair<void const*, int> blob = mtransport.fillBlob(ds, buf, max_size, marshaller_cookie);
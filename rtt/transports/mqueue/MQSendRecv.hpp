@@ -100,6 +100,12 @@ namespace RTT
              * that size was zero.
              */
             int mdata_size;
+            /**
+             * The maximum number of messages that are read in one batch,
+             * as specified in the ConnPolicy. Batching is off when it is
+             * less than two.
+             */
+            int mbatch_size;
 
         public:
             /**
@@ -135,6 +141,12 @@ namespace RTT
              */
             bool mqRead(base::DataSourceBase::shared_ptr ds);
 
+            /**
+             * Returns the number of messages waiting in the message queue.
+             * @return zero if the queue is empty or could not be queried.
+             */
+            int mqPending();
+
             /**
              * Write to the message queue
              * @param ds the data sample to write
@@ -48,9 +48,7 @@
 
 #include "MQTemplateProtocolBase.hpp"
 #include "binary_data_archive.hpp"
-#include <boost/iostreams/stream.hpp>
-#include <boost/iostreams/device/array.hpp>
-#include <iostream>
+#include <cstring>
 namespace RTT
 {
 
@@ -67,15 +65,11 @@ namespace RTT
 
             virtual std::pair<void const*,int> fillBlob( base::DataSourceBase::shared_ptr source, void* blob, int size, void* cookie) const
             {
-                namespace io = boost::iostreams;
                 typename internal::DataSource<T>::shared_ptr d = boost::dynamic_pointer_cast< internal::DataSource<T> >( source );
                 if ( d ) {
-                    // we use the boost iostreams library for re-using the blob buffer in the stream object.
-                    // and the serialization library to write the data into stream.
-                    io::stream<io::array_sink>  outbuf( (char*)blob, size);
-                    binary_data_oarchive out( outbuf );
-                    out << d->rvalue();
-                    return std::make_pair( blob, out.getArchiveSize() );
+                    int written = saveSample( d->rvalue(), blob, size, is_fixed_size_sample<T>() );
+                    if (written >= 0)
+                        return std::make_pair( blob, written );
                 }
                 return std::make_pair((void*)0,int(0));
             }
@@ -84,31 +78,71 @@ namespace RTT
             * Update \a target with the contents of \a blob which is an object of a \a protocol.
             */
             virtual bool updateFromBlob(const void* blob, int size, base::DataSourceBase::shared_ptr target, void* cookie) const {
-                namespace io = boost::iostreams;
                 typename internal::AssignableDataSource<T>::shared_ptr ad = internal::AssignableDataSource<T>::narrow( target.get() );
                 if ( ad ) {
-                    io::stream<io::array_source>  inbuf((const char*)blob, size);
-                    binary_data_iarchive in( inbuf );
-                    in >> ad->set();
-                    return true;
+                    return loadSample( ad->set(), blob, size, is_fixed_size_sample<T>() );
                 }
                 return false;
             }
 
             virtual unsigned int getSampleSize(base::DataSourceBase::shared_ptr sample, void* cookie) const {
+                // fixed size types don't need to look at the sample at all.
+                if ( is_fixed_size_sample<T>::value )
+                    return fixed_size_sample<T>::size;
                 typename internal::DataSource<T>::shared_ptr tsample = boost::dynamic_pointer_cast< internal::DataSource<T> >( sample );
                 if ( ! tsample ) {
                     log(Error) << "getSampleSize: sample has wrong type."<<endlog();
                     return 0;
                 }
-                namespace io = boost::iostreams;
-                char sink[1];
-                io::stream<io::array_sink>  outbuf(sink,1);
-                binary_data_oarchive out( outbuf, false );
-                out << tsample->get();
-                //std::cout << "sample size is "<< tsample->rvalue().size() <<" archive is " << out.getArchiveSize() <<std::endl; //disable all types but std::vector<double> for this to compile
+                binary_data_sizer sizer;
+                sizer << tsample->rvalue();
+                return sizer.getArchiveSize();
+            }
+
+        private:
+            /**
+             * Fixed size samples are copied without the archive, but in the
+             * same bytes as binary_data_oarchive writes them.
+             * @return the number of bytes written or -1 if the blob is too small.
+             */
+            static int saveSample(T const& sample, void* blob, int size, boost::mpl::true_) {
+                if ( size < int(fixed_size_sample<T>::size) )
+                    return -1;
+                fixed_size_sample<T>::save( sample, static_cast<char*>(blob) );
+                return fixed_size_sample<T>::size;
+            }
+
+            /**
+             * All other samples are written with the binary_data_oarchive.
+             * @return the number of bytes written.
+             */
+            static int saveSample(T const& sample, void* blob, int size, boost::mpl::false_) {
+                // the archive writes straight into the blob, without a stream in between.
+                binary_data_oarchive out( blob, size );
+                out << sample;
                 return out.getArchiveSize();
             }
+
+            /**
+             * Fixed size samples are read without the archive. Other blobs,
+             * such as a boost::array with less elements, are read by the
+             * archive, which rejects truncated ones.
+             */
+            static bool loadSample(T& sample, const void* blob, int size, boost::mpl::true_) {
+                if ( size == int(fixed_size_sample<T>::size) && fixed_size_sample<T>::load( sample, static_cast<const char*>(blob) ) )
+                    return true;
+                try {
+                    return loadSample( sample, blob, size, boost::mpl::false_() );
+                } catch ( boost::archive::archive_exception& ) {
+                    return false;
+                }
+            }
+
+            static bool loadSample(T& sample, const void* blob, int size, boost::mpl::false_) {
+                binary_data_iarchive in( blob, size );
+                in >> sample;
+                return true;
+            }
         };
 
     }
@@ -77,6 +77,13 @@
 #include <boost/archive/archive_exception.hpp>
 #include <boost/config.hpp>
 #include <boost/mpl/bool.hpp>
+#include <boost/array.hpp>
+#include <boost/serialization/collection_size_type.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <vector>
+#include <string>
+#include "../../types/carray.hpp"
 
 // binary_data_archive API changed at 1.42, 1.46
 #include <boost/version.hpp>
@@ -89,6 +96,15 @@ namespace RTT
     namespace mqueue
     {
 
+        /**
+         * Type trait which is true for element types of which collections
+         * are stored as one contiguous block of memory by the binary data
+         * archives. std::vector<bool> is not contiguous, so bool is excluded.
+         */
+        template<class T>
+        struct is_bulk_primitive
+            : public boost::mpl::bool_< boost::is_arithmetic<T>::value && !boost::is_same<T,bool>::value > {};
+
         /**
          * This archive is capable of loading objects of
          * serialization level 1 and 2 from a binary, non-portable format.
@@ -97,7 +113,9 @@ namespace RTT
          */
         class binary_data_iarchive
         {
-            std::streambuf& m_sb;
+            std::streambuf* m_sb;
+            const char* m_blob;
+            std::size_t m_blob_size;
             int data_read;
         public:
             typedef char Elem;
@@ -117,7 +135,7 @@ namespace RTT
              * @param os The stream to serialize from.
              */
             binary_data_iarchive(std::streambuf& bsb) :
-                m_sb(bsb), data_read(0)
+                m_sb(&bsb), m_blob(0), m_blob_size(0), data_read(0)
             {
             }
 
@@ -126,7 +144,18 @@ namespace RTT
              * @param os The buffer to serialize from.
              */
             binary_data_iarchive(std::istream& is) :
-                m_sb(*is.rdbuf()), data_read(0)
+                m_sb(is.rdbuf()), m_blob(0), m_blob_size(0), data_read(0)
+            {
+            }
+
+            /**
+             * Constructor from a block of memory. The data is copied
+             * straight out of \a blob, without any stream buffer in between.
+             * @param blob The memory to serialize from.
+             * @param size The number of bytes available in \a blob.
+             */
+            binary_data_iarchive(const void* blob, std::size_t size) :
+                m_sb(0), m_blob(static_cast<const char*>(blob)), m_blob_size(size), data_read(0)
             {
             }
 
@@ -210,6 +239,86 @@ namespace RTT
                 *this >> tmp;
             }
 
+            /**
+             * Specialisation for std::vector: primitive elements are read
+             * in one bulk copy after the element count.
+             */
+            template<class T, class A>
+            void load_override(std::vector<T,A> &t, int)
+            {
+                load_vector(t, is_bulk_primitive<T>());
+            }
+
+            /**
+             * Specialisation for boost::array: primitive elements are read
+             * in one bulk copy after the element count.
+             */
+            template<class T, std::size_t N>
+            void load_override(boost::array<T,N> &t, int)
+            {
+                load_boost_array(t, is_bulk_primitive<T>());
+            }
+
+            /**
+             * Specialisation for std::string: the characters are read
+             * in one bulk copy after the character count.
+             */
+            void load_override(std::string &t, int)
+            {
+                boost::serialization::collection_size_type count;
+                *this >> count;
+                check_blob(count);
+                t.resize(count);
+                if ( !t.empty() )
+                    load_binary(&t[0], t.size());
+            }
+
+            /**
+             * Specialisation for types::carray: the elements are read
+             * without element count, like a make_array() wrapper.
+             */
+            template<class T>
+            void load_override(types::carray<T> &t, int)
+            {
+                boost::serialization::array<T> tmp(t.address(), t.count());
+                *this >> tmp;
+            }
+
+            template<class T, class A>
+            void load_vector(std::vector<T,A> &t, boost::mpl::true_)
+            {
+                boost::serialization::collection_size_type count;
+                *this >> count;
+                check_blob(count, sizeof(T));
+                t.resize(count);
+                if ( !t.empty() )
+                    load_binary(&t[0], t.size() * sizeof(T));
+            }
+
+            template<class T, class A>
+            void load_vector(std::vector<T,A> &t, boost::mpl::false_)
+            {
+                load_a_type(t, boost::mpl::false_());
+            }
+
+            template<class T, std::size_t N>
+            void load_boost_array(boost::array<T,N> &t, boost::mpl::true_)
+            {
+                boost::serialization::collection_size_type count;
+                *this >> count;
+                if ( static_cast<std::size_t>(count) > N )
+                    boost::serialization::throw_exception(
+                            boost::archive::archive_exception(
+                                    boost::archive::archive_exception::array_size_too_short));
+                load_binary(t.c_array(), count * sizeof(T));
+            }
+
+            template<class T, std::size_t N>
+            void load_boost_array(boost::array<T,N> &t, boost::mpl::false_)
+            {
+                load_a_type(t, boost::mpl::false_());
+            }
+
             /**
              * Loading Archive Concept::operator>>
              * @param t The type to load.
@@ -231,6 +340,26 @@ namespace RTT
                 return this->operator>>(t);
             }
 
+            /**
+             * Throws if the blob has less than \a count elements of
+             * \a size bytes left. The lengths in the blob are checked
+             * with this before anything is allocated for them, such that
+             * a corrupt blob can not make the archive allocate without bound.
+             */
+            void check_blob(std::size_t count, std::size_t size = 1) const
+            {
+                if (m_blob && count > (m_blob_size - data_read) / size)
+#if BOOST_VERSION >= 104400
+                    boost::serialization::throw_exception(
+                            boost::archive::archive_exception(
+                                    boost::archive::archive_exception::input_stream_error));
+#else
+                    boost::serialization::throw_exception(
+                            boost::archive::archive_exception(
+                                    boost::archive::archive_exception::stream_error));
+#endif
+            }
+
             /**
              * Loading Archive Concept::load_binary(u, count)
              * @param address The place in memory where data must be written.
@@ -238,9 +367,15 @@ namespace RTT
              */
             void load_binary(void *address, std::size_t count)
             {
+                if (m_blob) {
+                    check_blob(count);
+                    std::memcpy(address, m_blob + data_read, count);
+                    data_read += count;
+                    return;
+                }
                 // note: an optimizer should eliminate the following for char files
                 std::streamsize s = count / sizeof(Elem);
-                std::streamsize scount = m_sb.sgetn(
+                std::streamsize scount = m_sb->sgetn(
                         static_cast<Elem *> (address), s);
                 if (scount != static_cast<std::streamsize> (s))
 #if BOOST_VERSION >= 104400
@@ -261,7 +396,7 @@ namespace RTT
                     //                archive_exception(archive_exception::stream_error)
                     //        );
                     Elem t;
-                    scount = m_sb.sgetn(&t, 1);
+                    scount = m_sb->sgetn(&t, 1);
                     if (scount != 1)
 #if BOOST_VERSION >= 104400
                         boost::serialization::throw_exception(
@@ -343,7 +478,9 @@ namespace RTT
          */
         class binary_data_oarchive
         {
-            std::streambuf & m_sb;
+            std::streambuf* m_sb;
+            char* m_blob;
+            std::size_t m_blob_size;
             int data_written;
             bool mdo_save;
         public:
@@ -366,7 +503,7 @@ namespace RTT
              * in advance how much space you will need.
              */
             binary_data_oarchive(std::ostream& os,bool do_save = true) :
-                m_sb(*os.rdbuf()), data_written(0), mdo_save(do_save)
+                m_sb(os.rdbuf()), m_blob(0), m_blob_size(0), data_written(0), mdo_save(do_save)
             {
             }
 
@@ -379,7 +516,18 @@ namespace RTT
              * in advance how much space you will need.
              */
             binary_data_oarchive(std::streambuf& sb,bool do_save = true) :
-                m_sb(sb), data_written(0), mdo_save(do_save)
+                m_sb(&sb), m_blob(0), m_blob_size(0), data_written(0), mdo_save(do_save)
+            {
+            }
+
+            /**
+             * Constructor from a block of memory. The data is copied
+             * straight into \a blob, without any stream buffer in between.
+             * @param blob The memory to serialize to.
+             * @param size The number of bytes available in \a blob.
+             */
+            binary_data_oarchive(void* blob, std::size_t size) :
+                m_sb(0), m_blob(static_cast<char*>(blob)), m_blob_size(size), data_written(0), mdo_save(true)
             {
             }
 
@@ -421,6 +569,45 @@ namespace RTT
                     return save_a_type(t,boost::mpl::bool_< boost::serialization::implementation_level<T>::value == boost::serialization::primitive_type>() );
             }
 
+            /**
+             * Specialisation for std::vector: primitive elements are written
+             * in one bulk copy after the element count.
+             */
+            template<class T, class A>
+            binary_data_oarchive &operator<<(std::vector<T,A> const &t){
+                    return save_vector(t, is_bulk_primitive<T>());
+            }
+
+            /**
+             * Specialisation for boost::array: primitive elements are written
+             * in one bulk copy after the element count.
+             */
+            template<class T, std::size_t N>
+            binary_data_oarchive &operator<<(boost::array<T,N> const &t){
+                    return save_boost_array(t, is_bulk_primitive<T>());
+            }
+
+            /**
+             * Specialisation for std::string: the characters are written
+             * in one bulk copy after the character count.
+             */
+            binary_data_oarchive &operator<<(std::string const &t){
+                    const boost::serialization::collection_size_type count(t.size());
+                    *this << count;
+                    if ( !t.empty() )
+                        save_binary(t.data(), t.size());
+                    return *this;
+            }
+
+            /**
+             * Specialisation for types::carray: the elements are written
+             * without element count, like a make_array() wrapper.
+             */
+            template<class T>
+            binary_data_oarchive &operator<<(types::carray<T> const &t){
+                    return save_carray(t, is_bulk_primitive<T>());
+            }
+
             /**
              * Saving Archive Concept::operator&
              * @param t The type to save.
@@ -440,8 +627,20 @@ namespace RTT
             {
                 // figure number of elements to output - round up
                 count = (count + sizeof(Elem) - 1) / sizeof(Elem);
-                if (mdo_save) {
-                    std::streamsize scount = m_sb.sputn(
+                if (m_blob) {
+                    if (data_written + count > m_blob_size)
+#if BOOST_VERSION >= 104400
+                        boost::serialization::throw_exception(
+                                boost::archive::archive_exception(
+                                        boost::archive::archive_exception::output_stream_error));
+#else
+                        boost::serialization::throw_exception(
+                                boost::archive::archive_exception(
+                                        boost::archive::archive_exception::stream_error));
+#endif
+                    std::memcpy(m_blob + data_written, address, count);
+                } else if (mdo_save) {
+                    std::streamsize scount = m_sb->sputn(
                             static_cast<const Elem *> (address), count);
                     if (count != static_cast<std::size_t> (scount))
 #if BOOST_VERSION >= 104400
@@ -494,6 +693,45 @@ namespace RTT
                   return *this;
             }
 
+            template<class T, class A>
+            binary_data_oarchive &save_vector(std::vector<T,A> const &t,boost::mpl::true_){
+                  const boost::serialization::collection_size_type count(t.size());
+                  *this << count;
+                  if ( !t.empty() )
+                      save_binary(&t[0], t.size() * sizeof(T));
+                  return *this;
+            }
+
+            template<class T, class A>
+            binary_data_oarchive &save_vector(std::vector<T,A> const &t,boost::mpl::false_){
+                  return save_a_type(t, boost::mpl::false_());
+            }
+
+            template<class T, std::size_t N>
+            binary_data_oarchive &save_boost_array(boost::array<T,N> const &t,boost::mpl::true_){
+                  const boost::serialization::collection_size_type count(N);
+                  *this << count;
+                  save_binary(t.data(), N * sizeof(T));
+                  return *this;
+            }
+
+            template<class T, std::size_t N>
+            binary_data_oarchive &save_boost_array(boost::array<T,N> const &t,boost::mpl::false_){
+                  return save_a_type(t, boost::mpl::false_());
+            }
+
+            template<class T>
+            binary_data_oarchive &save_carray(types::carray<T> const &t,boost::mpl::true_){
+                  if ( t.count() )
+                      save_binary(t.address(), t.count() * sizeof(T));
+                  return *this;
+            }
+
+            template<class T>
+            binary_data_oarchive &save_carray(types::carray<T> const &t,boost::mpl::false_){
+                  return *this << boost::serialization::make_array(t.address(), t.count());
+            }
+
             /**
              * We provide an optimized load for all fundamental types
              * typedef serialization::is_bitwise_serializable<mpl::_1> use_array_optimization;
@@ -525,10 +763,285 @@ namespace RTT
              */
             int getArchiveSize() { return data_written; }
         };
+
+        /**
+         * This archive computes how many bytes binary_data_oarchive
+         * would write for an object, without requiring or touching a
+         * stream. It follows exactly the same dispatching rules as
+         * binary_data_oarchive, such that both always agree on the size.
+         * @see binary_data_oarchive
+         */
+        class binary_data_sizer
+        {
+            int data_written;
+        public:
+            typedef char Elem;
+            /**
+             * Saving Archive Concept::is_loading
+             */
+            typedef boost::mpl::bool_<false> is_loading;
+            /**
+             * Saving Archive Concept::is_saving
+             */
+            typedef boost::mpl::bool_<true> is_saving;
+
+            binary_data_sizer() :
+                data_written(0)
+            {
+            }
+
+            /**
+             * Saving Archive Concept::get_library_version()
+             * @return This library's version.
+             */
+            unsigned int get_library_version() { return 0; }
+
+            /**
+             * Saving Archive Concept::register_type<T>() and ::register_type(u)
+             * @param The data type to register in this archive.
+             * @return
+             */
+            template<class T>
+            const boost::archive::detail::basic_pointer_iserializer *
+            register_type(T * = NULL) {return 0;}
+
+            /**
+             * Note: not in LoadArchive concept but required when we use archive::save !
+             * @param x
+             * @param bos
+             */
+            void save_object(
+                const void *x,
+                const boost::archive::detail::basic_oserializer & bos
+            ) {
+                assert(false);
+            }
+
+            /**
+             * Saving Archive Concept::operator<<
+             * @param t The type to size.
+             * @return *this
+             */
+            template<class T>
+            binary_data_sizer &operator<<(T const &t){
+                    return save_a_type(t,boost::mpl::bool_< boost::serialization::implementation_level<T>::value == boost::serialization::primitive_type>() );
+            }
+
+            /**
+             * Specialisation for std::vector, see binary_data_oarchive.
+             */
+            template<class T, class A>
+            binary_data_sizer &operator<<(std::vector<T,A> const &t){
+                    return save_collection(t, t.size(), is_bulk_primitive<T>());
+            }
+
+            /**
+             * Specialisation for boost::array, see binary_data_oarchive.
+             */
+            template<class T, std::size_t N>
+            binary_data_sizer &operator<<(boost::array<T,N> const &t){
+                    return save_collection(t, N, is_bulk_primitive<T>());
+            }
+
+            /**
+             * Specialisation for std::string, see binary_data_oarchive.
+             */
+            binary_data_sizer &operator<<(std::string const &t){
+                    data_written += sizeof(boost::serialization::collection_size_type) + t.size();
+                    return *this;
+            }
+
+            /**
+             * Specialisation for types::carray, see binary_data_oarchive.
+             */
+            template<class T>
+            binary_data_sizer &operator<<(types::carray<T> const &t){
+                    return save_carray(t, is_bulk_primitive<T>());
+            }
+
+            /**
+             * Saving Archive Concept::operator&
+             * @param t The type to size.
+             * @return *this
+             */
+            template<class T>
+            binary_data_sizer &operator&(T const &t){
+                    return this->operator<<(t);
+            }
+
+            /**
+             * Saving Archive Concept::save_binary(u, count)
+             * Only counts the bytes.
+             * @param address The place where data is located in memory.
+             * @param count The number of bytes to save.
+             */
+            inline void save_binary(const void *address, std::size_t count)
+            {
+                data_written += (count + sizeof(Elem) - 1) / sizeof(Elem);
+            }
+
+            /**
+             * Specialisation for primitive types.
+             * @param t primitive data (bool, int,...)
+             * @return *this
+             */
+            template<class T>
+            binary_data_sizer &save_a_type(T const &t,boost::mpl::true_){
+                  data_written += sizeof(T);
+                  return *this;
+            }
+
+#if BOOST_VERSION >= 104600
+            binary_data_sizer &save_a_type(const boost::serialization::version_type & t,boost::mpl::true_){
+                // not stored by binary_data_oarchive either.
+                return *this;
+            }
+            binary_data_sizer &save_a_type(const boost::serialization::item_version_type & t,boost::mpl::true_){
+                // not stored by binary_data_oarchive either.
+                return *this;
+            }
+#endif
+
+            /**
+             * Specialisation for composite types (objects).
+             * @param t a serializable class or struct.
+             * @return *this
+             */
+            template<class T>
+            binary_data_sizer &save_a_type(T const &t,boost::mpl::false_){
+#if BOOST_VERSION >= 104100
+                  boost::archive::detail::save_non_pointer_type<binary_data_sizer>::save_only::invoke(*this,t);
+#else
+                  boost::archive::detail::save_non_pointer_type<binary_data_sizer,T>::save_only::invoke(*this,t);
+#endif
+                  return *this;
+            }
+
+            /**
+             * Collections of primitives are stored as their element count
+             * followed by the elements.
+             */
+            template<class C>
+            binary_data_sizer &save_collection(C const &t, std::size_t count, boost::mpl::true_){
+                  data_written += sizeof(boost::serialization::collection_size_type) + count * sizeof(typename C::value_type);
+                  return *this;
+            }
+
+            template<class C>
+            binary_data_sizer &save_collection(C const &t, std::size_t count, boost::mpl::false_){
+                  return save_a_type(t, boost::mpl::false_());
+            }
+
+            template<class T>
+            binary_data_sizer &save_carray(types::carray<T> const &t, boost::mpl::true_){
+                  data_written += t.count() * sizeof(T);
+                  return *this;
+            }
+
+            template<class T>
+            binary_data_sizer &save_carray(types::carray<T> const &t, boost::mpl::false_){
+                  return *this << boost::serialization::make_array(t.address(), t.count());
+            }
+
+            /**
+             * We provide an optimized save for all fundamental types
+             * typedef serialization::is_bitwise_serializable<mpl::_1> use_array_optimization;
+             */
+            struct use_array_optimization {
+                template <class T>
+                #if defined(BOOST_NO_DEPENDENT_NESTED_DERIVATIONS)
+                    struct apply {
+                        typedef BOOST_DEDUCED_TYPENAME boost::serialization::is_bitwise_serializable<T>::type type;
+                    };
+                #else
+                    struct apply : public boost::serialization::is_bitwise_serializable<T> {};
+                #endif
+            };
+
+            /**
+             * The optimized save_array only counts the array's size.
+             */
+            template<class ValueType>
+            void save_array(boost::serialization::array<ValueType> const& a,
+                            unsigned int)
+            {
+                data_written += a.count() * sizeof(ValueType);
+            }
+
+            /**
+             * Helper method to say how much we would have written.
+             */
+            int getArchiveSize() { return data_written; }
+        };
+
+        /**
+         * Type trait which is true for types of which binary_data_oarchive
+         * writes a byte stream with a size known at compile time, such that
+         * fixed_size_sample can write and read it without the archive: the
+         * bitwise serializable primitive types and boost::array's of
+         * arithmetic types. Structs are written member by member by the
+         * archive, without their padding, so they are not included.
+         */
+        template<class T>
+        struct is_fixed_size_sample
+            : public boost::mpl::bool_< boost::serialization::implementation_level<T>::value == boost::serialization::primitive_type
+                                        && boost::serialization::is_bitwise_serializable<T>::value > {};
+
+        template<class T, std::size_t N>
+        struct is_fixed_size_sample< boost::array<T,N> >
+            : public is_bulk_primitive<T> {};
+
+        /**
+         * Writes and reads the types of which is_fixed_size_sample is true
+         * as plain memory copies, in the same bytes as binary_data_oarchive.
+         */
+        template<class T>
+        struct fixed_size_sample
+        {
+            static const std::size_t size = sizeof(T);
+
+            static void save(T const& t, char* blob) {
+                std::memcpy( blob, &t, sizeof(T) );
+            }
+
+            static bool load(T& t, const char* blob) {
+                std::memcpy( &t, blob, sizeof(T) );
+                return true;
+            }
+        };
+
+        /**
+         * A boost::array is written as its element count followed by its
+         * elements, like binary_data_oarchive does.
+         */
+        template<class T, std::size_t N>
+        struct fixed_size_sample< boost::array<T,N> >
+        {
+            static const std::size_t size = sizeof(boost::serialization::collection_size_type) + N * sizeof(T);
+
+            static void save(boost::array<T,N> const& t, char* blob) {
+                const boost::serialization::collection_size_type count(N);
+                std::memcpy( blob, &count, sizeof(count) );
+                std::memcpy( blob + sizeof(count), t.data(), N * sizeof(T) );
+            }
+
+            /**
+             * @return false if \a blob holds another number of elements.
+             */
+            static bool load(boost::array<T,N>& t, const char* blob) {
+                boost::serialization::collection_size_type count;
+                std::memcpy( &count, blob, sizeof(count) );
+                if ( static_cast<std::size_t>(count) != N )
+                    return false;
+                std::memcpy( t.c_array(), blob + sizeof(count), N * sizeof(T) );
+                return true;
+            }
+        };
     }
 }
 
 BOOST_SERIALIZATION_USE_ARRAY_OPTIMIZATION(RTT::mqueue::binary_data_oarchive)
 BOOST_SERIALIZATION_USE_ARRAY_OPTIMIZATION(RTT::mqueue::binary_data_iarchive)
+BOOST_SERIALIZATION_USE_ARRAY_OPTIMIZATION(RTT::mqueue::binary_data_sizer)
 
 #endif /* BINARY_DATA_ARCHIVE_HPP_ */
@@ -0,0 +1,163 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  ShmDispatcher.cpp
+
+                        ShmDispatcher.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "ShmDispatcher.hpp"
+#include "ShmSendRecv.hpp"
+#include "../../os/MutexLock.hpp"
+#include "../../Logger.hpp"
+
+namespace RTT {
+    namespace shm {
+        ShmDispatcher* ShmDispatcher::DispatchI = 0;
+        int ShmDispatcher::defaultScheduler = ORO_SCHED_RT;
+        int ShmDispatcher::defaultPriority = os::HighestPriority;
+
+        void intrusive_ptr_add_ref(const RTT::shm::ShmDispatcher* p ) {
+            p->refcount.inc();
+        }
+        void intrusive_ptr_release(const RTT::shm::ShmDispatcher* p ) {
+            if ( p->refcount.dec_and_test() ) delete p;
+        }
+
+        ShmDispatcher::ShmDispatcher( const std::string& name )
+            : Activity(defaultScheduler, defaultPriority, 0.0, 0, name),
+              do_exit(false), mwaiting(false), mwaits(0)
+        {
+        }
+
+        ShmDispatcher::~ShmDispatcher()
+        {
+            Logger::In in("ShmDispatcher");
+            log(Info) << "Dispatcher cleans up: no more work." << endlog();
+            stop();
+            DispatchI = 0;
+        }
+
+        ShmDispatcher::shared_ptr ShmDispatcher::Instance()
+        {
+            if ( DispatchI == 0 ) {
+                DispatchI = new ShmDispatcher("ShmDispatch");
+                DispatchI->start();
+            }
+            return DispatchI;
+        }
+
+        void ShmDispatcher::setPriority( int scheduler, int priority )
+        {
+            defaultScheduler = scheduler;
+            defaultPriority = priority;
+            if ( DispatchI ) {
+                DispatchI->thread()->setScheduler( scheduler );
+                DispatchI->thread()->setPriority( priority );
+            }
+        }
+
+        void ShmDispatcher::addStream( ShmSendRecv* stream, base::ChannelElementBase* chan )
+        {
+            os::MutexLock lock(maplock);
+            if ( mstreams.size() == ShmRing::maxWaitAny() ) {
+                Logger::In in("ShmDispatcher");
+                log(Warning) << "Waiting on more than " << ShmRing::maxWaitAny()
+                             << " shared memory ring(s) in one process: the others are polled every millisecond."
+                             << " Waiting on more than one ring requires futex_waitv(), provided by Linux 5.16 or newer." << endlog();
+            }
+            // we add a refcount per stream we monitor.
+            refcount.inc();
+            mstreams.push_back( std::make_pair(stream, chan) );
+            mrings.reserve( mstreams.size() );
+            mcursors.reserve( mstreams.size() );
+        }
+
+        void ShmDispatcher::removeStream( ShmSendRecv* stream )
+        {
+            os::MutexLock lock(maplock);
+            for (Streams::iterator it = mstreams.begin(); it != mstreams.end(); ++it) {
+                if ( it->first == stream ) {
+                    mstreams.erase( it );
+                    refcount.dec();
+                    break;
+                }
+            }
+            // the dispatcher may still be waiting on the ring of stream.
+            // It may already wait again when we get the lock back, so we
+            // wait for the end of the current wait instead of !mwaiting.
+            if ( mwaiting ) {
+                unsigned int waits = mwaits;
+                stream->mring.wakeUp();
+                while ( mwaits == waits )
+                    mwait_done.wait( maplock );
+            }
+        }
+
+        bool ShmDispatcher::initialize()
+        {
+            do_exit = false;
+            return true;
+        }
+
+        void ShmDispatcher::loop()
+        {
+            maplock.lock();
+            while ( !do_exit ) {
+                mrings.clear();
+                mcursors.clear();
+                for (Streams::iterator it = mstreams.begin(); it != mstreams.end(); ++it) {
+                    if ( it->first->shmPending() )
+                        it->second->signal();
+                    mrings.push_back( &it->first->mring );
+                    mcursors.push_back( it->first->mcursor );
+                }
+                mwaiting = true;
+                maplock.unlock();
+                // Wake up every 50ms to check do_exit.
+                ShmRing::waitAny( mrings.empty() ? 0 : &mrings[0], mcursors.empty() ? 0 : &mcursors[0], mrings.size(), 0.05 );
+                maplock.lock();
+                mwaiting = false;
+                ++mwaits;
+                mwait_done.broadcast();
+            }
+            maplock.unlock();
+        }
+
+        bool ShmDispatcher::breakLoop()
+        {
+            do_exit = true;
+            return true;
+        }
+    }
+}
@@ -0,0 +1,138 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  ShmDispatcher.hpp
+
+                        ShmDispatcher.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_SHM_DISPATCHER_HPP
+#define ORO_SHM_DISPATCHER_HPP
+
+#include "ShmRing.hpp"
+#include "../../os/Mutex.hpp"
+#include "../../os/Condition.hpp"
+#include "../../os/Atomic.hpp"
+#include "../../Activity.hpp"
+#include "../../base/ChannelElementBase.hpp"
+#include <vector>
+
+namespace RTT { namespace shm { class ShmDispatcher; class ShmSendRecv; } }
+
+namespace RTT {
+    namespace shm {
+        RTT_SHM_API void intrusive_ptr_add_ref(const RTT::shm::ShmDispatcher* p );
+        RTT_SHM_API void intrusive_ptr_release(const RTT::shm::ShmDispatcher* p );
+
+        /**
+         * This object waits on the rings of all receiving shared memory
+         * streams of this process, and signals the channel of a ring that
+         * received new samples. There is one dispatcher per process, like
+         * the Dispatcher of the mqueue transport. Its scheduler and
+         * priority can be set with setPriority().
+         *
+         * The dispatcher holds its lock while it signals the channels,
+         * and releases it while it waits on the rings. removeStream()
+         * returns only after the dispatcher stopped waiting on the ring
+         * of the removed stream, such that the stream may close it.
+         */
+        class RTT_SHM_API ShmDispatcher : public Activity
+        {
+            friend void intrusive_ptr_add_ref(const RTT::shm::ShmDispatcher* p );
+            friend void intrusive_ptr_release(const RTT::shm::ShmDispatcher* p );
+            mutable os::AtomicInt refcount;
+            static ShmDispatcher* DispatchI;
+            static int defaultScheduler;
+            static int defaultPriority;
+
+            typedef std::vector< std::pair<ShmSendRecv*, base::ChannelElementBase*> > Streams;
+            Streams mstreams;
+            /**
+             * The rings and cursors the dispatcher waits on,
+             * rebuilt in each iteration of loop().
+             */
+            std::vector<const ShmRing*> mrings;
+            std::vector<ShmRing::Sequence> mcursors;
+
+            bool do_exit;
+            /**
+             * True while the dispatcher waits on mrings without the lock.
+             */
+            bool mwaiting;
+            /**
+             * The number of waits that ended, see removeStream().
+             */
+            unsigned int mwaits;
+
+            os::Mutex maplock;
+            os::Condition mwait_done;
+
+            ShmDispatcher( const std::string& name );
+
+            ~ShmDispatcher();
+
+        public:
+            typedef boost::intrusive_ptr<ShmDispatcher> shared_ptr;
+
+            static ShmDispatcher::shared_ptr Instance();
+
+            /**
+             * Sets the scheduler and priority of the dispatcher thread.
+             * The default is ORO_SCHED_RT at os::HighestPriority. If the
+             * dispatcher is running, its thread is changed as well.
+             */
+            static void setPriority( int scheduler, int priority );
+
+            /**
+             * Starts monitoring the ring of \a stream, and signals
+             * \a chan when samples arrive in it. The rings beyond
+             * ShmRing::maxWaitAny() are polled, see ShmRing::waitAny().
+             */
+            void addStream( ShmSendRecv* stream, base::ChannelElementBase* chan );
+
+            /**
+             * Stops monitoring the ring of \a stream. When this function
+             * returns, the dispatcher no longer uses that ring.
+             * May not be called from within a signal of the dispatcher.
+             */
+            void removeStream( ShmSendRecv* stream );
+
+            bool initialize();
+
+            void loop();
+
+            bool breakLoop();
+        };
+    }
+}
+
+#endif
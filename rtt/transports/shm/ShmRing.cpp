@@ -0,0 +1,457 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  ShmRing.cpp
+
+                        ShmRing.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "ShmRing.hpp"
+#include "../../os/oro_arch.h"
+#include "../../Logger.hpp"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <errno.h>
+#include <climits>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+
+using namespace RTT;
+using namespace RTT::shm;
+
+namespace
+{
+    /** Written last by the creator of a segment, when the header is valid. */
+    const unsigned int ShmRingMagic = 0x4f524e47;
+
+    /** Slots are aligned on cache lines, such that readers of one slot
+     *  do not share a line with the slot the writer is filling. */
+    const unsigned int ShmRingAlignment = 64;
+
+    /** The interval at which waitAny() checks the rings it can not
+     *  wait on with a futex. */
+    const Seconds ShmRingPollPeriod = 0.001;
+
+    inline void memory_barrier()
+    {
+        __sync_synchronize();
+    }
+
+    inline int futex(volatile unsigned int* addr, int op, unsigned int val, const struct timespec* timeout)
+    {
+        return syscall(SYS_futex, addr, op, val, timeout, 0, 0);
+    }
+
+    inline struct timespec toTimespec(Seconds timeout)
+    {
+        struct timespec ts;
+        ts.tv_sec = long(timeout);
+        ts.tv_nsec = long(Seconds_to_nsecs(timeout - ts.tv_sec));
+        return ts;
+    }
+}
+
+/**
+ * The first bytes of a segment. The slots follow it,
+ * at an offset of ShmRingAlignment bytes.
+ */
+struct ShmRing::Header
+{
+    volatile unsigned int magic;
+    unsigned int slot_count;
+    unsigned int slot_size;
+    /** The futex word the readers wait on: the sequence number of the last written sample. */
+    volatile unsigned int write_seq;
+    /** The number of readers blocked in wait(). */
+    oro_atomic_t waiters;
+    /** Set when the writer replaced this segment by a new one. */
+    volatile unsigned int replaced;
+};
+
+struct ShmRing::Slot
+{
+    /** The sequence number of the sample in this slot, zero while it is written. */
+    volatile unsigned int seq;
+    volatile unsigned int size;
+    char data[1];
+};
+
+ShmRing::ShmRing()
+    : mheader(0), mmapped_size(0), mslot_stride(0), mseq_max(0)
+{
+}
+
+ShmRing::~ShmRing()
+{
+    close();
+}
+
+bool ShmRing::map(int fd, size_t size)
+{
+    void* addr = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        log(Error) << "Failed to map shared memory segment of " << size << " bytes: " << strerror(errno) << endlog();
+        return false;
+    }
+    mheader = static_cast<Header*>(addr);
+    mmapped_size = size;
+    return true;
+}
+
+void ShmRing::setGeometry(unsigned int slot_count, unsigned int slot_size)
+{
+    mslot_stride = (offsetof(Slot, data) + slot_size + ShmRingAlignment - 1) / ShmRingAlignment * ShmRingAlignment;
+    mseq_max = UINT_MAX / slot_count * slot_count;
+}
+
+bool ShmRing::create(const std::string& name, unsigned int slot_count, unsigned int slot_size)
+{
+    close();
+    if (slot_count == 0 || slot_size == 0)
+        return false;
+    setGeometry(slot_count, slot_size);
+    size_t size = ShmRingAlignment + size_t(mslot_stride) * slot_count;
+
+    // Re-use a segment with the same geometry, such that attached readers keep on working.
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd != -1) {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && size_t(st.st_size) >= ShmRingAlignment && map(fd, st.st_size)) {
+            if (mheader->magic == ShmRingMagic && !mheader->replaced && size_t(st.st_size) == size
+                && mheader->slot_count == slot_count && mheader->slot_size == slot_size) {
+                ::close(fd);
+                return true;
+            }
+            // Tell the readers of the old segment to attach to the new one.
+            if (mheader->magic == ShmRingMagic) {
+                mheader->replaced = 1;
+                memory_barrier();
+                wakeUp();
+            }
+            munmap(mheader, mmapped_size);
+            mheader = 0;
+            mmapped_size = 0;
+        }
+        ::close(fd);
+        shm_unlink(name.c_str());
+    }
+
+    fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (fd == -1) {
+        log(Error) << "Failed to create shared memory segment '" << name << "': " << strerror(errno) << endlog();
+        close();
+        return false;
+    }
+    // ftruncate() fills the segment with zeros, which clears all slots.
+    if (ftruncate(fd, size) == -1) {
+        log(Error) << "Failed to resize shared memory segment '" << name << "' to " << size << " bytes: " << strerror(errno) << endlog();
+        ::close(fd);
+        shm_unlink(name.c_str());
+        close();
+        return false;
+    }
+    bool mapped = map(fd, size);
+    ::close(fd);
+    if (!mapped) {
+        shm_unlink(name.c_str());
+        close();
+        return false;
+    }
+    mheader->slot_count = slot_count;
+    mheader->slot_size = slot_size;
+    mheader->write_seq = 0;
+    mheader->replaced = 0;
+    ORO_ATOMIC_SETUP(&mheader->waiters, 0);
+    memory_barrier();
+    mheader->magic = ShmRingMagic;
+    return true;
+}
+
+bool ShmRing::attach(const std::string& name)
+{
+    close();
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd == -1)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) == -1 || size_t(st.st_size) < ShmRingAlignment || !map(fd, st.st_size)) {
+        ::close(fd);
+        return false;
+    }
+    ::close(fd);
+    if (mheader->magic != ShmRingMagic || mheader->slot_count == 0) {
+        close();
+        return false;
+    }
+    memory_barrier();
+    setGeometry(mheader->slot_count, mheader->slot_size);
+    if (ShmRingAlignment + size_t(mslot_stride) * mheader->slot_count > mmapped_size) {
+        log(Error) << "Shared memory segment '" << name << "' is smaller than its header claims." << endlog();
+        close();
+        return false;
+    }
+    return true;
+}
+
+void ShmRing::close()
+{
+    if (mheader)
+        munmap(mheader, mmapped_size);
+    mheader = 0;
+    mmapped_size = 0;
+    mslot_stride = 0;
+    mseq_max = 0;
+}
+
+void ShmRing::swap(ShmRing& other)
+{
+    std::swap(mheader, other.mheader);
+    std::swap(mmapped_size, other.mmapped_size);
+    std::swap(mslot_stride, other.mslot_stride);
+    std::swap(mseq_max, other.mseq_max);
+}
+
+bool ShmRing::unlink(const std::string& name)
+{
+    return shm_unlink(name.c_str()) == 0;
+}
+
+unsigned int ShmRing::slotCount() const
+{
+    return mheader ? mheader->slot_count : 0;
+}
+
+unsigned int ShmRing::slotSize() const
+{
+    return mheader ? mheader->slot_size : 0;
+}
+
+bool ShmRing::replaced() const
+{
+    return mheader->replaced != 0;
+}
+
+ShmRing::Sequence ShmRing::latest() const
+{
+    Sequence seq = mheader->write_seq;
+    memory_barrier();
+    return seq;
+}
+
+ShmRing::Sequence ShmRing::next(Sequence seq) const
+{
+    // Zero marks a slot that is being written, so it is never used as sequence number.
+    return seq >= mseq_max ? 1 : seq + 1;
+}
+
+ShmRing::Sequence ShmRing::previous(Sequence seq, unsigned int count) const
+{
+    // zero is the cursor before sequence number 1, and stands for mseq_max.
+    return seq >= count ? seq - count : seq + mseq_max - count;
+}
+
+ShmRing::Slot* ShmRing::slot(Sequence seq) const
+{
+    // mseq_max is a multiple of the slot count, so the slots of
+    // mseq_max and 1 are neighbours.
+    return reinterpret_cast<Slot*>(reinterpret_cast<char*>(mheader) + ShmRingAlignment
+                                   + size_t(mslot_stride) * ((seq - 1) % mheader->slot_count));
+}
+
+char* ShmRing::beginWrite()
+{
+    Slot* s = slot(next(mheader->write_seq));
+    s->seq = 0;
+    memory_barrier();
+    return s->data;
+}
+
+void ShmRing::commitWrite(unsigned int size)
+{
+    Sequence seq = next(mheader->write_seq);
+    Slot* s = slot(seq);
+    s->size = size;
+    memory_barrier();
+    s->seq = seq;
+    memory_barrier();
+    mheader->write_seq = seq;
+    memory_barrier();
+    if (oro_atomic_read(&mheader->waiters) > 0)
+        wakeUp();
+}
+
+const char* ShmRing::beginRead(Sequence cursor, Sequence& next_seq, unsigned int& size) const
+{
+    while (true) {
+        Sequence last = latest();
+        if (last == cursor || last == 0)
+            return 0;
+        // skip the samples that were overwritten since the previous read.
+        // The distance from the cursor 0 is counted from mseq_max.
+        Sequence behind = last >= cursor ? last - cursor : last + mseq_max - cursor;
+        if (behind > mheader->slot_count)
+            cursor = previous(last, mheader->slot_count);
+        next_seq = next(cursor);
+        Slot* s = slot(next_seq);
+        if (s->seq == next_seq) {
+            memory_barrier();
+            size = s->size;
+            if (size <= mheader->slot_size)
+                return s->data;
+        }
+        // the writer is overwriting this sample.
+        cursor = next_seq;
+    }
+}
+
+bool ShmRing::endRead(Sequence next_seq) const
+{
+    memory_barrier();
+    return slot(next_seq)->seq == next_seq;
+}
+
+unsigned int ShmRing::read(Sequence& cursor, char* buf) const
+{
+    Sequence next_seq;
+    unsigned int size;
+    while (const char* data = beginRead(cursor, next_seq, size)) {
+        memcpy(buf, data, size);
+        cursor = next_seq;
+        if (endRead(next_seq))
+            return size;
+    }
+    return 0;
+}
+
+bool ShmRing::wait(Sequence cursor, Seconds timeout) const
+{
+    if (latest() != cursor || replaced())
+        return true;
+    struct timespec ts = toTimespec(timeout);
+    oro_atomic_inc(&mheader->waiters);
+    // returns immediately if write_seq is no longer equal to cursor.
+    futex(&mheader->write_seq, FUTEX_WAIT, cursor, &ts);
+    oro_atomic_dec(&mheader->waiters);
+    return latest() != cursor || replaced();
+}
+
+void ShmRing::wakeUp() const
+{
+    futex(&mheader->write_seq, FUTEX_WAKE, INT_MAX, 0);
+}
+
+unsigned int ShmRing::maxWaitAny()
+{
+#if defined(SYS_futex_waitv) && defined(FUTEX_WAITV_MAX)
+    // probe once: a wait on no futex fails with EINVAL if the call exists.
+    static int supported = -1;
+    if (supported == -1)
+        supported = (syscall(SYS_futex_waitv, 0, 0, 0, 0, 0) == -1 && errno != ENOSYS) ? 1 : 0;
+    return supported ? FUTEX_WAITV_MAX : 1;
+#else
+    return 1;
+#endif
+}
+
+bool ShmRing::waitAny(const ShmRing* const* rings, const Sequence* cursors, unsigned int count, Seconds timeout)
+{
+    if (count == 0) {
+        struct timespec ts = toTimespec(timeout);
+        nanosleep(&ts, 0);
+        return false;
+    }
+    if (count <= maxWaitAny())
+        return waitFutex(rings, cursors, count, timeout);
+
+    // Wait on the futexes of the first rings and check the others
+    // every ShmRingPollPeriod.
+    Seconds left = timeout;
+    while (true) {
+        for (unsigned int i = 0; i != count; ++i)
+            if (rings[i]->latest() != cursors[i] || rings[i]->replaced())
+                return true;
+        if (left <= 0)
+            return false;
+        Seconds period = std::min(left, ShmRingPollPeriod);
+        waitFutex(rings, cursors, maxWaitAny(), period);
+        left -= period;
+    }
+}
+
+bool ShmRing::waitFutex(const ShmRing* const* rings, const Sequence* cursors, unsigned int count, Seconds timeout)
+{
+    if (count == 1)
+        return rings[0]->wait(cursors[0], timeout);
+
+    assert(count <= maxWaitAny());
+    bool ready = false;
+    for (unsigned int i = 0; i != count; ++i) {
+        ready = ready || rings[i]->latest() != cursors[i] || rings[i]->replaced();
+        oro_atomic_inc(&rings[i]->mheader->waiters);
+    }
+#if defined(SYS_futex_waitv) && defined(FUTEX_WAITV_MAX)
+    if (!ready && count <= maxWaitAny()) {
+        // returns immediately if any write_seq is no longer equal to its cursor.
+        struct futex_waitv waiters[FUTEX_WAITV_MAX];
+        for (unsigned int i = 0; i != count; ++i) {
+            waiters[i].val = cursors[i];
+            waiters[i].uaddr = (unsigned long)&rings[i]->mheader->write_seq;
+            waiters[i].flags = FUTEX_32;
+            waiters[i].__reserved = 0;
+        }
+        // futex_waitv() takes an absolute timeout.
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        ts.tv_sec += long(timeout);
+        ts.tv_nsec += long(Seconds_to_nsecs(timeout - long(timeout)));
+        if (ts.tv_nsec >= 1000000000) {
+            ts.tv_sec += 1;
+            ts.tv_nsec -= 1000000000;
+        }
+        syscall(SYS_futex_waitv, waiters, count, 0, &ts, CLOCK_MONOTONIC);
+    }
+#endif
+    ready = false;
+    for (unsigned int i = 0; i != count; ++i) {
+        oro_atomic_dec(&rings[i]->mheader->waiters);
+        ready = ready || rings[i]->latest() != cursors[i] || rings[i]->replaced();
+    }
+    return ready;
+}
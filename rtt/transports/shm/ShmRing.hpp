@@ -0,0 +1,245 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  ShmRing.hpp
+
+                        ShmRing.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_SHM_RING_HPP
+#define ORO_SHM_RING_HPP
+
+#include "rtt-shm-config.h"
+#include "../../os/Time.hpp"
+#include <string>
+
+namespace RTT
+{
+    namespace shm
+    {
+        /**
+         * A ring of fixed size sample slots in a POSIX shared memory
+         * segment, written by one process and read by any number of
+         * processes (single producer, multiple consumers).
+         *
+         * The writer never blocks: it always overwrites the oldest slot.
+         * Every slot carries the sequence number of the sample it holds,
+         * which is cleared while the slot is written, such that a reader
+         * can detect that a sample was overwritten while it read it from
+         * the ring. Each reader keeps its own cursor, which is the
+         * sequence number of the last sample it consumed. A reader that
+         * was lapped by the writer skips to the oldest sample still in
+         * the ring.
+         *
+         * Sequence numbers run from 1 up to a multiple of the slot count
+         * and then start again at 1, such that a sequence number always
+         * maps to the same slot, also when it wraps.
+         *
+         * Waiting readers block on a futex in the segment. The writer
+         * only does a system call when a reader is waiting.
+         */
+        class RTT_SHM_API ShmRing
+        {
+        public:
+            /**
+             * The sequence number of a sample. The first sample written
+             * in a new ring has sequence number 1. Zero is the cursor of
+             * a reader which did not read any sample yet.
+             */
+            typedef unsigned int Sequence;
+
+            ShmRing();
+
+            ~ShmRing();
+
+            /**
+             * Creates the segment \a name for writing, holding \a slot_count
+             * samples of maximum \a slot_size bytes each. An existing segment
+             * with the same geometry is re-used, such that readers which are
+             * attached to it keep on receiving samples. An existing segment
+             * with another geometry is marked as replaced and unlinked, after
+             * which its readers attach to the new segment, see replaced().
+             * @return false if the segment could not be created.
+             */
+            bool create(const std::string& name, unsigned int slot_count, unsigned int slot_size);
+
+            /**
+             * Attaches to the existing segment \a name for reading.
+             * @return false if the segment does not exist (yet) or
+             * was not initialized by the writer yet.
+             */
+            bool attach(const std::string& name);
+
+            /**
+             * Unmaps the segment. It is not removed.
+             */
+            void close();
+
+            /**
+             * Exchanges the segments of this ring and \a other.
+             */
+            void swap(ShmRing& other);
+
+            /**
+             * Removes the segment \a name from the system. Readers that are
+             * attached to it keep it mapped until they close it.
+             */
+            static bool unlink(const std::string& name);
+
+            /**
+             * Returns true if create() or attach() succeeded.
+             */
+            bool isOpen() const { return mheader != 0; }
+
+            unsigned int slotCount() const;
+
+            unsigned int slotSize() const;
+
+            /**
+             * Returns true if the writer replaced this segment by a new
+             * one with the same name. No samples are written in this
+             * segment anymore, readers must attach() again once they
+             * read the samples that are left.
+             */
+            bool replaced() const;
+
+            /**
+             * Returns the sequence number of the last written sample,
+             * or zero if nothing was written yet.
+             */
+            Sequence latest() const;
+
+            /**
+             * Returns the sequence number that comes \a count samples
+             * before \a seq.
+             */
+            Sequence previous(Sequence seq, unsigned int count = 1) const;
+
+            /**
+             * Returns the slot to which the next sample must be written.
+             * It can hold slotSize() bytes. Only the writer may call this
+             * function, and only one slot may be written at a time.
+             */
+            char* beginWrite();
+
+            /**
+             * Publishes the slot returned by beginWrite(), which now holds
+             * \a size bytes, and wakes up the waiting readers.
+             */
+            void commitWrite(unsigned int size);
+
+            /**
+             * Returns the sample after \a cursor in the ring, without
+             * copying it. Samples that were overwritten before are skipped,
+             * and \a next is set to the sequence number of the returned
+             * sample. The sample may be overwritten while it is used, so
+             * the reader must call endRead() before it trusts what it read.
+             * @param size is set to the size of the sample.
+             * @return null if there was no sample after \a cursor.
+             */
+            const char* beginRead(Sequence cursor, Sequence& next, unsigned int& size) const;
+
+            /**
+             * Returns true if sample \a next of beginRead() was not
+             * overwritten while it was read.
+             */
+            bool endRead(Sequence next) const;
+
+            /**
+             * Copies the sample after \a cursor into \a buf, which must be
+             * able to hold slotSize() bytes, and advances \a cursor to it.
+             * Samples that were overwritten before or during the copy are
+             * skipped.
+             * @return the size of the sample, or zero if there was no
+             * sample after \a cursor.
+             */
+            unsigned int read(Sequence& cursor, char* buf) const;
+
+            /**
+             * Blocks until a sample after \a cursor was written, or until
+             * \a timeout elapsed.
+             * @return true if a sample after \a cursor is available.
+             */
+            bool wait(Sequence cursor, Seconds timeout) const;
+
+            /**
+             * Blocks until a sample was written in any of the \a count
+             * \a rings after its cursor in \a cursors, or until \a timeout
+             * elapsed. More than one ring is waited on with futex_waitv().
+             * If \a count exceeds maxWaitAny(), the rings beyond the first
+             * maxWaitAny() ones are polled every millisecond instead.
+             * @return true if any ring has a sample after its cursor.
+             */
+            static bool waitAny(const ShmRing* const* rings, const Sequence* cursors, unsigned int count, Seconds timeout);
+
+            /**
+             * Returns the number of rings waitAny() can wait on at once
+             * without polling. This is one if the system does not provide
+             * futex_waitv(), which appeared in Linux 5.16.
+             */
+            static unsigned int maxWaitAny();
+
+            /**
+             * Wakes up all readers that wait on this ring.
+             */
+            void wakeUp() const;
+
+        private:
+            struct Header;
+            struct Slot;
+
+            Slot* slot(Sequence seq) const;
+
+            /**
+             * The blocking part of waitAny(), for at most
+             * maxWaitAny() rings.
+             */
+            static bool waitFutex(const ShmRing* const* rings, const Sequence* cursors, unsigned int count, Seconds timeout);
+
+            Sequence next(Sequence seq) const;
+
+            bool map(int fd, size_t size);
+
+            void setGeometry(unsigned int slot_count, unsigned int slot_size);
+
+            Header* mheader;
+            size_t mmapped_size;
+            unsigned int mslot_stride;
+            /**
+             * The largest sequence number, a multiple of the slot count.
+             */
+            Sequence mseq_max;
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,269 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  ShmSendRecv.cpp
+
+                        ShmSendRecv.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include <unistd.h>
+#include <sstream>
+#include <stdexcept>
+#include <cstring>
+#include <cassert>
+#include <algorithm>
+
+#include "ShmSendRecv.hpp"
+#include "ShmDispatcher.hpp"
+#include "../../types/TypeMarshaller.hpp"
+#include "../../Logger.hpp"
+#include "../../os/TimeService.hpp"
+#include "../../base/ChannelElementBase.hpp"
+#include "../../base/PortInterface.hpp"
+#include "../../DataFlowInterface.hpp"
+#include "../../TaskContext.hpp"
+
+using namespace RTT;
+using namespace RTT::detail;
+using namespace RTT::shm;
+
+ShmSendRecv::ShmSendRecv(types::TypeMarshaller const& transport, bool direct_read) :
+    mtransport(transport), marshaller_cookie(0), buf(0), mcursor(0), mis_sender(false), minit_done(false),
+    mslots(0), mdata_size(0), mbatch_size(0), mdirect_read(direct_read)
+{
+}
+
+void ShmSendRecv::setupStream(base::DataSourceBase::shared_ptr ds, base::PortInterface* port, ConnPolicy const& policy,
+                              bool is_sender)
+{
+    Logger::In in("ShmSendRecv");
+
+    mdata_size = policy.data_size;
+    mbatch_size = policy.batch_size;
+    mslots = policy.size ? policy.size : 10;
+    marshaller_cookie = mtransport.createCookie();
+    mis_sender = is_sender;
+
+    std::stringstream namestr;
+    namestr << '/' << port->getInterface()->getOwner()->getName() << '.' << port->getName() << '.' << this << '@' << getpid();
+
+    if (policy.name_id.empty())
+        policy.name_id = namestr.str();
+
+    if (policy.name_id[0] != '/' || policy.name_id.find('/', 1) != std::string::npos)
+        throw std::runtime_error("Could not open shared memory segment with wrong name. Names must start with '/' and contain no more '/' after the first one.");
+    mshmname = policy.name_id;
+
+    if (mis_sender && !shmNewSample(ds))
+        throw std::runtime_error("Could not create shared memory segment.");
+}
+
+ShmSendRecv::~ShmSendRecv()
+{
+    delete[] buf;
+}
+
+void ShmSendRecv::cleanupStream()
+{
+    if (!mis_sender && minit_done)
+    {
+        // after this, the dispatcher no longer uses our ring.
+        ShmDispatcher::Instance()->removeStream(this);
+    }
+    minit_done = false;
+    if (mis_sender && mring.isOpen())
+    {
+        // sender unlinks to avoid future re-use of new readers.
+        ShmRing::unlink(mshmname);
+    }
+    // both sender and receiver unmap their end.
+    mring.close();
+    delete[] buf;
+    buf = 0;
+
+    if (marshaller_cookie)
+    {
+        mtransport.deleteCookie(marshaller_cookie);
+        marshaller_cookie = 0;
+    }
+}
+
+bool ShmSendRecv::shmNewSample(base::DataSourceBase::shared_ptr ds)
+{
+    // the size in the policy is only a hint, it is filled in by the
+    // ConnFactory with the size of the sample at connection time.
+    int size = std::max(mdata_size, int(mtransport.getSampleSize(ds, marshaller_cookie)));
+    if (size <= 0)
+        size = 1;
+    if (mring.isOpen() && mring.slotSize() >= (unsigned int)size)
+        return true;
+    if ( !mring.create(mshmname, mslots, size) )
+        return false;
+    log(Debug) << "Created '" << mshmname << "' with slot size='" << size << "' and ring length='" << mslots << "' for writing." << endlog();
+    return true;
+}
+
+bool ShmSendRecv::shmReady(base::DataSourceBase::shared_ptr ds, base::ChannelElementBase* chan)
+{
+    if (minit_done)
+        return true;
+
+    assert( !mis_sender ); // we can only receive inputReady when we're on the input port side of the ring.
+    Logger::In in("ShmSendRecv");
+
+    // Try to attach and to get the initial sample.
+    //
+    // The output port implementation guarantees that there will be one
+    // after the connection is ready
+    TimeService::ticks start = TimeService::Instance()->getTicks();
+    while ( !mring.isOpen() || mring.latest() == 0 )
+    {
+        if ( TimeService::Instance()->secondsSince(start) > 0.5 )
+        {
+            log(Error) << "Failed to receive initial data sample for shared memory segment '" << mshmname << "'." << endlog();
+            mring.close();
+            return false;
+        }
+        if ( !mring.isOpen() )
+            mring.attach(mshmname);
+        if ( !mring.isOpen() )
+            usleep(1000);
+        else
+            mring.wait(0, 0.01);
+    }
+
+    if (!mdirect_read)
+    {
+        delete[] buf;
+        buf = new char[mring.slotSize()];
+    }
+    mcursor = mring.previous( mring.latest() );
+    // skip the samples which were overwritten while they were read.
+    ShmRing::Sequence cursor;
+    bool read;
+    do {
+        cursor = mcursor;
+        read = shmRead(ds);
+    } while ( !read && cursor != mcursor );
+    if ( !read )
+    {
+        log(Error) << "Failed to initialize shared memory Channel Element with initial data sample." << endlog();
+        mring.close();
+        return false;
+    }
+    // ok, now we can start to wait for new samples.
+    ShmDispatcher::Instance()->addStream(this, chan);
+    minit_done = true;
+    log(Debug) << "Attached to '" << mshmname << "' with slot size='" << mring.slotSize() << "' and ring length='" << mring.slotCount() << "' for reading." << endlog();
+    return true;
+}
+
+bool ShmSendRecv::shmRead(base::DataSourceBase::shared_ptr ds)
+{
+    if (mdirect_read)
+    {
+        ShmRing::Sequence next;
+        unsigned int bytes;
+        const char* data = mring.isOpen() ? mring.beginRead(mcursor, next, bytes) : 0;
+        if (data)
+        {
+            // demarshal straight out of the slot. The writer may overwrite it
+            // meanwhile, then endRead() fails and ds is not passed on. The
+            // archive checks all lengths of these types against the slot, so
+            // a torn sample can not make it read beyond the slot or allocate
+            // without bound.
+            bool result = false;
+            try {
+                result = mtransport.updateFromBlob((void*) data, bytes, ds, marshaller_cookie);
+            } catch (std::exception& e) {
+                if (mring.endRead(next))
+                    log(Error) << "Failed to demarshal sample from shared memory segment '" << mshmname << "': " << e.what() << endlog();
+            }
+            mcursor = next;
+            return result && mring.endRead(next);
+        }
+    }
+    else
+    {
+        // copy the slot first, other marshallers may trust what they read.
+        unsigned int bytes = mring.isOpen() ? mring.read(mcursor, buf) : 0;
+        if (bytes)
+        {
+            try {
+                return mtransport.updateFromBlob((void*) buf, bytes, ds, marshaller_cookie);
+            } catch (std::exception& e) {
+                log(Error) << "Failed to demarshal sample from shared memory segment '" << mshmname << "': " << e.what() << endlog();
+                return false;
+            }
+        }
+    }
+    if (mring.isOpen() && mring.replaced())
+    {
+        // all samples of the old ring were read, continue with the new one.
+        ShmRing ring;
+        if (!ring.attach(mshmname))
+            return false;
+        mring.swap(ring);
+        if (!mdirect_read)
+        {
+            delete[] buf;
+            buf = new char[mring.slotSize()];
+        }
+        mcursor = 0;
+        log(Debug) << "Re-attached to '" << mshmname << "' with slot size='" << mring.slotSize() << "' and ring length='" << mring.slotCount() << "' for reading." << endlog();
+        return shmRead(ds);
+    }
+    return false;
+}
+
+bool ShmSendRecv::shmPending() const
+{
+    return mring.latest() != mcursor || mring.replaced();
+}
+
+bool ShmSendRecv::shmWrite(base::DataSourceBase::shared_ptr ds)
+{
+    if ( !mring.isOpen() )
+        return false;
+    char* slot = mring.beginWrite();
+    std::pair<void const*, int> blob = mtransport.fillBlob(ds, slot, mring.slotSize(), marshaller_cookie);
+    if (blob.first == 0)
+    {
+        log(Error) << "ShmChannel: failed to marshal sample" << endlog();
+        return false;
+    }
+    // marshallers of plain types return the sample itself instead of filling the slot.
+    if (blob.first != slot)
+        memcpy(slot, blob.first, blob.second);
+    mring.commitWrite(blob.second);
+    return true;
+}
@@ -0,0 +1,183 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  ShmSendRecv.hpp
+
+                        ShmSendRecv.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_SHM_SENDRECV_HPP
+#define ORO_SHM_SENDRECV_HPP
+
+#include "ShmRing.hpp"
+#include "../../rtt-fwd.hpp"
+#include "../../base/DataSourceBase.hpp"
+
+namespace RTT
+{
+    namespace shm
+    {
+        class ShmDispatcher;
+
+        /**
+         * Implements the sending/receiving of samples through a shared
+         * memory ring. It can only be OR sender OR receiver (logical XOR).
+         *
+         * The sender marshals each sample with the type's marshaller
+         * directly into a slot of the ring. The receiver of a type
+         * which the marshaller reads within bounds demarshals each slot
+         * directly into its own sample and drops that sample if the slot
+         * was overwritten meanwhile. For other types, the receiver first
+         * copies the slot into its own buffer and demarshals the copy.
+         * The ShmDispatcher of the process waits on the rings of all
+         * receivers and signals them.
+         */
+        class RTT_SHM_API ShmSendRecv
+        {
+            friend class ShmDispatcher;
+        protected:
+            /**
+             * Transport marshaller used for size calculations
+             * and data updates.
+             */
+            types::TypeMarshaller const& mtransport;
+            /**
+             * A private blob that is returned by mtransport.getCookie(). It is
+             * used by the marshallers if they need private internal data to do
+             * the marshalling
+             */
+            void* marshaller_cookie;
+            /**
+             * The shared memory ring.
+             */
+            ShmRing mring;
+            /**
+             * Receive buffer, in which a slot is copied before it is
+             * demarshalled, unless mdirect_read is set. It has the slot
+             * size of the ring.
+             */
+            char* buf;
+            /**
+             * The sequence number of the last sample the receiver read.
+             */
+            ShmRing::Sequence mcursor;
+            /**
+             * True if this object is a sender.
+             */
+            bool mis_sender;
+            /**
+             * True if shmReady() succeeded, false after cleanupStream().
+             */
+            bool minit_done;
+            /**
+             * The name of the segment, as specified in the ConnPolicy when
+             * creating the stream, or self-calculated when that name was empty.
+             */
+            std::string mshmname;
+            /**
+             * The number of slots of the ring.
+             */
+            int mslots;
+            /**
+             * The size of the data, as specified in the ConnPolicy when
+             * creating the stream. It is the minimum slot size, the slots
+             * grow when larger samples are set with data_sample().
+             */
+            int mdata_size;
+            /**
+             * The maximum number of samples that are read in one batch,
+             * as specified in the ConnPolicy. Batching is off when it is
+             * less than two.
+             */
+            int mbatch_size;
+            /**
+             * True if the receiver demarshals straight from the ring slot.
+             */
+            bool mdirect_read;
+
+        public:
+            /**
+             * Create a channel element for shared memory data exchange.
+             * @param transport The type specific object that will be used to marshal the data.
+             * @param direct_read Set if \a transport checks every length it
+             * reads against the blob, such that it can demarshal a slot which
+             * the writer overwrites meanwhile.
+             */
+            ShmSendRecv(types::TypeMarshaller const& transport, bool direct_read);
+
+            void setupStream(base::DataSourceBase::shared_ptr ds, base::PortInterface* port, ConnPolicy const& policy, bool is_sender);
+
+            ~ShmSendRecv();
+
+            void cleanupStream();
+
+            /**
+             * Creates the ring such that its slots can hold the data in
+             * \a ds, and at least mdata_size bytes. Only for senders.
+             * @return false if the ring could not be created.
+             */
+            bool shmNewSample(base::DataSourceBase::shared_ptr ds);
+
+            /**
+             * Works only in receive mode, attaches to the ring, waits for
+             * the initial sample of the sender and registers \a chan with
+             * the ShmDispatcher, which signals it when new samples arrive.
+             */
+            bool shmReady(base::DataSourceBase::shared_ptr ds, base::ChannelElementBase* chan);
+
+            /**
+             * Read the next sample from the ring. When the sender replaced
+             * the ring and all its samples were read, attaches to the new one.
+             * @param ds stores the resulting data sample. It is left
+             * undefined if the sample was overwritten while it was read.
+             * @return true if an item could be read.
+             */
+            bool shmRead(base::DataSourceBase::shared_ptr ds);
+
+            /**
+             * Returns true if the ring holds samples that were not read yet,
+             * or if it was replaced by the sender.
+             */
+            bool shmPending() const;
+
+            /**
+             * Write to the ring. This never blocks: the oldest sample
+             * is overwritten when the ring is full.
+             * @param ds the data sample to write
+             * @return true if it could be marshalled.
+             */
+            bool shmWrite(base::DataSourceBase::shared_ptr ds);
+        };
+    }
+}
+
+#endif
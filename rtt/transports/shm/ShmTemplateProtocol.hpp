@@ -0,0 +1,120 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  ShmTemplateProtocol.hpp
+
+                        ShmTemplateProtocol.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_SHM_TEMPLATE_PROTOCOL_HPP
+#define ORO_SHM_TEMPLATE_PROTOCOL_HPP
+
+#include "ShmLib.hpp"
+#include "ShmChannelElement.hpp"
+#include "../mqueue/MQTemplateProtocol.hpp"
+#include "../mqueue/MQSerializationProtocol.hpp"
+
+namespace RTT
+{ namespace shm
+  {
+      /**
+       * True for the types of which mqueue::binary_data_iarchive checks
+       * every length against the blob before it allocates or reads,
+       * such that they can be demarshalled straight from a ring slot
+       * that the writer may overwrite meanwhile.
+       */
+      template<class T>
+      struct is_bounded_sample : public boost::mpl::false_ {};
+
+      template<class T, class A>
+      struct is_bounded_sample< std::vector<T,A> > : public mqueue::is_bulk_primitive<T> {};
+
+      template<>
+      struct is_bounded_sample< std::string > : public boost::mpl::true_ {};
+
+      /**
+       * Creates shared memory streams for type T, and reuses the
+       * marshalling of the mqueue transport, given as \a Marshaller,
+       * to fill and read the slots of the ring. If \a DirectRead is
+       * false, the receiver copies each slot before demarshalling it.
+       */
+      template<class T, class Marshaller, bool DirectRead>
+      class ShmProtocol
+          : public Marshaller
+      {
+      public:
+          /**
+           * The given \a T parameter is the type for reading DataSources.
+           */
+          typedef T UserType;
+
+          virtual base::ChannelElementBase::shared_ptr createStream(base::PortInterface* port, const ConnPolicy& policy, bool is_sender) const {
+              try {
+                  base::ChannelElementBase::shared_ptr shm = new ShmChannelElement<T>(port, *this, policy, is_sender, DirectRead);
+                  if ( !is_sender ) {
+                      // the receiver needs a buffer to store his samples in.
+                      base::ChannelElementBase::shared_ptr buf = detail::DataSourceTypeInfo<T>::getTypeInfo()->buildDataStorage(policy);
+                      shm->setOutput(buf);
+                  }
+                  return shm;
+              } catch(std::exception& e) {
+                  log(Error) << "Failed to create shared memory Channel element: " << e.what() << endlog();
+              }
+              return base::ChannelElementBase::shared_ptr();
+          }
+      };
+
+      /**
+       * Transports a trivial type T by copying its memory into the ring.
+       * Its size is fixed, so it is read straight from the slot.
+       * @see mqueue::MQTemplateProtocol
+       */
+      template<class T>
+      class ShmTemplateProtocol
+          : public ShmProtocol<T, mqueue::MQTemplateProtocol<T>, true >
+      {
+      };
+
+      /**
+       * Transports a type T by serializing it into the ring. Unless
+       * is_bounded_sample<T>, the slot is copied before it is read.
+       * @see mqueue::MQSerializationProtocol
+       */
+      template<class T>
+      class ShmSerializationProtocol
+          : public ShmProtocol<T, mqueue::MQSerializationProtocol<T>, is_bounded_sample<T>::value >
+      {
+      };
+}
+}
+
+#endif
@@ -59,6 +59,8 @@ namespace boost {
             a & boost::serialization::make_nvp("transport", c.transport );
             a & boost::serialization::make_nvp("data_size", c.data_size );
             a & boost::serialization::make_nvp("name_id", c.name_id );
+            a & boost::serialization::make_nvp("batch_size", c.batch_size );
+            a & boost::serialization::make_nvp("batch_latency", c.batch_latency );
         }
     }
 }
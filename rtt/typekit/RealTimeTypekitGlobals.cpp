@@ -63,8 +63,10 @@ namespace RTT
         globals->setValue( new Constant<int>("DATA",ConnPolicy::DATA) );
         globals->setValue( new Constant<int>("BUFFER",ConnPolicy::BUFFER) );
         globals->setValue( new Constant<int>("CIRCULAR_BUFFER",ConnPolicy::CIRCULAR_BUFFER) );
+        globals->setValue( new Constant<int>("BROADCAST",ConnPolicy::BROADCAST) );
         globals->setValue( new Constant<int>("LOCKED",ConnPolicy::LOCKED) );
         globals->setValue( new Constant<int>("LOCK_FREE",ConnPolicy::LOCK_FREE) );
+        globals->setValue( new Constant<int>("SEQLOCK",ConnPolicy::SEQLOCK) );
         globals->setValue( new Constant<int>("UNSYNC",ConnPolicy::UNSYNC) );
         globals->setValue( new Constant<int>("ORO_SCHED_RT", ORO_SCHED_RT) );
         globals->setValue( new Constant<int>("ORO_SCHED_OTHER", ORO_SCHED_OTHER) );
@@ -23,6 +23,7 @@
 
 #include <internal/AtomicQueue.hpp>
 #include <internal/AtomicMWSRQueue.hpp>
+#include <internal/AtomicMPSCQueue.hpp>
 
 #include <Activity.hpp>
 
@@ -30,6 +31,7 @@
 #include <base/Buffer.hpp>
 #include <internal/ListLockFree.hpp>
 #include <base/DataObject.hpp>
+#include <base/DataObjectSeqLock.hpp>
 #include <internal/TsPool.hpp>
 //#include <internal/SortedList.hpp>
 
@@ -75,6 +77,7 @@ public:
 
 typedef AtomicQueue<Dummy*> QueueType;
 typedef AtomicMWSRQueue<Dummy*> MWSRQueueType;
+typedef AtomicMPSCQueue<Dummy*> MPSCQueueType;
 
 // Don't make queue size too large, we want to catch
 // overrun issues too.
@@ -115,6 +118,21 @@ public:
     }
 };
 
+class BuffersAtomicMPSCQueueTest
+{
+public:
+    AtomicMPSCQueue<Dummy*>* aqueue;
+
+    BuffersAtomicMPSCQueueTest()
+    {
+        aqueue = new AtomicMPSCQueue<Dummy*>(QS);
+    }
+    ~BuffersAtomicMPSCQueueTest(){
+        aqueue->clear();
+        delete aqueue;
+    }
+};
+
 class BuffersDataFlowTest
 {
 public:
@@ -133,6 +151,7 @@ public:
     DataObjectLocked<Dummy>* dlocked;
     DataObjectLockFree<Dummy>* dlockfree;
     DataObjectUnSync<Dummy>* dunsync;
+    DataObjectSeqLock<Dummy>* dseqlock;
 
     ThreadInterface* athread;
     ThreadInterface* bthread;
@@ -156,6 +175,7 @@ public:
         dlockfree = new DataObjectLockFree<Dummy>();
         dlocked   = new DataObjectLocked<Dummy>();
         dunsync   = new DataObjectUnSync<Dummy>();
+        dseqlock  = new DataObjectSeqLock<Dummy>();
 
         // defaults
         buffer = lockfree;
@@ -172,6 +192,7 @@ public:
         delete dlockfree;
         delete dlocked;
         delete dunsync;
+        delete dseqlock;
     }
 };
 
@@ -785,6 +806,91 @@ BOOST_AUTO_TEST_CASE( testAtomicMWSRQueue )
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_FIXTURE_TEST_SUITE( BuffersMPSCQueueTestSuite, BuffersAtomicMPSCQueueTest )
+
+BOOST_AUTO_TEST_CASE( testAtomicMPSCQueue )
+{
+    /**
+     * Single Threaded test for AtomicMPSCQueue.
+     */
+    Dummy* d = new Dummy();
+    Dummy* c = d;
+
+    BOOST_REQUIRE_EQUAL( MPSCQueueType::size_type(QS), aqueue->capacity() );
+    BOOST_REQUIRE_EQUAL( MPSCQueueType::size_type(0), aqueue->size() );
+    BOOST_CHECK( aqueue->isFull() == false );
+    BOOST_CHECK( aqueue->isEmpty() == true );
+    BOOST_CHECK( aqueue->dequeue(c) == false );
+    BOOST_CHECK( c == d );
+    BOOST_CHECK( aqueue->front() == 0 );
+
+    // go around a few times to exercise the wrapping of the slots.
+    for ( int round = 0; round < 3; ++round) {
+        for ( int i = 0; i < QS; ++i) {
+            BOOST_CHECK( aqueue->enqueue( d ) == true);
+            BOOST_REQUIRE_EQUAL( MPSCQueueType::size_type(i+1), aqueue->size() );
+        }
+        BOOST_CHECK( aqueue->isFull() == true );
+        BOOST_CHECK( aqueue->isEmpty() == false );
+        BOOST_CHECK( aqueue->enqueue( d ) == false );
+        BOOST_CHECK( aqueue->front() == d );
+        BOOST_REQUIRE_EQUAL( MPSCQueueType::size_type(QS), aqueue->size() );
+
+        for ( int i = 0; i < QS; ++i) {
+            c = 0;
+            BOOST_CHECK( aqueue->dequeue( c ) == true);
+            BOOST_CHECK( c == d );
+            BOOST_REQUIRE_EQUAL( MPSCQueueType::size_type(QS - 1 - i), aqueue->size() );
+        }
+        BOOST_CHECK( aqueue->isFull() == false );
+        BOOST_CHECK( aqueue->isEmpty() == true );
+        BOOST_CHECK( aqueue->dequeue(c) == false );
+    }
+
+    // capacity is not limited to 16 bit indexes.
+    AtomicMPSCQueue<Dummy*> large(100000);
+    BOOST_CHECK_EQUAL( large.capacity(), MPSCQueueType::size_type(100000) );
+    for ( int i = 0; i < 100000; ++i)
+        BOOST_CHECK( large.enqueue( d ) );
+    BOOST_CHECK( large.isFull() );
+    BOOST_CHECK_EQUAL( large.size(), MPSCQueueType::size_type(100000) );
+
+    // a queue of size 1 still tells a full slot from an empty one.
+    AtomicMPSCQueue<Dummy*> single(1);
+    BOOST_CHECK_EQUAL( single.capacity(), MPSCQueueType::size_type(1) );
+    for ( int round = 0; round < 3; ++round) {
+        BOOST_CHECK( single.isEmpty() );
+        BOOST_CHECK( single.dequeue( c ) == false );
+        BOOST_CHECK( single.enqueue( d ) );
+        BOOST_CHECK( single.isFull() );
+        BOOST_CHECK( single.enqueue( d ) == false );
+        BOOST_CHECK_EQUAL( single.size(), MPSCQueueType::size_type(1) );
+        c = 0;
+        BOOST_CHECK( single.dequeue( c ) );
+        BOOST_CHECK( c == d );
+    }
+
+    BufferLockFree<int> one(1, 0, false);
+    BufferLockFree<int> circone(1, 0, true);
+    int v = 0;
+    BOOST_CHECK( one.Pop(v) == false );
+    BOOST_CHECK( one.Push(1) );
+    BOOST_CHECK( one.Push(2) == false );
+    BOOST_CHECK( one.Pop(v) );
+    BOOST_CHECK_EQUAL( v, 1 );
+    BOOST_CHECK( one.Pop(v) == false );
+    for ( int i = 0; i < 3; ++i)
+        BOOST_CHECK( circone.Push(i) );
+    BOOST_CHECK_EQUAL( circone.size(), 1u );
+    BOOST_CHECK( circone.Pop(v) );
+    BOOST_CHECK_EQUAL( v, 2 );
+    BOOST_CHECK( circone.Pop(v) == false );
+
+    delete d;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_FIXTURE_TEST_SUITE( BuffersDataFlowTestSuite, BuffersDataFlowTest )
 
 BOOST_AUTO_TEST_CASE( testBufLockFree )
@@ -829,6 +935,12 @@ BOOST_AUTO_TEST_CASE( testDObjUnSync )
     testDObj();
 }
 
+BOOST_AUTO_TEST_CASE( testDObjSeqLock )
+{
+    dataobj = dseqlock;
+    testDObj();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_FIXTURE_TEST_SUITE( BuffersMPoolTestSuite, BuffersMPoolTest )
 
@@ -1155,5 +1267,178 @@ BOOST_AUTO_TEST_CASE( testAtomicMWSRQueue )
     delete grower;
     delete eater;
 }
+
+/**
+ * A sample of 4 kB, of which all elements are equal
+ * unless it was torn by a concurrent write.
+ */
+struct LargeSample {
+    double values[512];
+};
+
+/**
+ * Writes samples of increasing value as fast as possible.
+ */
+struct DOWriter : public RunnableInterface
+{
+    volatile bool stop;
+    DataObjectInterface<LargeSample>* dobj;
+    DOWriter(DataObjectInterface<LargeSample>* d) : stop(false), dobj(d) {}
+    bool initialize() {
+        stop = false;
+        return true;
+    }
+    void step() {
+        LargeSample sample;
+        double value = 0;
+        while (stop == false ) {
+            value += 1.0;
+            for (int i = 0; i != 512; ++i)
+                sample.values[i] = value;
+            dobj->Set( sample );
+        }
+    }
+    void finalize() {}
+    bool breakLoop() {
+        stop = true;
+        return true;
+    }
+};
+
+/**
+ * Reads samples as fast as possible and measures the time it took.
+ */
+struct DOReader : public RunnableInterface
+{
+    volatile bool stop;
+    DataObjectInterface<LargeSample>* dobj;
+    int reads;
+    int torn;
+    nsecs elapsed;
+    DOReader(DataObjectInterface<LargeSample>* d) : stop(false), dobj(d), reads(0), torn(0), elapsed(0) {}
+    bool initialize() {
+        stop = false;
+        return true;
+    }
+    void step() {
+        LargeSample sample;
+        TimeService::ticks start = TimeService::Instance()->getTicks();
+        while (stop == false ) {
+            dobj->Get( sample );
+            if ( sample.values[0] != sample.values[511] )
+                ++torn;
+            ++reads;
+        }
+        elapsed = TimeService::ticks2nsecs( TimeService::Instance()->ticksSince(start) );
+    }
+    void finalize() {}
+    bool breakLoop() {
+        stop = true;
+        return true;
+    }
+};
+
+/**
+ * Lets one writer and \a nreaders readers access \a dobj during half a second,
+ * checks that no reader got a torn sample and prints the mean time of a read.
+ */
+void benchmarkDataObject(DataObjectInterface<LargeSample>* dobj, int nreaders, const std::string& name)
+{
+    DOWriter writer( dobj );
+    std::vector<DOReader*> readers;
+    std::vector<Activity*> activities;
+    activities.push_back( new Activity(ORO_SCHED_OTHER, 0, 0, &writer, "Writer") );
+    for (int i = 0; i != nreaders; ++i) {
+        readers.push_back( new DOReader( dobj ) );
+        activities.push_back( new Activity(ORO_SCHED_OTHER, 0, 0, readers.back(), "Reader") );
+    }
+    for (unsigned int i = 0; i != activities.size(); ++i)
+        activities[i]->start();
+    usleep(500000);
+    for (unsigned int i = 0; i != activities.size(); ++i) {
+        activities[i]->stop();
+        delete activities[i];
+    }
+
+    int reads = 0;
+    nsecs elapsed = 0;
+    for (int i = 0; i != nreaders; ++i) {
+        BOOST_CHECK_EQUAL( readers[i]->torn, 0 );
+        reads += readers[i]->reads;
+        elapsed += readers[i]->elapsed;
+        delete readers[i];
+    }
+    log(Info) << name << " with " << nreaders << " reader(s): "
+              << (reads ? elapsed / reads : 0) << " ns per read of " << sizeof(LargeSample) << " bytes." << endlog();
+}
+
+BOOST_AUTO_TEST_CASE( testDataObjectReadLatency )
+{
+    // a benchmark of the lock-free data objects with a large sample.
+    // It only checks for torn reads, since the latency depends on the machine.
+    for (int nreaders = 1; nreaders <= 4; nreaders *= 2) {
+        DataObjectLockFree<LargeSample> lockfree( LargeSample(), nreaders + 1 );
+        DataObjectSeqLock<LargeSample> seqlock;
+        benchmarkDataObject( &lockfree, nreaders, "DataObjectLockFree" );
+        benchmarkDataObject( &seqlock, nreaders, "DataObjectSeqLock" );
+    }
+}
+
+/**
+ * Lets three writers flood and one reader empty queue \a qt
+ * during one second and checks that no item got lost or duplicated.
+ * @return the number of dequeued items.
+ */
+template<class Q>
+int benchmarkQueue(Q* qt, const std::string& name)
+{
+    AQGrower<Q>* aworker = new AQGrower<Q>( qt );
+    AQGrower<Q>* bworker = new AQGrower<Q>( qt );
+    AQGrower<Q>* cworker = new AQGrower<Q>( qt );
+    AQEater<Q>* eater = new AQEater<Q>( qt );
+
+    {
+        boost::scoped_ptr<Activity> athread( new Activity(ORO_SCHED_OTHER, 0, 0, aworker, "ActivityA" ));
+        boost::scoped_ptr<Activity> bthread( new Activity(ORO_SCHED_OTHER, 0, 0, bworker, "ActivityB" ));
+        boost::scoped_ptr<Activity> cthread( new Activity(ORO_SCHED_OTHER, 0, 0, cworker, "ActivityC" ));
+        boost::scoped_ptr<Activity> ethread( new Activity(ORO_SCHED_OTHER, 0, 0, eater, "ActivityE"));
+
+        ethread->start();
+        athread->start();
+        bthread->start();
+        cthread->start();
+        sleep(1);
+        athread->stop();
+        bthread->stop();
+        cthread->stop();
+        ethread->stop();
+    }
+
+    int appends = aworker->appends + bworker->appends + cworker->appends;
+    int erases = eater->erases;
+    int left = 0;
+    Dummy* d = 0;
+    while( qt->dequeue(d) )
+        ++left;
+    BOOST_CHECK_EQUAL( appends, left + erases );
+    log(Info) << name << ": " << erases << " items/s through the queue with 3 writers and 1 reader." << endlog();
+
+    delete aworker;
+    delete bworker;
+    delete cworker;
+    delete eater;
+    return erases;
+}
+
+BOOST_AUTO_TEST_CASE( testQueueContention )
+{
+    // a benchmark of the queues under writer/reader contention.
+    // It only checks for consistency, since the throughput depends on the machine.
+    MWSRQueueType mwsr(QS);
+    MPSCQueueType mpsc(QS);
+    benchmarkQueue( &mwsr, "AtomicMWSRQueue" );
+    benchmarkQueue( &mpsc, "AtomicMPSCQueue" );
+    BOOST_CHECK( mpsc.isEmpty() );
+}
 #endif
 BOOST_AUTO_TEST_SUITE_END()
@@ -30,6 +30,7 @@
 #include <rtt/Service.hpp>
 #include <rtt/transports/corba/DataFlowI.h>
 #include <rtt/transports/corba/RemotePorts.hpp>
+#include <rtt/transports/corba/CorbaDispatcher.hpp>
 #include <transports/corba/ServiceC.h>
 #include <transports/corba/CorbaLib.hpp>
 
@@ -456,6 +457,59 @@ BOOST_AUTO_TEST_CASE( testAnyOperationCaller )
     BOOST_REQUIRE( tc->inException() );
 }
 
+BOOST_AUTO_TEST_CASE( testPreparedOperation )
+{
+    double d;
+
+    ts = corba::TaskContextServer::Create( tc, false ); //no-naming
+    corba::CService_var co = ts->server()->getProvider("methods");
+    BOOST_REQUIRE( co.in() );
+
+    BOOST_CHECK_THROW( co->prepareOperation("nonexistant"), ::RTT::corba::CNoSuchNameException );
+
+    // The prepared operation can be called repeatedly with new arguments.
+    corba::CPreparedOperation_var m2 = co->prepareOperation("m2");
+    BOOST_REQUIRE( !CORBA::is_nil( m2.in() ) );
+    corba::CAnyArguments_var any_args = new corba::CAnyArguments(2);
+    any_args->length(2);
+    for (int i = 0; i != 10; ++i) {
+        unsigned int index = 0;
+        any_args[index] <<= (CORBA::Long) (i % 2);
+        ++index;
+        any_args[index] <<= (CORBA::Double) 2.0;
+        CORBA::Any_var ret;
+        BOOST_CHECK_NO_THROW( ret = m2->call( any_args.inout() ) );
+        BOOST_CHECK( ret >>= d );
+        BOOST_CHECK_EQUAL( d, i % 2 ? -3.0 : 3.0 );
+    }
+
+    // wrong number and types of arguments.
+    any_args->length(1);
+    BOOST_CHECK_THROW( m2->call( any_args.inout() ), ::RTT::corba::CWrongNumbArgException );
+    any_args->length(2);
+    any_args[(unsigned int)0] <<= "hello";
+    BOOST_CHECK_THROW( m2->call( any_args.inout() ), ::RTT::corba::CWrongTypeArgException );
+    m2->dispose();
+
+    // reference arguments are returned in the arguments.
+    corba::CPreparedOperation_var m1r = co->prepareOperation("m1r");
+    any_args->length(1);
+    any_args[(unsigned int)0] <<= (CORBA::Double) 3.0;
+    CORBA::Any_var ret = m1r->call( any_args.inout() );
+    BOOST_CHECK( ret >>= d );
+    BOOST_CHECK_EQUAL( d, 6.0 );
+    BOOST_CHECK( any_args[(unsigned int)0] >>= d );
+    BOOST_CHECK_EQUAL( d, 6.0 );
+    m1r->dispose();
+
+    // the proxy calls through a prepared operation.
+    tp = corba::TaskContextProxy::Create( ts->server() , true);
+    OperationCaller<double(int,double)> mc = tp->provides("methods")->getOperation("m2");
+    BOOST_REQUIRE( mc.ready() );
+    BOOST_CHECK_EQUAL( mc(1, 2.0), -3.0 );
+    BOOST_CHECK_EQUAL( mc(0, 2.0), 3.0 );
+}
+
 BOOST_AUTO_TEST_CASE(testDataFlowInterface)
 {
     ts = corba::TaskContextServer::Create( tc, false ); //no-naming
@@ -722,5 +776,110 @@ BOOST_AUTO_TEST_CASE( testBufferHalfs )
     BOOST_CHECK_EQUAL( result, 4.44);
 }
 
+BOOST_AUTO_TEST_CASE( testDispatcherPool )
+{
+    // more remote connections than dispatcher threads share the pool.
+    corba::CorbaDispatcher::ReleaseAll();
+    BOOST_REQUIRE( corba::CorbaDispatcher::setPoolSize(1) );
+
+    ts  = corba::TaskContextServer::Create( tc, false ); //no-naming
+    ts2 = corba::TaskContextServer::Create( t2, false ); //no-naming
+
+    RTT::corba::CConnPolicy policy;
+    policy.type = RTT::corba::CBuffer;
+    policy.init = false;
+    policy.lock_policy = RTT::corba::CLockFree;
+    policy.size = 3;
+    policy.pull = false;
+    policy.transport = ORO_CORBA_PROTOCOL_ID; // force creation of non-local connections
+
+    corba::CDataFlowInterface_var ports  = ts->server()->ports();
+    corba::CDataFlowInterface_var ports2 = ts2->server()->ports();
+    BOOST_CHECK( ports->createConnection("mo", ports2, "mi", policy) );
+    BOOST_CHECK( ports2->createConnection("mo", ports, "mi", policy) );
+    BOOST_CHECK_EQUAL( corba::CorbaDispatcher::getPoolSize(), 1u );
+    BOOST_CHECK( corba::CorbaDispatcher::Instance( tc->ports() ) == corba::CorbaDispatcher::Instance( t2->ports() ) );
+
+    double value = 0;
+    for (int i = 0; i != 3; ++i) {
+        mo1->write( double(i) );
+        mo2->write( double(10 + i) );
+    }
+    for (int i = 0; i != 3; ++i) {
+        wait_for_equal( mi2->read(value), NewData, 5 );
+        BOOST_CHECK_EQUAL( value, double(i) );
+        wait_for_equal( mi1->read(value), NewData, 5 );
+        BOOST_CHECK_EQUAL( value, double(10 + i) );
+    }
+
+    ports->disconnectPort("mo");
+    ports2->disconnectPort("mo");
+    corba::CorbaDispatcher::ReleaseAll();
+    BOOST_CHECK( corba::CorbaDispatcher::setPoolSize(0) );
+}
+
+BOOST_AUTO_TEST_CASE( testBatchTransfer )
+{
+    double result = 0.0;
+    ts  = corba::TaskContextServer::Create( tc, false ); //no-naming
+    corba::CDataFlowInterface_var ports  = ts->server()->ports();
+    BOOST_REQUIRE( ports.in() );
+
+    RTT::corba::CConnPolicy policy;
+    policy.type = RTT::corba::CBuffer;
+    policy.init = false;
+    policy.lock_policy = RTT::corba::CLockFree;
+    policy.size = 10;
+    policy.pull = false;
+    policy.transport = ORO_CORBA_PROTOCOL_ID;
+    // the batch policy is not part of CConnPolicy.
+    RTT::corba::CBatchPolicy batch_policy;
+    batch_policy.batch_size = 3;
+    batch_policy.batch_latency = 0.0;
+
+    // writeBatch: all samples arrive in order, the call returns the result.
+    CChannelElement_var cce = ports->buildChannelOutput("mi", policy);
+    ports->channelReady("mi", cce);
+    CRemoteChannelElement_var rce = CRemoteChannelElement::_narrow( cce.in() );
+    BOOST_REQUIRE( !CORBA::is_nil( rce.in() ) );
+    rce->setBatchPolicy( batch_policy );
+    CAnySequence batch;
+    batch.length(3);
+    batch[0] <<= 1.0;
+    batch[1] <<= 2.0;
+    batch[2] <<= 3.0;
+    BOOST_CHECK( rce->writeBatch( batch ) );
+    for (int i = 1; i != 4; ++i) {
+        BOOST_CHECK_EQUAL( mi1->read( result ), NewData );
+        BOOST_CHECK_EQUAL( result, double(i) );
+    }
+    BOOST_CHECK_EQUAL( mi1->read( result ), OldData );
+
+    // writeBatchOneway: the samples arrive without a result.
+    batch[0] <<= 4.0;
+    batch[1] <<= 5.0;
+    batch[2] <<= 6.0;
+    rce->writeBatchOneway( batch );
+    for (int i = 4; i != 7; ++i) {
+        wait_for_equal( mi1->read( result ), NewData, 5 );
+        BOOST_CHECK_EQUAL( result, double(i) );
+    }
+    rce->disconnect();
+
+    // a pushed connection sends incomplete batches once the batch latency expired.
+    policy.type = RTT::corba::CCircularBuffer;
+    batch_policy.batch_latency = 0.1;
+    ts2 = corba::TaskContextServer::Create( t2, false ); //no-naming
+    corba::CDataFlowInterface_var ports2 = ts2->server()->ports();
+    BOOST_REQUIRE( ports->createBatchedConnection("mo", ports2, "mi", policy, batch_policy) );
+    mo1->write( 7.0 );
+    mo1->write( 8.0 );
+    for (int i = 7; i != 9; ++i) {
+        wait_for_equal( mi2->read( result ), NewData, 5 );
+        BOOST_CHECK_EQUAL( result, double(i) );
+    }
+    ports->disconnectPort("mo");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -23,6 +23,11 @@
 
 #include <scripting/Parser.hpp>
 #include <scripting/FunctionGraph.hpp>
+#include <scripting/FunctionGraphBuilder.hpp>
+#include <scripting/ConditionBoolDataSource.hpp>
+#include <scripting/ConditionTrue.hpp>
+#include <internal/AssignCommand.hpp>
+#include <types/Operators.hpp>
 #include <scripting/ScriptingService.hpp>
 #include <Service.hpp>
 #include <OperationCaller.hpp>
@@ -49,6 +54,78 @@ public:
 BOOST_FIXTURE_TEST_SUITE( FunctionsFixtureSuite, FunctionsFixture )
 // Registers the fixture into the 'registry'
 
+/**
+ * Builds a counting loop without the parser and checks stepping, running
+ * and copying of the flattened graph.
+ */
+BOOST_AUTO_TEST_CASE( testFunctionGraphTable )
+{
+    OperatorRepository::shared_ptr ops = OperatorRepository::Instance();
+    ValueDataSource<int>::shared_ptr i = new ValueDataSource<int>(0);
+    DataSource<bool>::shared_ptr less = DataSource<bool>::narrow( ops->applyBinary( "<", i.get(), new ConstantDataSource<int>(5) ) );
+    DataSource<int>::shared_ptr incr = DataSource<int>::narrow( ops->applyBinary( "+", i.get(), new ConstantDataSource<int>(1) ) );
+    BOOST_REQUIRE( less && incr );
+
+    // while ( i < 5 ) set i = i + 1
+    FunctionGraphBuilder fgb;
+    fgb.startFunction( "count" );
+    fgb.startWhileStatement( new ConditionBoolDataSource( less.get() ), 1 );
+    fgb.setCommand( new AssignCommand<int>( i, incr ) );
+    fgb.proceedToNext( new ConditionTrue(), 2 );
+    fgb.endWhileBlock( 3 );
+    fgb.returnFunction( new ConditionTrue(), 4 );
+    fgb.proceedToNext( 4 );
+    FunctionGraphPtr fg = fgb.endFunction( 5 );
+    BOOST_REQUIRE( fg );
+    fg->setUnloadOnStop( false );
+
+    // the engine is only used as a token, the test executes the function.
+    fg->loaded( tc->engine() );
+    BOOST_CHECK( fg->isStopped() );
+    BOOST_CHECK( fg->currentNode() == fg->startNode() );
+
+    // step through it.
+    BOOST_CHECK( fg->pause() );
+    BOOST_CHECK( fg->execute() );
+    BOOST_CHECK( fg->isPaused() );
+    int steps = 0;
+    while ( !fg->isStopped() && steps != 100 ) {
+        BOOST_CHECK( fg->step() );
+        BOOST_CHECK( !fg->stepDone() );
+        BOOST_CHECK( fg->execute() );
+        BOOST_CHECK( fg->stepDone() );
+        ++steps;
+    }
+    BOOST_CHECK_EQUAL( i->get(), 5 );
+    BOOST_CHECK( steps > 5 && steps < 100 );
+    BOOST_CHECK( fg->currentNode() == fg->exitNode() );
+    BOOST_CHECK_EQUAL( fg->getLineNumber(), 5 );
+
+    // run it in one go.
+    i->set( 0 );
+    BOOST_CHECK( fg->start() );
+    BOOST_CHECK( fg->isRunning() );
+    BOOST_CHECK( fg->execute() );
+    BOOST_CHECK( fg->isStopped() );
+    BOOST_CHECK( !fg->inError() );
+    BOOST_CHECK_EQUAL( i->get(), 5 );
+
+    // a copy has its own table and variables.
+    std::map<const DataSourceBase*, DataSourceBase*> replacements;
+    ValueDataSource<int>::shared_ptr j = new ValueDataSource<int>(2);
+    replacements[ i.get() ] = j.get();
+    boost::shared_ptr<FunctionGraph> cp( fg->copy( replacements ) );
+    cp->setUnloadOnStop( false );
+    cp->loaded( tc->engine() );
+    BOOST_CHECK( cp->start() );
+    BOOST_CHECK( cp->execute() );
+    BOOST_CHECK( cp->isStopped() );
+    BOOST_CHECK_EQUAL( j->get(), 5 );
+    BOOST_CHECK_EQUAL( i->get(), 5 );
+    cp->unloaded();
+    fg->unloaded();
+}
+
 BOOST_AUTO_TEST_CASE( testSimpleFunction)
 {
     string prog = string("function foo { \n")
@@ -118,4 +118,54 @@ BOOST_AUTO_TEST_CASE( testThreadLog )
 
 }
 
+BOOST_AUTO_TEST_CASE( testAsyncThreadLog )
+{
+  BOOST_REQUIRE( logger->setAsynchronous(true) );
+  BOOST_CHECK( logger->isAsynchronous() );
+
+  boost::scoped_ptr<TestLog> run( new TestLog() );
+  boost::scoped_ptr<ActivityInterface> t( new Activity(25, 0.001, 0, "ORActivity1") );
+  boost::scoped_ptr<TestLog> run2( new TestLog() );
+  boost::scoped_ptr<ActivityInterface> t2( new Activity(25, 0.001, 0, "ORActivity2") );
+
+  t->run( run.get() );
+  t2->run( run2.get() );
+
+  t->start();
+  t2->start();
+  sleep(1);
+  t->stop();
+  t2->stop();
+
+  // threads which exit hand back their line to the next ones.
+  for (int i = 0; i != 5; ++i) {
+      boost::scoped_ptr<TestLog> shortrun( new TestLog() );
+      boost::scoped_ptr<ActivityInterface> shortt( new Activity(25, 0.001, 0, "ORActivityShort") );
+      shortt->run( shortrun.get() );
+      shortt->start();
+      usleep(20000);
+      shortt->stop();
+  }
+
+  {
+      Logger::In in("AsyncTest");
+      log(Info) << "Asynchronous line " << 42 << endlog();
+  }
+
+  // switching back writes out all pending lines.
+  BOOST_CHECK( logger->setAsynchronous(false) );
+  BOOST_CHECK( !logger->isAsynchronous() );
+
+#ifdef OROSEM_REMOTE_LOGGING
+  bool found = false;
+  std::string line = logger->getLogLine();
+  while ( !line.empty() ) {
+      if ( line.find("[AsyncTest] Asynchronous line 42") != std::string::npos )
+          found = true;
+      line = logger->getLogLine();
+  }
+  BOOST_CHECK( found );
+#endif
+}
+
 BOOST_AUTO_TEST_SUITE_END()
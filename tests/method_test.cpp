@@ -24,6 +24,7 @@
 #include <OperationCaller.hpp>
 #include <Operation.hpp>
 #include <Service.hpp>
+#include <extras/SlaveActivity.hpp>
 
 #include "unit.hpp"
 #include "operations_fixture.hpp"
@@ -270,6 +271,144 @@ BOOST_AUTO_TEST_CASE(testOwnThreadOperationCallerSend)
     BOOST_CHECK_EQUAL( -8.0, h7.ret() );
 }
 
+BOOST_AUTO_TEST_CASE(testMessageBudget)
+{
+    // A slave activity lets us execute the steps of the engine ourselves.
+    TaskContext tb("budget");
+    tb.setActivity( new SlaveActivity() );
+    BOOST_REQUIRE( tb.isActive() );
+    tb.addOperation("m0", &OperationsFixture::m0, this, OwnThread);
+    OperationCaller<double(void)> m0 = tb.getOperation("m0");
+
+    // tune the engine through its service.
+    BOOST_REQUIRE( tb.loadService("engine") );
+    Service::shared_ptr es = tb.provides()->getService("engine");
+    BOOST_REQUIRE( es );
+    OperationCaller<void(unsigned int)> setMessageBudget = es->getOperation("setMessageBudget");
+    OperationCaller<unsigned int(void)> getMessagesProcessed = es->getOperation("getMessagesProcessed");
+    OperationCaller<unsigned int(void)> getMessageQueueDepth = es->getOperation("getMessageQueueDepth");
+    OperationCaller<void(void)> resetMessageStatistics = es->getOperation("resetMessageStatistics");
+    BOOST_REQUIRE( setMessageBudget.ready() && getMessagesProcessed.ready() && getMessageQueueDepth.ready() );
+
+    setMessageBudget(2);
+    BOOST_CHECK_EQUAL( tb.engine()->getMessageBudget(), 2u );
+
+    SendHandle<double(void)> h[5];
+    for (int i = 0; i != 5; ++i)
+        h[i] = m0.send();
+    BOOST_CHECK_EQUAL( getMessageQueueDepth(), 5u );
+
+    // the burst is spread over three steps.
+    BOOST_CHECK( tb.getActivity()->execute() );
+    BOOST_CHECK_EQUAL( tb.engine()->getLastMessagesProcessed(), 2u );
+    BOOST_CHECK_EQUAL( getMessageQueueDepth(), 3u );
+    double ret;
+    BOOST_CHECK_EQUAL( h[2].collectIfDone(ret), SendNotReady );
+    BOOST_CHECK( tb.getActivity()->execute() );
+    BOOST_CHECK( tb.getActivity()->execute() );
+    BOOST_CHECK_EQUAL( tb.engine()->getLastMessagesProcessed(), 1u );
+    BOOST_CHECK_EQUAL( getMessageQueueDepth(), 0u );
+    BOOST_CHECK_EQUAL( getMessagesProcessed(), 5u );
+    BOOST_CHECK_EQUAL( tb.engine()->getMaxMessageQueueDepth(), 5u );
+    BOOST_CHECK( tb.engine()->getMaxMessageProcessingTime() >= tb.engine()->getLastMessageProcessingTime() );
+    for (int i = 0; i != 5; ++i) {
+        BOOST_CHECK_EQUAL( h[i].collectIfDone(ret), SendSuccess );
+        BOOST_CHECK_EQUAL( ret, -1.0 );
+    }
+
+    // without budget, all messages are processed at once.
+    setMessageBudget(0);
+    resetMessageStatistics();
+    BOOST_CHECK_EQUAL( getMessagesProcessed(), 0u );
+    for (int i = 0; i != 3; ++i)
+        h[i] = m0.send();
+    BOOST_CHECK( tb.getActivity()->execute() );
+    BOOST_CHECK_EQUAL( tb.engine()->getLastMessagesProcessed(), 3u );
+    BOOST_CHECK_EQUAL( getMessagesProcessed(), 3u );
+}
+
+BOOST_AUTO_TEST_CASE(testSendPool)
+{
+    tc->provides()->addOperation("m4pool", &OperationsFixture::m4, this, OwnThread).sendPool(2);
+    LocalOperationCaller<double(int,double,bool,std::string)>::shared_ptr impl =
+        boost::dynamic_pointer_cast< LocalOperationCaller<double(int,double,bool,std::string)> >( tc->provides()->getLocalOperation("m4pool") );
+    BOOST_REQUIRE( impl && impl->getSendPool() );
+    BOOST_CHECK_EQUAL( impl->getSendPool()->capacity(), 2u );
+
+    OperationCaller<double(int,double,bool,std::string)> m4( tc->provides()->getPart("m4pool"), caller->engine() );
+    BOOST_REQUIRE( m4.ready() );
+
+    // the third send does not fit in the pool and allocates a clone.
+    SendHandle<double(int,double,bool,std::string)> h0 = m4.send(1, 2.0, true, "hello");
+    SendHandle<double(int,double,bool,std::string)> h1 = m4.send(1, 2.0, true, "world");
+    SendHandle<double(int,double,bool,std::string)> h2 = m4.send(1, 2.0, true, "hello");
+    BOOST_CHECK_EQUAL( SendSuccess, h0.collect() );
+    BOOST_CHECK_EQUAL( SendSuccess, h1.collect() );
+    BOOST_CHECK_EQUAL( SendSuccess, h2.collect() );
+    BOOST_CHECK_EQUAL( -5.0, h0.ret() );
+    BOOST_CHECK_EQUAL( 5.0, h1.ret() );
+    BOOST_CHECK_EQUAL( -5.0, h2.ret() );
+    BOOST_CHECK_EQUAL( impl->getSendPool()->size(), 0u );
+
+    // releasing the handles returns the clones to the pool, once the caller
+    // has processed their completion, after which they are reused.
+    h0 = h1 = h2 = SendHandle<double(int,double,bool,std::string)>();
+    for (int i = 0; i != 100 && impl->getSendPool()->size() != 2; ++i)
+        usleep(10000);
+    BOOST_CHECK_EQUAL( impl->getSendPool()->size(), 2u );
+    for (int i = 0; i != 10; ++i) {
+        h0 = m4.send(1, 2.0, true, "hello");
+        BOOST_CHECK_EQUAL( SendSuccess, h0.collect() );
+        BOOST_CHECK_EQUAL( -5.0, h0.ret() );
+    }
+    h0 = SendHandle<double(int,double,bool,std::string)>();
+    for (int i = 0; i != 100 && impl->getSendPool()->size() != 2; ++i)
+        usleep(10000);
+    BOOST_CHECK_EQUAL( impl->getSendPool()->size(), 2u );
+}
+
+/**
+ * A function object which does not fit in the small object buffer of
+ * boost::function, such that each copy of it allocates memory.
+ */
+struct LargeFunctor
+{
+    static int copies;
+    char pad[256];
+    LargeFunctor() {}
+    LargeFunctor(LargeFunctor const&) { ++copies; }
+    LargeFunctor& operator=(LargeFunctor const&) { ++copies; return *this; }
+    double operator()(int i) const { return i; }
+};
+int LargeFunctor::copies = 0;
+
+BOOST_AUTO_TEST_CASE(testSendPoolLargeFunctor)
+{
+    BOOST_REQUIRE( sizeof(LargeFunctor) > sizeof(boost::detail::function::function_buffer) );
+    Operation<double(int)> op("large");
+    op.calls( boost::function<double(int)>( LargeFunctor() ), OwnThread ).sendPool(2);
+    tc->provides()->addOperation( op );
+    OperationCaller<double(int)> large( tc->provides()->getPart("large"), caller->engine() );
+    BOOST_REQUIRE( large.ready() );
+    LocalOperationCaller<double(int)>::shared_ptr impl =
+        boost::dynamic_pointer_cast< LocalOperationCaller<double(int)> >( tc->provides()->getLocalOperation("large") );
+    BOOST_REQUIRE( impl && impl->getSendPool() );
+
+    // sending with a pooled clone does not copy the function.
+    int copies = LargeFunctor::copies;
+    for (int i = 0; i != 10; ++i) {
+        SendHandle<double(int)> h = large.send(i);
+        BOOST_CHECK_EQUAL( SendSuccess, h.collect() );
+        BOOST_CHECK_EQUAL( double(i), h.ret() );
+        h = SendHandle<double(int)>();
+        for (int j = 0; j != 100 && impl->getSendPool()->size() != 2; ++j)
+            usleep(10000);
+        BOOST_REQUIRE_EQUAL( impl->getSendPool()->size(), 2u );
+    }
+    BOOST_CHECK_EQUAL( LargeFunctor::copies, copies );
+    tc->provides()->removeOperation("large");
+}
+
 BOOST_AUTO_TEST_CASE(testLocalOperationCallerFactory)
 {
     // Test the addition of 'simple' operationCallers to the operation interface,
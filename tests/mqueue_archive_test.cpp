@@ -21,18 +21,40 @@
 #include <boost/iostreams/stream.hpp>
 #include <boost/iostreams/device/array.hpp>
 #include <boost/serialization/vector.hpp>
+#include <boost/serialization/boost_array.hpp>
+#include <boost/serialization/string.hpp>
 #include <boost/archive/binary_iarchive.hpp>
 
 #include <rtt-fwd.hpp>
 #include <transports/mqueue/binary_data_archive.hpp>
 #include <os/fosi.h>
+#include <os/TimeService.hpp>
+#include <Logger.hpp>
 
 using namespace std;
 using namespace boost::archive;
 using namespace RTT::detail;
 using namespace RTT::mqueue;
+using namespace RTT;
 namespace io = boost::iostreams;
 
+/**
+ * A sample with nested variable sized members.
+ */
+struct NestedSample
+{
+    int id;
+    vector<double> values;
+    vector< vector<double> > rows;
+
+    template<class Archive>
+    void serialize(Archive& a, unsigned int) {
+        a & boost::serialization::make_nvp("id", id);
+        a & boost::serialization::make_nvp("values", values);
+        a & boost::serialization::make_nvp("rows", rows);
+    }
+};
+
 class MQueueArchiveTest
 {
 public:
@@ -147,5 +169,190 @@ BOOST_AUTO_TEST_CASE( testMakeArrayBinaryDataArchive )
     BOOST_CHECK_EQUAL( stored, in.getArchiveSize() );
 }
 
+/**
+ * The size-only archive must agree with the real archive.
+ */
+BOOST_AUTO_TEST_CASE( testBinaryDataSizer )
+{
+    char sink[10000];
+    NestedSample sample;
+    sample.id = 3;
+    sample.values.resize(10, 1.0);
+    sample.rows.resize(5, vector<double>(20, 2.0));
+
+    io::stream<io::array_sink>  outbuf(sink,10000);
+    binary_data_oarchive out( outbuf );
+    out << sample;
+
+    rtos_enable_rt_warning();
+    binary_data_sizer sizer; // +0 alloc
+    sizer << sample; // +0 alloc
+    rtos_disable_rt_warning();
+
+    BOOST_CHECK( sizer.getArchiveSize() >= int( sizeof(int) + 110 * sizeof(double) ) );
+    BOOST_CHECK_EQUAL( sizer.getArchiveSize(), out.getArchiveSize() );
+
+    binary_data_sizer dsizer;
+    dsizer << 3.0;
+    BOOST_CHECK_EQUAL( dsizer.getArchiveSize(), int(sizeof(double)) );
+
+    BOOST_CHECK( is_fixed_size_sample<double>::value );
+    BOOST_CHECK( (is_fixed_size_sample< boost::array<double,6> >::value) );
+    BOOST_CHECK( (is_fixed_size_sample< boost::array< boost::array<int,3>,3> >::value) );
+    BOOST_CHECK( !is_fixed_size_sample< vector<double> >::value );
+    BOOST_CHECK( !is_fixed_size_sample< NestedSample >::value );
+}
+
+/**
+ * Vectors, boost::arrays and carrays of primitives are copied in bulk
+ * from and to a blob, in the same format as the stream based archive.
+ */
+BOOST_AUTO_TEST_CASE( testBulkBinaryDataArchive )
+{
+    char blob[1000];
+    char sink[1000];
+    vector<double> v(10, 9.99);
+    boost::array<int,4> a = {{1, 2, 3, 4}};
+    double c[3] = {-1.0, 0.0, 1.0};
+    NestedSample sample;
+    sample.id = 7;
+    sample.values.resize(3, 1.0);
+    sample.rows.resize(2, vector<double>(4, 2.0));
+
+    rtos_enable_rt_warning();
+    binary_data_oarchive out( blob, 1000 ); // +0 alloc
+    out << v << a << RTT::types::carray<double>(c, 3) << sample; // +0 alloc
+    rtos_disable_rt_warning();
+
+    io::stream<io::array_sink>  outbuf(sink,1000);
+    binary_data_oarchive sout( outbuf );
+    sout << v;
+    sout << a;
+    sout << make_array(c, 3);
+    sout << sample;
+
+    BOOST_REQUIRE_EQUAL( out.getArchiveSize(), sout.getArchiveSize() );
+    BOOST_CHECK( memcmp(blob, sink, out.getArchiveSize()) == 0 );
+
+    binary_data_sizer sizer;
+    sizer << v << a << RTT::types::carray<double>(c, 3) << sample;
+    BOOST_CHECK_EQUAL( sizer.getArchiveSize(), out.getArchiveSize() );
+
+    vector<double> rv(10, 0.0);
+    boost::array<int,4> ra = {{0, 0, 0, 0}};
+    double rc[3] = {0.0, 0.0, 0.0};
+    RTT::types::carray<double> rca(rc, 3);
+    NestedSample rsample;
+    rsample.rows.resize(2, vector<double>(4, 0.0));
+    rsample.values.resize(3);
+
+    rtos_enable_rt_warning();
+    binary_data_iarchive in( blob, out.getArchiveSize() ); // +0 alloc
+    in >> rv >> ra >> rca >> rsample; // +0 alloc
+    rtos_disable_rt_warning();
+
+    BOOST_CHECK_EQUAL( in.getArchiveSize(), out.getArchiveSize() );
+    BOOST_CHECK( rv == v );
+    BOOST_CHECK( ra == a );
+    BOOST_CHECK_EQUAL( rc[0], c[0] );
+    BOOST_CHECK_EQUAL( rc[2], c[2] );
+    BOOST_CHECK_EQUAL( rsample.id, sample.id );
+    BOOST_CHECK( rsample.values == sample.values );
+    BOOST_CHECK( rsample.rows == sample.rows );
+
+    // carrays of non-primitives are written element by element.
+    vector<int> vecs[2] = { vector<int>(2, 1), vector<int>(3, 2) };
+    binary_data_oarchive vout( blob, 1000 );
+    vout << RTT::types::carray< vector<int> >(vecs, 2);
+    binary_data_sizer vsizer;
+    vsizer << RTT::types::carray< vector<int> >(vecs, 2);
+    BOOST_CHECK_EQUAL( vsizer.getArchiveSize(), vout.getArchiveSize() );
+
+    vector<int> rvecs[2];
+    RTT::types::carray< vector<int> > rvca(rvecs, 2);
+    binary_data_iarchive vin( blob, vout.getArchiveSize() );
+    vin >> rvca;
+    BOOST_CHECK( rvecs[0] == vecs[0] );
+    BOOST_CHECK( rvecs[1] == vecs[1] );
+
+    // strings are written as their length followed by their characters.
+    string strs[2] = { "first", "second" };
+    binary_data_oarchive sout2( blob, 1000 );
+    sout2 << RTT::types::carray<string>(strs, 2);
+    binary_data_sizer ssizer;
+    ssizer << RTT::types::carray<string>(strs, 2);
+    BOOST_CHECK_EQUAL( ssizer.getArchiveSize(), sout2.getArchiveSize() );
+    BOOST_CHECK_EQUAL( sout2.getArchiveSize(), 2 * sizeof(boost::serialization::collection_size_type) + strs[0].size() + strs[1].size() );
+
+    string rstrs[2];
+    RTT::types::carray<string> rsca(rstrs, 2);
+    binary_data_iarchive sin2( blob, sout2.getArchiveSize() );
+    sin2 >> rsca;
+    BOOST_CHECK_EQUAL( rstrs[0], strs[0] );
+    BOOST_CHECK_EQUAL( rstrs[1], strs[1] );
+
+    // reading or writing beyond the blob must fail.
+    binary_data_iarchive shortin( blob, 10 );
+    BOOST_CHECK_THROW( shortin >> rv, boost::archive::archive_exception );
+    binary_data_oarchive shortout( blob, 10 );
+    BOOST_CHECK_THROW( shortout << v, boost::archive::archive_exception );
+
+    // a corrupt length fails before anything is allocated for it.
+    boost::serialization::collection_size_type huge( std::size_t(-1) / 2 );
+    memcpy( blob, &huge, sizeof(huge) );
+    binary_data_iarchive hugein( blob, 1000 );
+    BOOST_CHECK_THROW( hugein >> rv, boost::archive::archive_exception );
+    BOOST_CHECK_EQUAL( rv.size(), v.size() );
+}
+
+/**
+ * Measures the marshalled bytes per second for a nested sample,
+ * and the time it takes to only compute its size.
+ */
+BOOST_AUTO_TEST_CASE( testBinaryDataArchiveThroughput )
+{
+    const int rounds = 2000;
+    static char sink[100000];
+    NestedSample sample;
+    sample.id = 1;
+    sample.values.resize(100, 1.0);
+    sample.rows.resize(10, vector<double>(100, 2.0));
+
+    long bytes = 0;
+    os::TimeService::ticks start = os::TimeService::Instance()->getTicks();
+    for (int r = 0; r != rounds; ++r) {
+        io::stream_buffer<io::array_sink>  outbuf(sink,100000);
+        binary_data_oarchive out( outbuf );
+        out << sample;
+        bytes += out.getArchiveSize();
+    }
+    Seconds elapsed = os::TimeService::Instance()->secondsSince( start );
+
+    long blob_bytes = 0;
+    start = os::TimeService::Instance()->getTicks();
+    for (int r = 0; r != rounds; ++r) {
+        binary_data_oarchive out( sink, 100000 );
+        out << sample;
+        blob_bytes += out.getArchiveSize();
+    }
+    Seconds blob_elapsed = os::TimeService::Instance()->secondsSince( start );
+
+    long sized = 0;
+    start = os::TimeService::Instance()->getTicks();
+    for (int r = 0; r != rounds; ++r) {
+        binary_data_sizer sizer;
+        sizer << sample;
+        sized += sizer.getArchiveSize();
+    }
+    Seconds size_elapsed = os::TimeService::Instance()->secondsSince( start );
+
+    BOOST_CHECK_EQUAL( bytes, sized );
+    BOOST_CHECK_EQUAL( bytes, blob_bytes );
+    if ( elapsed > 0 && blob_elapsed > 0 && size_elapsed > 0 )
+        log(Info) << "binary_data_oarchive: " << long(bytes / elapsed) << " bytes/s marshalled to a stream, "
+                  << long(blob_bytes / blob_elapsed) << " bytes/s marshalled to a blob, "
+                  << long(sized / size_elapsed) << " bytes/s sized." << endlog();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -24,6 +24,8 @@
 #include <transports/mqueue/MQLib.hpp>
 #include <transports/mqueue/MQChannelElement.hpp>
 #include <transports/mqueue/MQTemplateProtocol.hpp>
+#include <transports/mqueue/MQSerializationProtocol.hpp>
+#include <boost/serialization/boost_array.hpp>
 #include <os/fosi.h>
 
 using namespace std;
@@ -285,6 +287,102 @@ BOOST_AUTO_TEST_CASE( testPortStreams )
     testPortDisconnected();
 }
 
+BOOST_AUTO_TEST_CASE( testPortStreamsDrain )
+{
+    // Test that a receiver drains a backlog larger than its batch_size
+    // over several wake ups.
+    policy.type = ConnPolicy::BUFFER;
+    policy.pull = false;
+    policy.size = 10;
+    policy.batch_size = 4;
+    policy.name_id = "/buffer1";
+    BOOST_REQUIRE( mw1->createStream( policy ) );
+    BOOST_REQUIRE( mr2->createStream( policy ) );
+
+    for (int i = 0; i != 10; ++i)
+        mw1->write( double(i) );
+    usleep(200000);
+
+    double value = 0;
+    for (int i = 0; i != 10; ++i) {
+        BOOST_CHECK( NewData == mr2->read(value) );
+        BOOST_CHECK_EQUAL( double(i), value );
+    }
+    BOOST_CHECK( OldData == mr2->read(value) );
+
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+}
+
+BOOST_AUTO_TEST_CASE( testPortStreamsBatch )
+{
+    // Test that a batched stream delivers all samples in order.
+    policy.type = ConnPolicy::BUFFER;
+    policy.pull = false;
+    policy.size = 10;
+    policy.batch_size = 10;
+    policy.name_id = "/buffer1";
+    BOOST_REQUIRE( mw1->createStream( policy ) );
+    BOOST_REQUIRE( mr2->createStream( policy ) );
+
+    double value = 0;
+    ASSERT_PORT_SIGNALLING(for (int i = 0; i != 10; ++i) mw1->write( double(i) ), mr2);
+    for (int i = 0; i != 10; ++i) {
+        BOOST_CHECK( NewData == mr2->read(value) );
+        BOOST_CHECK_EQUAL( double(i), value );
+    }
+    BOOST_CHECK( OldData == mr2->read(value) );
+
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+}
+
+/**
+ * Measures the number of samples per second a buffered stream
+ * delivers, with and without batching.
+ */
+BOOST_AUTO_TEST_CASE( testPortStreamsThroughput )
+{
+    const int rounds = 200;
+    policy.type = ConnPolicy::BUFFER;
+    policy.pull = false;
+    policy.size = 10;
+    policy.name_id = "/buffer1";
+    for (int batch_size = 0; batch_size <= 10; batch_size += 10) {
+        policy.batch_size = batch_size;
+        BOOST_REQUIRE( mw1->createStream( policy ) );
+        BOOST_REQUIRE( mr2->createStream( policy ) );
+
+        double value = 0;
+        int received = 0;
+        TimeService::ticks start = TimeService::Instance()->getTicks();
+        for (int r = 0; r != rounds; ++r) {
+            // fill the message queue and wait until all samples arrived.
+            for (int i = 0; i != policy.size; ++i)
+                mw1->write( double(i) );
+            int count = 0;
+            for (int wait = 0; count != policy.size && wait != 10000; ++wait) {
+                if ( mr2->read(value) == NewData ) {
+                    BOOST_CHECK_EQUAL( double(count), value );
+                    ++count;
+                } else
+                    usleep(100);
+            }
+            received += count;
+        }
+        Seconds elapsed = TimeService::Instance()->secondsSince( start );
+        BOOST_CHECK_EQUAL( received, rounds * policy.size );
+        log(Info) << "MQueue throughput with batch_size " << batch_size << ": "
+                  << int(received / elapsed) << " samples/s" << endlog();
+
+        mw1->disconnect();
+        mr2->disconnect();
+        testPortDisconnected();
+    }
+}
+
 BOOST_AUTO_TEST_CASE( testPortStreamsTimeout )
 {
     // Test creating an input stream without an output stream available.
@@ -381,5 +479,51 @@ BOOST_AUTO_TEST_CASE( testVectorTransport )
     rtos_disable_rt_warning();
 }
 
+/**
+ * Fixed size samples are copied without the archive, but must be written
+ * in the same bytes as binary_data_oarchive, such that both sides of a
+ * connection and the data_size of a ConnPolicy keep agreeing.
+ */
+BOOST_AUTO_TEST_CASE( testFixedSizeArchiveFormat )
+{
+    typedef boost::array<double,4> Sample;
+    Sample sample = {{1.0, 2.0, 3.0, 4.0}};
+    mqueue::MQSerializationProtocol<Sample> protocol;
+    internal::ValueDataSource<Sample>::shared_ptr source = new internal::ValueDataSource<Sample>( sample );
+    internal::ValueDataSource<Sample>::shared_ptr target = new internal::ValueDataSource<Sample>();
+    char blob[100];
+    char archived[100];
+
+    mqueue::binary_data_oarchive out( archived, 100 );
+    out << sample;
+
+    std::pair<void const*,int> res = protocol.fillBlob( source, blob, 100, 0 );
+    BOOST_REQUIRE_EQUAL( res.second, int(out.getArchiveSize()) );
+    BOOST_CHECK_EQUAL( res.second, int(protocol.getSampleSize( source, 0 )) );
+    BOOST_CHECK( std::memcmp( blob, archived, res.second ) == 0 );
+    BOOST_CHECK( protocol.updateFromBlob( archived, out.getArchiveSize(), target, 0 ) );
+    BOOST_CHECK( target->get() == sample );
+
+    // a truncated blob is rejected.
+    target->set( Sample() );
+    BOOST_CHECK( !protocol.updateFromBlob( blob, res.second - 4, target, 0 ) );
+    BOOST_CHECK( target->get() == Sample() );
+
+    // a blob too small to hold the sample is not written.
+    BOOST_CHECK_EQUAL( protocol.fillBlob( source, blob, res.second - 1, 0 ).second, 0 );
+
+    // primitive types are written as themselves.
+    mqueue::MQSerializationProtocol<double> dprotocol;
+    internal::ValueDataSource<double>::shared_ptr dsource = new internal::ValueDataSource<double>( 6.66 );
+    internal::ValueDataSource<double>::shared_ptr dtarget = new internal::ValueDataSource<double>( 0.0 );
+    mqueue::binary_data_oarchive dout( archived, 100 );
+    dout << dsource->rvalue();
+    res = dprotocol.fillBlob( dsource, blob, 100, 0 );
+    BOOST_REQUIRE_EQUAL( res.second, int(dout.getArchiveSize()) );
+    BOOST_CHECK( std::memcmp( blob, archived, res.second ) == 0 );
+    BOOST_CHECK( dprotocol.updateFromBlob( blob, res.second, dtarget, 0 ) );
+    BOOST_CHECK_EQUAL( dtarget->get(), 6.66 );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -24,6 +24,10 @@
 #include "TaskContext.hpp"
 #include "plugin/Plugin.hpp"
 #include "plugin/PluginLoader.hpp"
+#include "plugin/LibraryCache.hpp"
+#include "deployment/ComponentLoader.hpp"
+#include "os/TimeService.hpp"
+#include <algorithm>
 
 /* For internal use only - check if extension contains a version. */
 RTT_API bool isExtensionVersion(const std::string& ext);
@@ -234,5 +238,56 @@ BOOST_AUTO_TEST_CASE( testServicePlugin )
 
 }
 
+/** Imports a component library once to fill the library cache, and a second
+ * time from the cache, in which case it is only loaded when a component
+ * is created. Logs the time of both imports.
+ */
+BOOST_AUTO_TEST_CASE( testLibraryCache )
+{
+    using namespace boost::filesystem;
+    std::string dir = is_directory("testproject/components") ? "testproject/components" : "../testproject/components";
+    std::string cache_file = "plugins_test.cache";
+    remove( path(cache_file) );
+
+    LibraryCache::shared_ptr lc = LibraryCache::Instance();
+    BOOST_REQUIRE( lc->setCacheFile( cache_file ) );
+    BOOST_CHECK( lc->isEnabled() );
+
+    // cold start: scans and loads the library.
+    os::TimeService::ticks t = os::TimeService::Instance()->getTicks();
+    BOOST_REQUIRE( ComponentLoader::Instance()->import( dir ) );
+    os::TimeService::Seconds cold = os::TimeService::Instance()->secondsSince( t );
+    BOOST_CHECK( ComponentLoader::Instance()->isImported("ComponentPluginTest") );
+    BOOST_CHECK( lc->save() );
+    BOOST_CHECK( exists( path(cache_file) ) );
+
+    // forget the library, and read the cache back in as a new process would.
+    ComponentLoader::Release();
+    ComponentFactories::Instance().erase("ComponentPluginTest");
+    BOOST_REQUIRE( lc->setCacheFile( cache_file ) );
+
+    // warm start: the component type is found in the cache.
+    t = os::TimeService::Instance()->getTicks();
+    BOOST_REQUIRE( ComponentLoader::Instance()->import( dir ) );
+    os::TimeService::Seconds warm = os::TimeService::Instance()->secondsSince( t );
+    BOOST_CHECK( ComponentLoader::Instance()->isImported("ComponentPluginTest") );
+    BOOST_CHECK( ComponentLoader::Instance()->getFactories().count("ComponentPluginTest") == 0 );
+    std::vector<std::string> types = ComponentLoader::Instance()->listComponentTypes();
+    BOOST_CHECK( std::find(types.begin(), types.end(), "ComponentPluginTest") != types.end() );
+
+    // the library is loaded when the component is created.
+    TaskContext* comp = ComponentLoader::Instance()->loadComponent("comp", "ComponentPluginTest");
+    BOOST_REQUIRE( comp );
+    BOOST_CHECK( ComponentLoader::Instance()->getFactories().count("ComponentPluginTest") == 1 );
+    BOOST_CHECK( ComponentLoader::Instance()->unloadComponent( comp ) );
+
+    log(Info) << "Import of " << dir << ": " << cold * 1000.0 << "ms without cache, "
+              << warm * 1000.0 << "ms with cache." << endlog();
+
+    ComponentLoader::Release();
+    BOOST_CHECK( lc->setCacheFile("") );
+    remove( path(cache_file) );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
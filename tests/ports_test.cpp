@@ -273,6 +273,330 @@ BOOST_AUTO_TEST_CASE(testPortSimpleConnections)
     BOOST_CHECK( !wp.connected() );
 }
 
+BOOST_AUTO_TEST_CASE(testPortLoanedSamples)
+{
+    OutputPort< std::vector<double> > wp("W", false);
+    InputPort< std::vector<double> > rp("R");
+    InputPort< std::vector<double> > rp2("R2");
+    SampleRef< std::vector<double> > ref;
+
+    // not connected: nothing to loan or read.
+    BOOST_CHECK( wp.loan() == 0 );
+    BOOST_CHECK_EQUAL( rp.readRef(ref), NoData );
+    BOOST_CHECK( !ref.valid() );
+
+    BOOST_REQUIRE( wp.createConnection(rp, ConnPolicy::buffer(2)) );
+
+    // a lock-free buffer lends its storage to writer and reader.
+    std::vector<double>* loaned = wp.loan();
+    BOOST_REQUIRE( loaned != 0 );
+    BOOST_CHECK( wp.loan() == 0 ); // only one loan at a time
+    loaned->assign(10, 1.0);
+    wp.commit(loaned);
+
+    BOOST_CHECK_EQUAL( rp.readRef(ref), NewData );
+    BOOST_REQUIRE( ref.valid() );
+    BOOST_CHECK( ref.isShared() );
+    BOOST_CHECK( ref.get() == loaned );
+    BOOST_CHECK_EQUAL( ref->size(), 10u );
+    BOOST_CHECK_EQUAL( rp.readRef(ref), OldData );
+    BOOST_CHECK( ref.get() == loaned );
+
+    // the shared element is not recycled while we hold it.
+    for (int i=0; i != 4; ++i) {
+        loaned = wp.loan();
+        BOOST_REQUIRE( loaned != 0 );
+        BOOST_CHECK( loaned != ref.get() );
+        loaned->assign(1, double(i));
+        wp.commit(loaned);
+        std::vector<double> value;
+        BOOST_CHECK_EQUAL( rp.read(value), NewData );
+        BOOST_CHECK_EQUAL( value.size(), 1u );
+        BOOST_CHECK_EQUAL( (*ref)[0], 1.0 );
+    }
+
+    // discarded loans are not delivered.
+    loaned = wp.loan();
+    BOOST_REQUIRE( loaned != 0 );
+    wp.discard(loaned);
+    ref.reset();
+    BOOST_CHECK_EQUAL( rp.readRef(ref), OldData );
+    BOOST_CHECK_EQUAL( (*ref)[0], 3.0 );
+
+    // a full buffer still has room while the reader refers to an old
+    // sample and the writer holds a loan.
+    std::vector<double> value(1, 4.0);
+    wp.write(value);
+    BOOST_CHECK_EQUAL( rp.read(value), NewData );
+    BOOST_CHECK_EQUAL( (*ref)[0], 3.0 );
+    loaned = wp.loan();
+    BOOST_REQUIRE( loaned != 0 );
+    for (int i=0; i != 2; ++i) {
+        value.assign(1, 5.0 + i);
+        wp.write(value);
+    }
+    wp.discard(loaned);
+    for (int i=0; i != 2; ++i) {
+        BOOST_CHECK_EQUAL( rp.read(value), NewData );
+        BOOST_CHECK_EQUAL( value[0], 5.0 + i );
+    }
+
+    // a second connection receives a copy of the loaned sample.
+    BOOST_REQUIRE( wp.createConnection(rp2, ConnPolicy::data()) );
+    loaned = wp.loan();
+    BOOST_REQUIRE( loaned != 0 );
+    loaned->assign(3, 5.0);
+    wp.commit(loaned);
+    BOOST_CHECK_EQUAL( rp.readRef(ref), NewData );
+    BOOST_CHECK( ref.isShared() );
+    BOOST_CHECK_EQUAL( ref->size(), 3u );
+    SampleRef< std::vector<double> > ref2;
+    BOOST_CHECK_EQUAL( rp2.readRef(ref2), NewData );
+    BOOST_CHECK( !ref2.isShared() );
+    BOOST_CHECK_EQUAL( ref2->size(), 3u );
+
+    // a reference outlives the connection
+    wp.disconnect();
+    BOOST_CHECK_EQUAL( ref->size(), 3u );
+    ref.reset();
+}
+
+BOOST_AUTO_TEST_CASE(testPortLoanOnDisconnectedChannel)
+{
+    // a writer element which loses its output between loan() and
+    // commit() gives the sample back to the buffer's pool.
+    ChannelElement<int>::shared_ptr buffer( new ChannelBufferElement<int>( BufferInterface<int>::shared_ptr( new BufferLockFree<int>(2) ) ) );
+    ChannelElement<int>::shared_ptr writer( new ChannelElement<int>() );
+    for (int i = 0; i != 20; ++i) {
+        writer->setOutput( buffer );
+        int* loaned = writer->loan();
+        BOOST_REQUIRE( loaned != 0 );
+        writer->disconnect(false);
+        BOOST_CHECK( writer->getOutput() == 0 );
+        BOOST_CHECK( writer->commit(loaned) == false );
+    }
+    // the same for a loan which is given back.
+    for (int i = 0; i != 20; ++i) {
+        writer->setOutput( buffer );
+        int* loaned = writer->loan();
+        BOOST_REQUIRE( loaned != 0 );
+        writer->disconnect(false);
+        writer->release(loaned);
+    }
+    // no element was lost: the buffer still fills up completely.
+    writer->setOutput( buffer );
+    int value = 0;
+    for (int i = 0; i != 2; ++i) {
+        int* loaned = writer->loan();
+        BOOST_REQUIRE( loaned != 0 );
+        *loaned = i;
+        BOOST_CHECK( writer->commit(loaned) );
+    }
+    for (int i = 0; i != 2; ++i) {
+        BOOST_CHECK_EQUAL( buffer->read(value, false), NewData );
+        BOOST_CHECK_EQUAL( value, i );
+    }
+    writer->disconnect(true);
+
+    // the same through the ports.
+    OutputPort<int> wp("W", false);
+    InputPort<int> rp("R");
+    for (int i = 0; i != 20; ++i) {
+        BOOST_REQUIRE( wp.createConnection(rp, ConnPolicy::buffer(2)) );
+        int* loaned = wp.loan();
+        BOOST_REQUIRE( loaned != 0 );
+        rp.disconnect();
+        *loaned = i;
+        wp.commit(loaned);
+        BOOST_CHECK_EQUAL( rp.read(value), NoData );
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testPortBroadcastConnections)
+{
+    OutputPort<int> wp("W");
+    InputPort<int> rp1("R1");
+    InputPort<int> rp2("R2");
+    InputPort<int> rp3("R3");
+
+    BOOST_REQUIRE( wp.createConnection(rp1, ConnPolicy::broadcast(4)) );
+    BOOST_REQUIRE( wp.createConnection(rp2, ConnPolicy::broadcast(4)) );
+
+    // both readers share the storage of one group.
+    std::list<ConnectionManager::ChannelDescriptor> channels = wp.getManager()->getChannels();
+    BOOST_REQUIRE_EQUAL( channels.size(), 2u );
+    ChannelBroadcastElement<int>* first = dynamic_cast<ChannelBroadcastElement<int>*>( channels.front().get<1>()->getOutput().get() );
+    ChannelBroadcastElement<int>* second = dynamic_cast<ChannelBroadcastElement<int>*>( channels.back().get<1>()->getOutput().get() );
+    BOOST_REQUIRE( first && second );
+    BOOST_CHECK( first->getBuffer() == second->getBuffer() );
+    BOOST_CHECK_EQUAL( first->getBuffer()->nbReaders(), 2u );
+
+    int value = 0;
+    wp.write(1);
+    wp.write(2);
+    BOOST_CHECK_EQUAL( rp1.read(value), NewData );
+    BOOST_CHECK_EQUAL( value, 1 );
+    BOOST_CHECK_EQUAL( rp1.read(value), NewData );
+    BOOST_CHECK_EQUAL( value, 2 );
+    BOOST_CHECK_EQUAL( rp1.read(value), OldData );
+    BOOST_CHECK_EQUAL( value, 2 );
+
+    // each reader has its own position, a late joiner only sees new samples
+    BOOST_REQUIRE( wp.createConnection(rp3, ConnPolicy::broadcast(4)) );
+    for (int i = 3; i != 9; ++i)
+        wp.write(i);
+    BOOST_CHECK_EQUAL( rp3.read(value), NewData );
+    BOOST_CHECK_EQUAL( value, 5 );
+
+    // a slow reader skips the overwritten samples.
+    BOOST_CHECK_EQUAL( rp2.read(value), NewData );
+    BOOST_CHECK_EQUAL( value, 5 );
+    BOOST_CHECK_EQUAL( rp1.read(value), NewData );
+    BOOST_CHECK_EQUAL( value, 5 );
+
+    // the group continues when its writer leaves.
+    rp1.disconnect();
+    wp.write(9);
+    for (int i = 6; i != 10; ++i) {
+        BOOST_CHECK_EQUAL( rp2.read(value), NewData );
+        BOOST_CHECK_EQUAL( value, i );
+        BOOST_CHECK_EQUAL( rp3.read(value), NewData );
+        BOOST_CHECK_EQUAL( value, i );
+    }
+    BOOST_CHECK_EQUAL( rp2.read(value), OldData );
+
+    // samples are shared with the readers
+    SampleRef<int> ref2, ref3;
+    wp.write(10);
+    BOOST_CHECK_EQUAL( rp2.readRef(ref2), NewData );
+    BOOST_CHECK_EQUAL( rp3.readRef(ref3), NewData );
+    BOOST_CHECK( ref2.isShared() );
+    BOOST_CHECK( ref2.get() == ref3.get() );
+    BOOST_CHECK_EQUAL( *ref2, 10 );
+    for (int i = 0; i != 10; ++i)
+        wp.write(i);
+    BOOST_CHECK_EQUAL( *ref3, 10 );
+
+    // a loaned sample is published to all readers.
+    rp2.clear();
+    rp3.clear();
+    int* loaned = wp.loan();
+    BOOST_REQUIRE( loaned != 0 );
+    *loaned = 42;
+    wp.commit(loaned);
+    BOOST_CHECK_EQUAL( rp2.readRef(ref2), NewData );
+    BOOST_CHECK_EQUAL( rp3.readRef(ref3), NewData );
+    BOOST_CHECK( ref2.get() == loaned );
+    BOOST_CHECK( ref3.get() == loaned );
+    BOOST_CHECK_EQUAL( *ref3, 42 );
+    ref2.reset();
+    ref3.reset();
+
+    // the group is not limited to a fixed number of readers.
+    std::vector< InputPort<int>* > many;
+    for (int i = 0; i != 100; ++i) {
+        many.push_back( new InputPort<int>("M") );
+        BOOST_REQUIRE( wp.createConnection(*many.back(), ConnPolicy::broadcast(4)) );
+    }
+    BOOST_CHECK_EQUAL( second->getBuffer()->nbReaders(), 102u );
+    wp.write(43);
+    for (unsigned int i = 0; i != many.size(); ++i) {
+        BOOST_CHECK_EQUAL( many[i]->read(value), NewData );
+        BOOST_CHECK_EQUAL( value, 43 );
+        delete many[i];
+    }
+    wp.disconnect();
+}
+
+BOOST_AUTO_TEST_CASE(testPortConnectionStatistics)
+{
+    OutputPort<int> wp("W");
+    InputPort<int> rp1("R1");
+    InputPort<int> rp2("R2");
+    InputPort<int> rp3("R3");
+    tc->ports()->addPort(wp);
+    tc->ports()->addPort(rp1);
+
+    BOOST_REQUIRE( wp.createConnection(rp1, ConnPolicy::buffer(2)) );
+    BOOST_REQUIRE( wp.createConnection(rp2, ConnPolicy::circularBuffer(2, ConnPolicy::LOCKED)) );
+    BOOST_REQUIRE( wp.createConnection(rp3, ConnPolicy::data()) );
+    BOOST_CHECK_EQUAL( wp.getConnectionStatistics().size(), 3u );
+
+    for (int i = 0; i != 3; ++i)
+        wp.write(i);
+    int value = 0;
+    BOOST_CHECK_EQUAL( rp1.read(value), NewData );
+
+    // a full buffer drops new samples.
+    std::vector<ChannelStatistics> stats = rp1.getConnectionStatistics();
+    BOOST_REQUIRE_EQUAL( stats.size(), 1u );
+    BOOST_CHECK_EQUAL( stats[0].peer, "root.W" );
+    BOOST_CHECK_EQUAL( stats[0].writes, 3u );
+    BOOST_CHECK_EQUAL( stats[0].reads, 1u );
+    BOOST_CHECK_EQUAL( stats[0].drops, 1u );
+    BOOST_CHECK_EQUAL( stats[0].overwrites, 0u );
+    BOOST_CHECK_EQUAL( stats[0].size, 1 );
+    BOOST_CHECK_EQUAL( stats[0].high_water, 2 );
+    BOOST_CHECK_EQUAL( stats[0].capacity, 2 );
+
+    // a circular buffer overwrites the oldest samples.
+    stats = rp2.getConnectionStatistics();
+    BOOST_REQUIRE_EQUAL( stats.size(), 1u );
+    BOOST_CHECK_EQUAL( stats[0].peer, "root.W" );
+    BOOST_CHECK_EQUAL( stats[0].writes, 3u );
+    BOOST_CHECK_EQUAL( stats[0].drops, 0u );
+    BOOST_CHECK_EQUAL( stats[0].overwrites, 1u );
+    BOOST_CHECK_EQUAL( stats[0].size, 2 );
+
+    // a data connection overwrites unread samples.
+    stats = tc->ports()->getConnectionStatistics("W");
+    BOOST_REQUIRE_EQUAL( stats.size(), 3u );
+    stats = rp3.getConnectionStatistics();
+    BOOST_REQUIRE_EQUAL( stats.size(), 1u );
+    BOOST_CHECK_EQUAL( stats[0].writes, 3u );
+    BOOST_CHECK_EQUAL( stats[0].overwrites, 2u );
+    BOOST_CHECK_EQUAL( stats[0].capacity, 1 );
+
+    // only available through the 'engine' service, which is loaded on request.
+    BOOST_CHECK( !tc->provides()->hasOperation("dumpConnectionStatistics") );
+    BOOST_REQUIRE( tc->loadService("engine") );
+    BOOST_CHECK( tc->provides()->getService("engine")->hasOperation("dumpConnectionStatistics") );
+    std::string dump = tc->ports()->dumpConnectionStatistics();
+    BOOST_CHECK( dump.find("W <-> root.R1: writes 3, reads 1, drops 1") != std::string::npos );
+    BOOST_CHECK( dump.find("R1 <-> root.W") != std::string::npos );
+
+    wp.disconnect();
+    BOOST_CHECK( wp.getConnectionStatistics().empty() );
+    tc->ports()->removePort("W");
+    tc->ports()->removePort("R1");
+}
+
+BOOST_AUTO_TEST_CASE(testPortSeqLockConnection)
+{
+    OutputPort<double> wp("W");
+    InputPort<double> rp("R");
+    ConnPolicy policy = ConnPolicy::data(ConnPolicy::SEQLOCK);
+    policy.size = 4;
+    BOOST_REQUIRE( wp.createConnection(rp, policy) );
+
+    double value = 0;
+    BOOST_CHECK_EQUAL( rp.read(value), NoData );
+    for (int i = 1; i != 10; ++i)
+        wp.write(i);
+    BOOST_CHECK_EQUAL( rp.read(value), NewData );
+    BOOST_CHECK_EQUAL( value, 9.0 );
+    BOOST_CHECK_EQUAL( rp.read(value), OldData );
+
+    // types which can not be copied bit by bit fall back to LOCK_FREE.
+    OutputPort<std::string> swp("SW");
+    InputPort<std::string> srp("SR");
+    BOOST_REQUIRE( swp.createConnection(srp, policy) );
+    swp.write("seqlock");
+    std::string text;
+    BOOST_CHECK_EQUAL( srp.read(text), NewData );
+    BOOST_CHECK_EQUAL( text, "seqlock" );
+}
+
 BOOST_AUTO_TEST_CASE(testPortOneWriterThreeReaders)
 {
     OutputPort<int> wp("W");
@@ -611,6 +935,63 @@ BOOST_AUTO_TEST_CASE(testEventPortSignalling)
     tce->resetStats();
 }
 
+BOOST_AUTO_TEST_CASE(testEventPortCoalescing)
+{
+    OutputPort<double> wp1("Write");
+    InputPort<double>  rp1("Read");
+
+    tce->addEventPort(rp1,boost::bind(&PortsTestFixture::new_data_listener, this, _1) );
+    wp1.createConnection(rp1, ConnPolicy::buffer(10));
+
+    // while stopped, the events are merged until the next update.
+    signalled_port = 0;
+    wp1.write(0.1);
+    wp1.write(0.2);
+    wp1.write(0.3);
+    BOOST_CHECK(0 == signalled_port);
+    BOOST_CHECK_EQUAL( tce->ports()->getCoalescedEvents("Read"), 2u );
+    BOOST_CHECK( tce->ports()->dumpConnectionStatistics().find("Read: coalesced events 2") != std::string::npos );
+
+    // the callback is called once for all pending samples.
+    tce->resetStats();
+    BOOST_CHECK( tce->start() );
+    BOOST_CHECK(&rp1 == signalled_port);
+    BOOST_CHECK(tce->had_event);
+
+    // a sequential activity handles each sample right away.
+    signalled_port = 0;
+    wp1.write(0.4);
+    BOOST_CHECK(&rp1 == signalled_port);
+    BOOST_CHECK_EQUAL( tce->ports()->getCoalescedEvents("Read"), 2u );
+    BOOST_CHECK_EQUAL( tce->ports()->getCoalescedEvents("Write"), 0u );
+    tce->stop();
+
+    // a removed port no longer reports events.
+    int index = rp1.getEventIndex();
+    BOOST_CHECK( index >= 0 );
+    tce->ports()->removePort("Read");
+    BOOST_CHECK_EQUAL( rp1.getEventIndex(), -1 );
+    BOOST_CHECK_EQUAL( tce->ports()->getCoalescedEvents("Read"), 0u );
+
+    // the next event port reuses the cleared entry, with fresh counters.
+    InputPort<double> rp2("Read2");
+    tce->addEventPort(rp2);
+    BOOST_CHECK_EQUAL( rp2.getEventIndex(), index );
+    BOOST_CHECK_EQUAL( tce->ports()->getCoalescedEvents("Read2"), 0u );
+    BOOST_REQUIRE( wp1.createConnection(rp2, ConnPolicy::buffer(10)) );
+    wp1.write(0.5);
+    wp1.write(0.6);
+    BOOST_CHECK_EQUAL( tce->ports()->getCoalescedEvents("Read2"), 1u );
+
+    // a port that is added again gets a new entry.
+    tce->addEventPort(rp1);
+    BOOST_CHECK( rp1.getEventIndex() >= 0 );
+    BOOST_CHECK( rp1.getEventIndex() != index );
+    BOOST_CHECK_EQUAL( tce->ports()->getCoalescedEvents("Read"), 0u );
+    tce->ports()->removePort("Read");
+    tce->ports()->removePort("Read2");
+}
+
 BOOST_AUTO_TEST_CASE(testPlainPortNotSignalling)
 {
     OutputPort<double> wp1("Write");
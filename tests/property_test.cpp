@@ -17,6 +17,7 @@
  ***************************************************************************/
 
 #include <typeinfo>
+#include <sstream>
 #include <marsh/PropertyBagIntrospector.hpp>
 #include <internal/DataSourceTypeInfo.hpp>
 #include <types/PropertyDecomposition.hpp>
@@ -203,6 +204,76 @@ BOOST_AUTO_TEST_CASE( testfindProperty )
 
 }
 
+// PropertyBag::setIndexed and findProperty( bag, PropertyPath )
+BOOST_AUTO_TEST_CASE( testIndexedBag )
+{
+    PropertyBag big;
+    big.setIndexed( true );
+    BOOST_CHECK( big.isIndexed() );
+    for ( int i = 0; i != 1000; ++i ) {
+        std::stringstream name;
+        name << "p" << i;
+        big.ownProperty( new Property<int>( name.str(), "", i ) );
+    }
+    BOOST_REQUIRE_EQUAL( big.size(), 1000 );
+    BOOST_CHECK( big.find( "p0" ) == big.getItem(0) );
+    BOOST_CHECK( big.find( "p999" ) == big.getItem(999) );
+    BOOST_CHECK( big.getProperty( "p500" ) == big.getItem(500) );
+    BOOST_CHECK( big.find( "p1000" ) == 0 );
+    BOOST_REQUIRE( big.getPropertyType<int>( "p42" ) );
+    BOOST_CHECK_EQUAL( big.getPropertyType<int>( "p42" )->value(), 42 );
+    BOOST_CHECK( big.getPropertyType<double>( "p42" ) == 0 );
+
+    // the first property with a name is found, also after removing it.
+    Property<double> dup( "p7", "", 7.0 );
+    big.add( &dup );
+    BOOST_CHECK( big.find( "p7" ) == big.getItem(7) );
+    BOOST_CHECK( big.getPropertyType<double>( "p7" ) == &dup );
+    big.removeProperty( big.getItem(7) );
+    BOOST_CHECK( big.find( "p7" ) == &dup );
+    big.remove( &dup );
+    BOOST_CHECK( big.find( "p7" ) == 0 );
+
+    // renaming requires a reindex.
+    PropertyBase* p9 = big.find( "p9" );
+    BOOST_REQUIRE( p9 );
+    p9->setName( "renamed" );
+    BOOST_CHECK( big.find( "p9" ) == 0 );
+    BOOST_CHECK( big.find( "renamed" ) == 0 );
+    big.setIndexed( true );
+    BOOST_CHECK( big.find( "renamed" ) == p9 );
+
+    // copies keep the index.
+    PropertyBag copy( big );
+    BOOST_CHECK( copy.isIndexed() );
+    BOOST_CHECK( copy.find( "p10" ) != 0 );
+    big.clear();
+    BOOST_CHECK( big.find( "p10" ) == 0 );
+    big.setIndexed( false );
+    BOOST_CHECK( !big.isIndexed() );
+
+    // refresh and update large bags.
+    PropertyBag target;
+    BOOST_CHECK( updateProperties( target, copy ) );
+    BOOST_CHECK_EQUAL( target.size(), copy.size() );
+    BOOST_REQUIRE( target.getPropertyType<int>( "p999" ) );
+    BOOST_CHECK_EQUAL( target.getPropertyType<int>( "p999" )->value(), 999 );
+    copy.getPropertyType<int>( "p999" )->set( -1 );
+    BOOST_CHECK( refreshProperties( target, copy, true ) );
+    BOOST_CHECK_EQUAL( target.getPropertyType<int>( "p999" )->value(), -1 );
+    deleteProperties( target );
+
+    // precompiled paths.
+    PropertyPath path = splitPropertyPath( "s1.s2.pc" );
+    BOOST_REQUIRE_EQUAL( path.size(), 3 );
+    BOOST_CHECK_EQUAL( path[0], "s1" );
+    BOOST_CHECK( findProperty( bag, path ) == &pc );
+    BOOST_CHECK( findProperty( bag, splitPropertyPath( "/s1/s2/ps", "/" ) ) == &ps );
+    BOOST_CHECK( findProperty( bag, splitPropertyPath( ".pi1" ) ) == pi1 );
+    BOOST_CHECK( findProperty( bag, splitPropertyPath( "s1.pf" ) ) == &pf );
+    BOOST_CHECK( findProperty( bag, splitPropertyPath( "s1.px" ) ) == 0 );
+}
+
 // listProperties( bag, separator )
 BOOST_AUTO_TEST_CASE( testlistProperties )
 {
@@ -0,0 +1,526 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  shm_test.cpp
+
+                        shm_test.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "unit.hpp"
+
+#include <iostream>
+
+#include <Service.hpp>
+#include <transports/shm/ShmLib.hpp>
+#include <transports/shm/ShmRing.hpp>
+#include <transports/shm/ShmDispatcher.hpp>
+#include <os/fosi.h>
+
+#include <InputPort.hpp>
+#include <OutputPort.hpp>
+#include <TaskContext.hpp>
+#include <string>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include <boost/scoped_array.hpp>
+
+using namespace std;
+using namespace RTT;
+using namespace RTT::detail;
+
+class ShmTest
+{
+public:
+    ShmTest()
+    {
+        mr2 = new InputPort<double>("mr");
+        mw1 = new OutputPort<double>("mw");
+
+        tc =  new TaskContext( "root" );
+        tc->ports()->addPort( *mw1 );
+
+        t2 = new TaskContext("other");
+        t2->ports()->addEventPort( *mr2, boost::bind(&ShmTest::new_data_listener, this, _1) );
+
+        tc->start();
+        t2->start();
+    }
+
+    ~ShmTest()
+    {
+        delete tc;
+        delete t2;
+
+        delete mw1;
+        delete mr2;
+    }
+
+    TaskContext* tc;
+    TaskContext* t2;
+
+    PortInterface* signalled_port;
+    void new_data_listener(PortInterface* port)
+    {
+        signalled_port = port;
+    }
+
+    // Ports
+    OutputPort<double>* mw1;
+    InputPort<double>*  mr2;
+
+    ConnPolicy policy;
+
+    // helper test functions
+    void testPortDataConnection();
+    void testPortBufferConnection();
+    void testPortDisconnected();
+};
+
+class ShmFixture : public ShmTest
+{
+public:
+    ShmFixture() {
+        // Create a default policy specification
+        policy.type = ConnPolicy::DATA;
+        policy.init = false;
+        policy.lock_policy = ConnPolicy::LOCK_FREE;
+        policy.size = 0;
+        policy.pull = true;
+        policy.transport = ORO_SHM_PROTOCOL_ID;
+    }
+};
+
+#define ASSERT_PORT_SIGNALLING(code, read_port) \
+    signalled_port = 0; \
+    code; \
+    rtos_disable_rt_warning(); \
+    usleep(100000); \
+    rtos_enable_rt_warning(); \
+    BOOST_CHECK( read_port == signalled_port );
+
+void ShmTest::testPortDataConnection()
+{
+    rtos_enable_rt_warning();
+    // This test assumes that there is a data connection mw1 => mr2
+    // Check if connection succeeded both ways:
+    BOOST_CHECK( mw1->connected() );
+    BOOST_CHECK( mr2->connected() );
+
+    double value = 0;
+
+    // Check if no-data works
+    BOOST_CHECK( NoData == mr2->read(value) );
+
+    // Check if writing works (including signalling)
+    ASSERT_PORT_SIGNALLING(mw1->write(1.0), mr2)
+    BOOST_CHECK( mr2->read(value) );
+    BOOST_CHECK_EQUAL( 1.0, value );
+    ASSERT_PORT_SIGNALLING(mw1->write(2.0), mr2);
+    BOOST_CHECK( mr2->read(value) );
+    BOOST_CHECK_EQUAL( 2.0, value );
+    BOOST_CHECK( OldData == mr2->read(value) );
+
+    rtos_disable_rt_warning();
+}
+
+void ShmTest::testPortBufferConnection()
+{
+    rtos_enable_rt_warning();
+    // This test assumes that there is a buffer connection mw1 => mr2 of size 3
+    // Check if connection succeeded both ways:
+    BOOST_CHECK( mw1->connected() );
+    BOOST_CHECK( mr2->connected() );
+
+    double value = 0;
+
+    // Check if no-data works
+    BOOST_CHECK( NoData == mr2->read(value) );
+
+    // Check if writing works
+    ASSERT_PORT_SIGNALLING(mw1->write(1.0), mr2);
+    ASSERT_PORT_SIGNALLING(mw1->write(2.0), mr2);
+    ASSERT_PORT_SIGNALLING(mw1->write(3.0), mr2);
+    ASSERT_PORT_SIGNALLING(mw1->write(4.0), 0);  // because size == 3
+    BOOST_CHECK( mr2->read(value) );
+    BOOST_CHECK_EQUAL( 1.0, value );
+    BOOST_CHECK( mr2->read(value) );
+    BOOST_CHECK_EQUAL( 2.0, value );
+    BOOST_CHECK( mr2->read(value) );
+    BOOST_CHECK_EQUAL( 3.0, value );
+    BOOST_CHECK( OldData == mr2->read(value) );
+
+    rtos_disable_rt_warning();
+}
+
+void ShmTest::testPortDisconnected()
+{
+    BOOST_CHECK( !mw1->connected() );
+    BOOST_CHECK( !mr2->connected() );
+}
+
+
+// Registers the fixture into the 'registry'
+BOOST_FIXTURE_TEST_SUITE(  ShmTestSuite,  ShmFixture )
+
+/**
+ * Tests the ring itself: a lapped reader must skip to the oldest
+ * sample that was not overwritten, and a second reader must see the
+ * same samples as the first.
+ */
+BOOST_AUTO_TEST_CASE( testRing )
+{
+    shm::ShmRing writer, reader1, reader2;
+    BOOST_REQUIRE( writer.create("/ring1", 4, sizeof(int)) );
+    BOOST_REQUIRE( reader1.attach("/ring1") );
+    BOOST_REQUIRE( reader2.attach("/ring1") );
+    BOOST_CHECK_EQUAL( reader1.slotCount(), 4u );
+    BOOST_CHECK_EQUAL( reader1.slotSize(), sizeof(int) );
+
+    shm::ShmRing::Sequence cursor1 = 0, cursor2 = 0;
+    int value = 0;
+    BOOST_CHECK_EQUAL( reader1.read(cursor1, (char*)&value), 0u );
+    BOOST_CHECK( reader1.wait(cursor1, 0.01) == false );
+
+    for (int i = 1; i != 11; ++i) {
+        *(int*)writer.beginWrite() = i;
+        writer.commitWrite( sizeof(int) );
+    }
+    BOOST_CHECK_EQUAL( writer.latest(), 10u );
+    BOOST_CHECK( reader1.wait(cursor1, 0.01) );
+
+    // samples 1 to 6 were overwritten.
+    for (int i = 7; i != 11; ++i) {
+        BOOST_CHECK_EQUAL( reader1.read(cursor1, (char*)&value), sizeof(int) );
+        BOOST_CHECK_EQUAL( value, i );
+        BOOST_CHECK_EQUAL( cursor1, shm::ShmRing::Sequence(i) );
+    }
+    BOOST_CHECK_EQUAL( reader1.read(cursor1, (char*)&value), 0u );
+
+    cursor2 = 8;
+    BOOST_CHECK_EQUAL( reader2.read(cursor2, (char*)&value), sizeof(int) );
+    BOOST_CHECK_EQUAL( value, 9 );
+
+    // a writer with the same geometry re-uses the segment.
+    shm::ShmRing writer2;
+    BOOST_REQUIRE( writer2.create("/ring1", 4, sizeof(int)) );
+    BOOST_CHECK_EQUAL( writer2.latest(), 10u );
+    BOOST_CHECK( reader1.replaced() == false );
+
+    // a writer with another geometry replaces it, and its readers see that.
+    shm::ShmRing writer3;
+    BOOST_REQUIRE( writer3.create("/ring1", 8, sizeof(int)) );
+    BOOST_CHECK_EQUAL( writer3.latest(), 0u );
+    BOOST_CHECK( reader1.replaced() );
+    BOOST_CHECK( reader1.wait(cursor1, 0.01) );
+    BOOST_REQUIRE( reader1.attach("/ring1") );
+    BOOST_CHECK_EQUAL( reader1.slotCount(), 8u );
+    BOOST_CHECK( reader1.replaced() == false );
+
+    // zero is the cursor before the first sample.
+    BOOST_CHECK_EQUAL( reader1.previous(1), 0u );
+    BOOST_CHECK_EQUAL( reader1.previous(0, 8) % 8, 0u );
+
+    writer.close();
+    writer2.close();
+    writer3.close();
+    BOOST_CHECK( shm::ShmRing::unlink("/ring1") );
+    BOOST_CHECK( reader2.attach("/ring1") == false );
+}
+
+/**
+ * Tests that waitAny() also sees the rings beyond the ones it can
+ * wait on at once, which it polls.
+ */
+BOOST_AUTO_TEST_CASE( testRingWaitAny )
+{
+    const unsigned int count = shm::ShmRing::maxWaitAny() + 1;
+    boost::scoped_array<shm::ShmRing> writers( new shm::ShmRing[count] ), readers( new shm::ShmRing[count] );
+    std::vector<const shm::ShmRing*> rings( count );
+    std::vector<shm::ShmRing::Sequence> cursors( count, 0 );
+    for (unsigned int i = 0; i != count; ++i) {
+        std::string name = "/waitany" + boost::lexical_cast<std::string>(i);
+        BOOST_REQUIRE( writers[i].create(name, 2, sizeof(int)) );
+        BOOST_REQUIRE( readers[i].attach(name) );
+        rings[i] = &readers[i];
+    }
+    BOOST_CHECK( shm::ShmRing::waitAny(&rings[0], &cursors[0], count, 0.01) == false );
+
+    *(int*)writers[count - 1].beginWrite() = 1;
+    writers[count - 1].commitWrite( sizeof(int) );
+    BOOST_CHECK( shm::ShmRing::waitAny(&rings[0], &cursors[0], count, 0.01) );
+
+    for (unsigned int i = 0; i != count; ++i) {
+        readers[i].close();
+        writers[i].close();
+        shm::ShmRing::unlink( "/waitany" + boost::lexical_cast<std::string>(i) );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( testPortStreams )
+{
+    // Test all four configurations of Data/Buffer & push/pull
+    policy.type = ConnPolicy::DATA;
+    policy.pull = false;
+    policy.name_id = "/data1";
+    BOOST_REQUIRE( mw1->createStream( policy ) );
+    BOOST_REQUIRE( mr2->createStream( policy ) );
+    testPortDataConnection();
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+
+    policy.type = ConnPolicy::DATA;
+    policy.pull = true;
+    policy.name_id = "";
+    BOOST_REQUIRE( mw1->createStream( policy ) );
+    BOOST_REQUIRE( mr2->createStream( policy ) );
+    testPortDataConnection();
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+
+    policy.type = ConnPolicy::BUFFER;
+    policy.pull = false;
+    policy.size = 3;
+    policy.name_id = "/buffer1";
+    BOOST_REQUIRE( mw1->createStream( policy ) );
+    BOOST_REQUIRE( mr2->createStream( policy ) );
+    testPortBufferConnection();
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+
+    policy.type = ConnPolicy::BUFFER;
+    policy.pull = true;
+    policy.size = 3;
+    policy.name_id = "";
+    BOOST_REQUIRE( mw1->createStream( policy ) );
+    BOOST_REQUIRE( mr2->createStream( policy ) );
+    testPortBufferConnection();
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+}
+
+BOOST_AUTO_TEST_CASE( testPortStreamsBatch )
+{
+    // Test that a batched stream delivers all samples in order.
+    policy.type = ConnPolicy::BUFFER;
+    policy.pull = false;
+    policy.size = 10;
+    policy.batch_size = 10;
+    policy.name_id = "/buffer1";
+    BOOST_REQUIRE( mw1->createStream( policy ) );
+    BOOST_REQUIRE( mr2->createStream( policy ) );
+
+    double value = 0;
+    ASSERT_PORT_SIGNALLING(for (int i = 0; i != 10; ++i) mw1->write( double(i) ), mr2);
+    for (int i = 0; i != 10; ++i) {
+        BOOST_CHECK( NewData == mr2->read(value) );
+        BOOST_CHECK_EQUAL( double(i), value );
+    }
+    BOOST_CHECK( OldData == mr2->read(value) );
+
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+}
+
+/**
+ * Measures the number of samples per second a buffered stream
+ * delivers. Compare with testPortStreamsThroughput of the mqueue test.
+ */
+BOOST_AUTO_TEST_CASE( testPortStreamsThroughput )
+{
+    const int rounds = 200;
+    policy.type = ConnPolicy::BUFFER;
+    policy.pull = false;
+    policy.size = 10;
+    policy.name_id = "/buffer1";
+    for (int batch_size = 0; batch_size <= 10; batch_size += 10) {
+        policy.batch_size = batch_size;
+        BOOST_REQUIRE( mw1->createStream( policy ) );
+        BOOST_REQUIRE( mr2->createStream( policy ) );
+
+        double value = 0;
+        int received = 0;
+        TimeService::ticks start = TimeService::Instance()->getTicks();
+        for (int r = 0; r != rounds; ++r) {
+            // fill the ring and wait until all samples arrived.
+            for (int i = 0; i != policy.size; ++i)
+                mw1->write( double(i) );
+            int count = 0;
+            for (int wait = 0; count != policy.size && wait != 10000; ++wait) {
+                if ( mr2->read(value) == NewData ) {
+                    BOOST_CHECK_EQUAL( double(count), value );
+                    ++count;
+                } else
+                    usleep(100);
+            }
+            received += count;
+        }
+        Seconds elapsed = TimeService::Instance()->secondsSince( start );
+        BOOST_CHECK_EQUAL( received, rounds * policy.size );
+        log(Info) << "Shared memory throughput with batch_size " << batch_size << ": "
+                  << int(received / elapsed) << " samples/s" << endlog();
+
+        mw1->disconnect();
+        mr2->disconnect();
+        testPortDisconnected();
+    }
+}
+
+BOOST_AUTO_TEST_CASE( testPortStreamsTimeout )
+{
+    // Test creating an input stream without an output stream available.
+    policy.type = ConnPolicy::DATA;
+    policy.pull = false;
+    policy.name_id = "/data1";
+    BOOST_REQUIRE( mr2->createStream( policy ) == false );
+    BOOST_CHECK( mr2->connected() == false );
+    mr2->disconnect();
+}
+
+BOOST_AUTO_TEST_CASE( testPortStreamsWrongName )
+{
+    // Test creating an input/output stream with a wrong name
+    policy.type = ConnPolicy::DATA;
+    policy.pull = false;
+    policy.name_id = "data1"; // name must start with '/'
+    BOOST_REQUIRE( mr2->createStream( policy ) == false );
+    BOOST_CHECK( mr2->connected() == false );
+    mr2->disconnect();
+
+    policy.name_id = "/data/1"; // name may only contain one '/'
+    BOOST_REQUIRE( mw1->createStream( policy ) == false );
+    BOOST_CHECK( mw1->connected() == false );
+    mw1->disconnect();
+}
+
+// copied from testVectorTransport of the mqueue test
+BOOST_AUTO_TEST_CASE( testVectorTransport )
+{
+    DataFlowInterface* ports  = tc->ports();
+    DataFlowInterface* ports2 = t2->ports();
+
+    std::vector<double> data(20, 3.33);
+    InputPort< std::vector<double> > vin("VIn");
+    OutputPort< std::vector<double> > vout("Vout");
+    ports->addPort(vin).doc("input port");
+    ports2->addPort(vout).doc("output port");
+
+    // init the output port with a vector of size 20, values 3.33
+    vout.setDataSample( data );
+
+    policy.type = ConnPolicy::DATA;
+    policy.pull = false;
+    policy.name_id = "/vdata1";
+    BOOST_REQUIRE( vout.createStream( policy ) );
+    BOOST_REQUIRE( vin.createStream( policy ) );
+
+    // check that the receiver did not get any data
+    BOOST_CHECK_EQUAL( vin.read(data), NoData);
+
+    // prepare a new data sample, size 10, values 6.66
+    data.clear();
+    data.resize(10, 6.66);
+
+    rtos_enable_rt_warning();
+    vout.write( data );
+    rtos_disable_rt_warning();
+
+    // prepare data buffer for reception:
+    data.clear();
+    data.resize(20, 0.0);
+    usleep(200000);
+
+    rtos_enable_rt_warning();
+    BOOST_CHECK_EQUAL( vin.read(data), NewData);
+    rtos_disable_rt_warning();
+
+    // check if both size and capacity and values are as expected.
+    BOOST_CHECK_EQUAL( data.size(), 10);
+    BOOST_CHECK_EQUAL( data.capacity(), 20);
+    for(unsigned int i=0; i != data.size(); ++i)
+        BOOST_CHECK_CLOSE( data[i], 6.66, 0.01);
+
+    rtos_enable_rt_warning();
+    BOOST_CHECK_EQUAL( vin.read(data), OldData);
+    rtos_disable_rt_warning();
+
+    // a larger data sample makes the sender replace the ring,
+    // the receiver must follow it to the new one.
+    data.clear();
+    data.resize(40, 9.99);
+    vout.setDataSample( data );
+    vout.write( data );
+    data.clear();
+    usleep(200000);
+    BOOST_CHECK_EQUAL( vin.read(data), NewData);
+    BOOST_CHECK_EQUAL( data.size(), 40);
+    for(unsigned int i=0; i != data.size(); ++i)
+        BOOST_CHECK_CLOSE( data[i], 9.99, 0.01);
+
+    vout.disconnect();
+    vin.disconnect();
+}
+
+/**
+ * All receiving streams of a process share one dispatcher thread.
+ */
+BOOST_AUTO_TEST_CASE( testSharedDispatcher )
+{
+    InputPort<double> mr3("mr3");
+    OutputPort<double> mw3("mw3");
+    tc->ports()->addEventPort( mr3 );
+    t2->ports()->addPort( mw3 );
+
+    shm::ShmDispatcher::setPriority( ORO_SCHED_OTHER, os::LowestPriority );
+
+    policy.type = ConnPolicy::BUFFER;
+    policy.pull = false;
+    policy.size = 10;
+    policy.name_id = "/buffer1";
+    BOOST_REQUIRE( mw1->createStream( policy ) );
+    BOOST_REQUIRE( mr2->createStream( policy ) );
+    policy.name_id = "/buffer2";
+    BOOST_REQUIRE( mw3.createStream( policy ) );
+    BOOST_REQUIRE( mr3.createStream( policy ) );
+
+    shm::ShmDispatcher::shared_ptr dispatcher = shm::ShmDispatcher::Instance();
+    BOOST_CHECK_EQUAL( dispatcher->thread()->getScheduler(), ORO_SCHED_OTHER );
+
+    double value = 0;
+    for (int i = 0; i != 3; ++i) {
+        mw1->write( double(i) );
+        mw3.write( double(10 + i) );
+    }
+    for (int i = 0; i != 3; ++i) {
+        for (int wait = 0; mr2->read(value) != NewData && wait != 1000; ++wait)
+            usleep(1000);
+        BOOST_CHECK_EQUAL( value, double(i) );
+        for (int wait = 0; mr3.read(value) != NewData && wait != 1000; ++wait)
+            usleep(1000);
+        BOOST_CHECK_EQUAL( value, double(10 + i) );
+    }
+
+    mw1->disconnect();
+    mr2->disconnect();
+    mw3.disconnect();
+    mr3.disconnect();
+    dispatcher = 0;
+    shm::ShmDispatcher::setPriority( ORO_SCHED_RT, os::HighestPriority );
+    tc->ports()->removePort("mr3");
+    t2->ports()->removePort("mw3");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -28,6 +28,8 @@
 #include <extras/SimulationThread.hpp>
 #include <os/MainThread.hpp>
 #include <Logger.hpp>
+#include <TaskContext.hpp>
+#include <OperationCaller.hpp>
 #include <rtt-config.h>
 
 using namespace std;
@@ -405,6 +407,187 @@ BOOST_AUTO_TEST_CASE( testSequential )
     BOOST_CHECK( mtask.start() == false );
 }
 
+/**
+ * Counts its steps and detects if it is executed by two threads at once.
+ */
+struct CountingRunner
+    : public RunnableInterface
+{
+    os::AtomicInt steps;
+    os::AtomicInt inside;
+    bool overlapped;
+
+    CountingRunner() : overlapped(false) {}
+
+    bool initialize() { return true; }
+    void step() {
+        inside.inc();
+        if ( inside.read() != 1 )
+            overlapped = true;
+        usleep(100);
+        steps.inc();
+        inside.dec();
+    }
+    void finalize() {}
+};
+
+/**
+ * Triggers \a next, or itself if null, until it made \a repeat steps and
+ * triggers \a wake in its first step. Records the steps of \a observed
+ * when it runs and if its activity's thread is the executing one.
+ */
+struct OrderRunner
+    : public RunnableInterface
+{
+    ActivityInterface* wake;
+    ActivityInterface* next;
+    OrderRunner* observed;
+    int repeat;
+    os::AtomicInt steps;
+    int seen;
+    bool self;
+
+    OrderRunner() : wake(0), next(0), observed(0), repeat(1), seen(-1), self(false) {}
+
+    bool initialize() { return true; }
+    void step() {
+        steps.inc();
+        self = this->getActivity()->thread()->isSelf();
+        if ( observed && seen == -1 )
+            seen = observed->steps.read();
+        if ( wake && steps.read() == 1 )
+            wake->trigger();
+        if ( steps.read() < repeat )
+            (next ? next : this->getActivity())->trigger();
+    }
+    void finalize() {}
+};
+
+BOOST_AUTO_TEST_CASE( testThreadPool )
+{
+    ThreadPool pool(2);
+    BOOST_CHECK_EQUAL( pool.getWorkerCount(), 2u );
+    BOOST_CHECK( pool.setPriority( pool.getPriority() ) );
+    BOOST_CHECK( pool.setCpuAffinity( pool.getCpuAffinity() ) );
+
+    TestRunner r(true);
+    ThreadPoolActivity mtask(&pool, &r);
+    BOOST_CHECK( mtask.isActive() == false );
+    BOOST_CHECK( mtask.isRunning() == false );
+    BOOST_CHECK( mtask.isPeriodic() == false );
+    BOOST_CHECK( mtask.getPeriod() == 0.0 );
+    BOOST_CHECK( mtask.execute() == false );
+    BOOST_CHECK( mtask.trigger() == false );
+    BOOST_REQUIRE( mtask.thread() != 0 );
+    BOOST_CHECK( mtask.thread()->isSelf() == false );
+    BOOST_CHECK_EQUAL( mtask.thread()->getPriority(), pool.getPriority() );
+    BOOST_CHECK_EQUAL( mtask.thread()->getScheduler(), pool.getScheduler() );
+
+    // starting...
+    BOOST_CHECK( mtask.start() == true );
+    BOOST_CHECK( r.init == true );
+    BOOST_CHECK( mtask.isActive() == true );
+    BOOST_CHECK( mtask.start() == false );
+
+    // calls step() in a worker
+    BOOST_CHECK( mtask.trigger() );
+    for (int i = 0; i != 1000 && !r.stepped; ++i)
+        usleep(1000);
+    BOOST_CHECK( r.stepped == true );
+    BOOST_CHECK( r.wasrunning );
+    BOOST_CHECK( r.wasactive );
+
+    // stopping...
+    BOOST_CHECK( mtask.stop() == true );
+    BOOST_CHECK( r.fini == true );
+    BOOST_CHECK( mtask.isRunning() == false );
+    BOOST_CHECK( mtask.isActive() == false );
+    BOOST_CHECK( mtask.stop() == false );
+    BOOST_CHECK( mtask.trigger() == false );
+
+    // many activities on few workers, never concurrent with themselves.
+    const int nact = 20;
+    CountingRunner runners[nact];
+    std::vector<ThreadPoolActivity*> acts;
+    for (int i = 0; i != nact; ++i) {
+        acts.push_back( new ThreadPoolActivity(&pool, &runners[i]) );
+        BOOST_CHECK( acts.back()->start() );
+    }
+    for (int round = 0; round != 50; ++round)
+        for (int i = 0; i != nact; ++i)
+            BOOST_CHECK( acts[i]->trigger() );
+    for (int i = 0; i != nact; ++i) {
+        for (int w = 0; w != 1000 && (runners[i].steps.read() == 0 || acts[i]->isRunning()); ++w)
+            usleep(1000);
+    }
+    for (int i = 0; i != nact; ++i) {
+        BOOST_CHECK( acts[i]->stop() );
+        BOOST_CHECK( runners[i].steps.read() >= 1 );
+        // triggers are merged while queued.
+        BOOST_CHECK( runners[i].steps.read() <= 50 );
+        BOOST_CHECK( !runners[i].overlapped );
+        delete acts[i];
+    }
+    BOOST_CHECK( pool.getExecuted() >= (unsigned int)nact );
+
+    // a component's state changes are executed by the pool.
+    {
+        TaskContext tc("pooled");
+        BOOST_CHECK( tc.setActivity( new ThreadPoolActivity(&pool) ) );
+        BOOST_CHECK( tc.start() );
+        BOOST_CHECK( tc.isRunning() );
+        BOOST_CHECK( tc.stop() );
+        BOOST_CHECK( !tc.isRunning() );
+    }
+
+    // an activity which triggers itself does not keep the others of its worker waiting.
+    {
+        ThreadPool single(1);
+        OrderRunner a, b;
+        a.repeat = 100;
+        b.observed = &a;
+        ThreadPoolActivity act_a(&single, &a);
+        ThreadPoolActivity act_b(&single, &b);
+        a.wake = &act_b;
+        BOOST_CHECK( act_a.start() );
+        BOOST_CHECK( act_b.start() );
+        BOOST_CHECK( act_a.trigger() );
+        for (int i = 0; i != 1000 && (b.steps.read() == 0 || a.steps.read() != 100); ++i)
+            usleep(1000);
+        BOOST_CHECK_EQUAL( a.steps.read(), 100 );
+        BOOST_CHECK_EQUAL( b.steps.read(), 1 );
+        BOOST_CHECK( b.seen >= 1 && b.seen <= 2 );
+    }
+
+    // nor do activities which trigger each other.
+    {
+        ThreadPool single(1);
+        OrderRunner a, b, c;
+        a.repeat = b.repeat = 1000000;
+        c.observed = &a;
+        ThreadPoolActivity act_a(&single, &a);
+        ThreadPoolActivity act_b(&single, &b);
+        ThreadPoolActivity act_c(&single, &c);
+        a.next = &act_b;
+        b.next = &act_a;
+        BOOST_CHECK( act_a.start() );
+        BOOST_CHECK( act_b.start() );
+        BOOST_CHECK( act_c.start() );
+        BOOST_CHECK( act_a.trigger() );
+        for (int i = 0; i != 1000 && a.steps.read() < 10; ++i)
+            usleep(1000);
+        BOOST_CHECK( act_c.trigger() );
+        for (int i = 0; i != 1000 && c.steps.read() == 0; ++i)
+            usleep(1000);
+        BOOST_CHECK_EQUAL( c.steps.read(), 1 );
+        BOOST_CHECK( c.seen >= 10 && c.seen < a.repeat );
+        BOOST_CHECK( c.self );
+        BOOST_CHECK( act_c.thread()->isSelf() == false );
+        BOOST_CHECK( act_a.stop() );
+        BOOST_CHECK( act_b.stop() );
+    }
+}
+
 BOOST_AUTO_TEST_CASE( testScheduler )
 {
     int rtsched = ORO_SCHED_OTHER;
@@ -452,6 +635,85 @@ BOOST_AUTO_TEST_CASE( testThreadPID )
 }
 #endif
 
+struct SleepingRunner
+    : public RunnableInterface
+{
+    bool initialize() { return true; }
+    void step() { usleep(2000); }
+    void finalize() {}
+};
+
+BOOST_AUTO_TEST_CASE( testThreadStatistics )
+{
+    SleepingRunner r;
+    Activity act(ORO_SCHED_OTHER, 0, 0.01, &r, "StatisticsActivity");
+    ThreadStatistics stats;
+
+    // disabled by default, and not supported by the main thread.
+    BOOST_CHECK( !act.isStatisticsEnabled() );
+    BOOST_CHECK( !MainThread::Instance()->setStatisticsEnabled(true) );
+    BOOST_CHECK( !MainThread::Instance()->getStatistics(stats) );
+    // non periodic threads do not record either.
+    Activity nonperiodic(ORO_SCHED_OTHER, 0, 0.0);
+    BOOST_CHECK( !nonperiodic.setStatisticsEnabled(true) );
+
+    BOOST_CHECK( act.setStatisticsEnabled(true) );
+    BOOST_CHECK( act.start() );
+    usleep(300000);
+    BOOST_CHECK( act.getStatistics(stats) );
+
+    // the first period and those after an overrun have no wake up latency.
+    BOOST_CHECK( stats.step.getCount() >= 10 );
+    BOOST_CHECK( stats.wakeup.getCount() != 0 );
+    BOOST_CHECK( stats.wakeup.getCount() < stats.step.getCount() );
+    BOOST_CHECK( stats.step.getMin() >= 2000000 );
+    BOOST_CHECK( stats.step.getMin() <= stats.step.getMean() );
+    BOOST_CHECK( stats.step.getMean() <= stats.step.getMax() );
+    unsigned int total = 0;
+    for (unsigned int i = 0; i != TimeHistogram::Buckets; ++i) {
+        total += stats.step.getBucket(i);
+        if ( i + 1 != TimeHistogram::Buckets && TimeHistogram::getBucketStart(i + 1) <= 2000000 )
+            BOOST_CHECK_EQUAL( stats.step.getBucket(i), 0u );
+    }
+    BOOST_CHECK_EQUAL( total, stats.step.getCount() );
+
+    // a reset is visible immediately.
+    act.resetStatistics();
+    BOOST_CHECK( act.getStatistics(stats) );
+    BOOST_CHECK_EQUAL( stats.step.getCount(), 0u );
+    BOOST_CHECK_EQUAL( stats.wakeup.getCount(), 0u );
+    usleep(100000);
+    BOOST_CHECK( act.getStatistics(stats) );
+    BOOST_CHECK( stats.step.getCount() != 0 );
+
+    // nothing is recorded when disabled.
+    BOOST_CHECK( act.setStatisticsEnabled(false) );
+    usleep(20000);
+    act.resetStatistics();
+    usleep(100000);
+    BOOST_CHECK( act.getStatistics(stats) );
+    BOOST_CHECK_EQUAL( stats.step.getCount(), 0u );
+    BOOST_CHECK( act.stop() );
+
+    // the statistics are available through the 'engine' service of a component.
+    TaskContext tc("statistics");
+    tc.setActivity( new Activity(ORO_SCHED_OTHER, 0, 0.01) );
+    BOOST_REQUIRE( tc.provides()->hasService("engine") == false );
+    BOOST_REQUIRE( tc.loadService("engine") );
+    Service::shared_ptr es = tc.provides()->getService("engine");
+    BOOST_REQUIRE( es );
+    OperationCaller<bool(bool)> setThreadStatisticsEnabled = es->getOperation("setThreadStatisticsEnabled");
+    OperationCaller<double(void)> getMaxStepTime = es->getOperation("getMaxStepTime");
+    OperationCaller<std::string(void)> dumpThreadStatistics = es->getOperation("dumpThreadStatistics");
+    BOOST_REQUIRE( setThreadStatisticsEnabled.ready() && getMaxStepTime.ready() && dumpThreadStatistics.ready() );
+    BOOST_CHECK( setThreadStatisticsEnabled(true) );
+    BOOST_CHECK( tc.start() );
+    usleep(100000);
+    BOOST_CHECK( tc.stop() );
+    BOOST_CHECK( getMaxStepTime() > 0.0 );
+    BOOST_CHECK( dumpThreadStatistics().find("step time") != std::string::npos );
+}
+
 #if !defined( OROCOS_TARGET_WIN32 )
 BOOST_AUTO_TEST_CASE( testThreadConfig )
 {
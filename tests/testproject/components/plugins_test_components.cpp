@@ -0,0 +1,30 @@
+/***************************************************************************
+  tag: Sat Oct 17 10:00:00 CEST 2026  plugins_test_components.cpp
+
+                        plugins_test_components.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT Developers
+
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include <rtt/TaskContext.hpp>
+#include <rtt/Component.hpp>
+
+using namespace RTT;
+
+class ComponentPluginTest : public TaskContext
+{
+public:
+    ComponentPluginTest(std::string const& name) : TaskContext(name) {}
+};
+
+ORO_CREATE_COMPONENT( ComponentPluginTest )
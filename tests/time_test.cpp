@@ -22,6 +22,7 @@
 #include <boost/bind.hpp>
 #include <os/Timer.hpp>
 #include <rtt-detail-fwd.hpp>
+#include <Logger.hpp>
 #include <iostream>
 
 #define EPSILON 0.000000002
@@ -61,8 +62,8 @@ struct TestTimer
 {
     std::vector< std::pair<Timer::TimerId, Seconds> > occured;
     TimeService::Seconds mstart;
-    TestTimer()
-        :Timer(32, ORO_SCHED_RT, os::HighestPriority)
+    TestTimer(Timer::Backend backend = Timer::LinearScan)
+        :Timer(32, ORO_SCHED_RT, os::HighestPriority, backend)
     {
         occured.reserve(100);
         mstart = TimeService::Instance()->secondsSince(0);
@@ -291,4 +292,149 @@ BOOST_AUTO_TEST_CASE( testTimerPeriod )
     BOOST_CHECK( timer.occured.size() == 0 );
 }
 
+BOOST_AUTO_TEST_CASE( testTimerMinHeap )
+{
+    TestTimer timer( Timer::MinHeap );
+    BOOST_CHECK_EQUAL( timer.getBackend(), Timer::MinHeap );
+    Seconds now = hbg->secondsSince( 0 );
+    BOOST_CHECK( timer.startTimer(0, 0.1) );
+    BOOST_CHECK( timer.arm(1, 0.25) );
+    BOOST_CHECK( timer.arm(2, 0.15) );
+    BOOST_CHECK( timer.arm(3, 0.35) );
+    BOOST_CHECK( timer.killTimer(3) );
+    BOOST_CHECK( timer.isArmed( 0 ) );
+    BOOST_CHECK( timer.isArmed( 1 ) );
+    BOOST_CHECK( timer.isArmed( 2 ) );
+    BOOST_CHECK( !timer.isArmed( 3 ) );
+
+    usleep(450000);
+    BOOST_CHECK( timer.killTimer( 0 ) );
+    BOOST_CHECK( !timer.isArmed( 1 ) );
+    BOOST_CHECK( !timer.isArmed( 2 ) );
+
+    // Test sequence
+    BOOST_REQUIRE_EQUAL( timer.occured.size(), 6u );
+    BOOST_CHECK( timer.occured[0].first == 0 );
+    BOOST_CHECK( timer.occured[1].first == 2 );
+    BOOST_CHECK( timer.occured[2].first == 0 );
+    BOOST_CHECK( timer.occured[3].first == 1 );
+    BOOST_CHECK( timer.occured[4].first == 0 );
+    BOOST_CHECK( timer.occured[5].first == 0 );
+
+    // Test timeliness
+    BOOST_REQUIRE_CLOSE( timer.occured[0].second, now+0.1, 0.1 );
+    BOOST_REQUIRE_CLOSE( timer.occured[1].second, now+0.15, 0.1 );
+    BOOST_REQUIRE_CLOSE( timer.occured[2].second, now+0.2, 0.1 );
+    BOOST_REQUIRE_CLOSE( timer.occured[3].second, now+0.25, 0.1 );
+    BOOST_REQUIRE_CLOSE( timer.occured[4].second, now+0.3, 0.1 );
+    BOOST_REQUIRE_CLOSE( timer.occured[5].second, now+0.4, 0.1 );
+
+    // Test statistics
+    BOOST_CHECK_EQUAL( timer.getTimeoutCount(), 6u );
+    BOOST_CHECK( timer.getMaxLateness() >= timer.getMeanLateness() );
+    BOOST_CHECK( timer.getMaxLateness() < 0.05 );
+    timer.resetStatistics();
+    BOOST_CHECK_EQUAL( timer.getTimeoutCount(), 0u );
+    BOOST_CHECK_EQUAL( timer.getMaxLateness(), 0.0 );
+
+    // Test that all timers fire in order of expiry time.
+    timer.occured.clear();
+    for (int i = 31; i >= 0; --i)
+        BOOST_CHECK( timer.arm(i, 0.1) );
+    usleep(300000);
+    BOOST_REQUIRE_EQUAL( timer.occured.size(), 32u );
+    for (int i = 0; i != 32; ++i)
+        BOOST_CHECK_EQUAL( timer.occured[i].first, 31 - i );
+    BOOST_CHECK_EQUAL( timer.getTimeoutCount(), 32u );
+
+    // Test resize.
+    timer.occured.clear();
+    BOOST_CHECK( timer.startTimer(10, 0.2) );
+    BOOST_CHECK( timer.arm(2, 0.2) );
+    timer.setMaxTimers( 5 ); // clears timer 10
+    BOOST_CHECK( timer.isArmed( 2 ) );
+    usleep(400000);
+    BOOST_REQUIRE_EQUAL( timer.occured.size(), 1u );
+    BOOST_CHECK_EQUAL( timer.occured[0].first, 2 );
+    BOOST_CHECK( timer.startTimer(5, 0.1) == false );
+}
+
+/**
+ * Timers take their time from the TimeService, so a stopped clock
+ * holds them and secondsChange() moves them forward.
+ */
+BOOST_AUTO_TEST_CASE( testTimerTimeService )
+{
+    hbg->enableSystemClock( false );
+    TimeService::nsecs ns = hbg->getNSecs();
+    hbg->secondsChange( 1.0 );
+    BOOST_CHECK_CLOSE( double(hbg->getNSecs() - ns), 1e9, 0.001 );
+
+    TestTimer timer;
+    BOOST_CHECK( timer.arm(0, 0.1) );
+    usleep(300000);
+    BOOST_CHECK( timer.isArmed( 0 ) );
+    BOOST_CHECK( timer.occured.empty() );
+    BOOST_CHECK_CLOSE( timer.timeRemaining( 0 ), 0.1, 0.001 );
+
+    // the timer thread notices the change when it wakes up again.
+    hbg->secondsChange( 0.2 );
+    usleep(300000);
+    BOOST_CHECK( !timer.isArmed( 0 ) );
+    BOOST_CHECK_EQUAL( timer.occured.size(), 1u );
+    hbg->enableSystemClock( true );
+}
+
+BOOST_AUTO_TEST_CASE( testClockCost )
+{
+    // Measures the cost of reading the clock, for the configured
+    // clock source and, on gnulinux, for each of the POSIX clocks.
+    const int runs = 1000000;
+    TimeService::ticks start, t = hbg->getTicks();
+    Seconds total = 0.0;
+
+    start = hbg->getTicks();
+    for (int i = 0; i != runs; ++i)
+        t = hbg->getTicks();
+    TimeService::nsecs ticks_cost = TimeService::ticks2nsecs( hbg->ticksSince(start) );
+    BOOST_CHECK( t >= start );
+
+    start = hbg->getTicks();
+    for (int i = 0; i != runs; ++i)
+        total += hbg->secondsSince(start);
+    TimeService::nsecs seconds_cost = TimeService::ticks2nsecs( hbg->ticksSince(start) );
+    BOOST_CHECK( total > 0.0 );
+
+    log(Info) << "Clock cost per call: getTicks() " << double(ticks_cost) / runs << "ns, secondsSince() "
+              << double(seconds_cost) / runs << "ns" << endlog();
+#if defined(OROPKG_OS_GNULINUX) && !defined(ORO_OS_GNULINUX_CLOCK_REALTIME)
+    // A monotonic clock must never run backwards. The wall clock does
+    // whenever it is stepped, so this is not checked for REALTIME.
+    t = hbg->getTicks();
+    for (int i = 0; i != 1000; ++i) {
+        TimeService::ticks n = hbg->getTicks();
+        BOOST_CHECK( n >= t );
+        t = n;
+    }
+#endif
+
+#ifdef OROPKG_OS_GNULINUX
+    const clockid_t clocks[] = { CLOCK_REALTIME, CLOCK_MONOTONIC, CLOCK_MONOTONIC_RAW };
+    const char* names[] = { "CLOCK_REALTIME", "CLOCK_MONOTONIC", "CLOCK_MONOTONIC_RAW" };
+    for (int c = 0; c != 3; ++c) {
+        TIME_SPEC ts;
+        start = hbg->getTicks();
+        for (int i = 0; i != runs; ++i)
+            clock_gettime( clocks[c], &ts );
+        log(Info) << names[c] << ": " << double( TimeService::ticks2nsecs( hbg->ticksSince(start) ) ) / runs << "ns per call" << endlog();
+    }
+#ifdef ORO_OS_GNULINUX_CLOCK_TSC
+    start = hbg->getTicks();
+    for (int i = 0; i != runs; ++i)
+        t = rtos_tsc_read();
+    log(Info) << "rdtsc: " << double( TimeService::ticks2nsecs( hbg->ticksSince(start) ) ) / runs << "ns per call" << endlog();
+#endif
+#endif
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -32,6 +32,10 @@
 #include <types/Types.hpp>
 #include <types/StructTypeInfo.hpp>
 #include <types/SequenceTypeInfo.hpp>
+#include <types/Operators.hpp>
+#include <scripting/ExpressionCompiler.hpp>
+#include <internal/AssignCommand.hpp>
+#include <os/TimeService.hpp>
 
 #include "datasource_fixture.hpp"
 #include "operations_fixture.hpp"
@@ -503,6 +507,110 @@ BOOST_AUTO_TEST_CASE( testOperatorOrder )
     executePrograms(prog);
 }
 
+/**
+ * Tests that compiled expressions evaluate like the DataSource trees
+ * they were compiled from, and compares the evaluation time of both.
+ */
+BOOST_AUTO_TEST_CASE( testCompiledExpressions )
+{
+    OperatorRepository::shared_ptr ops = OperatorRepository::Instance();
+    ValueDataSource<int>::shared_ptr a = new ValueDataSource<int>(7);
+    ValueDataSource<int>::shared_ptr b = new ValueDataSource<int>(2);
+    ValueDataSource<double>::shared_ptr d = new ValueDataSource<double>(1.5);
+
+    // (a * 3 + b) / (b - 2)
+    DataSourceBase::shared_ptr itree = ops->applyBinary( "/",
+            ops->applyBinary( "+", ops->applyBinary( "*", a.get(), new ConstantDataSource<int>(3) ), b.get() ),
+            ops->applyBinary( "-", b.get(), new ConstantDataSource<int>(2) ) );
+    // -d * 2.5 - d / 4.0 < 10.0 && !(a % 2 == 0)
+    DataSourceBase::shared_ptr btree = ops->applyBinary( "&&",
+            ops->applyBinary( "<",
+                    ops->applyBinary( "-",
+                            ops->applyBinary( "*", ops->applyUnary( "-", d.get() ), new ConstantDataSource<double>(2.5) ),
+                            ops->applyBinary( "/", d.get(), new ConstantDataSource<double>(4.0) ) ),
+                    new ConstantDataSource<double>(10.0) ),
+            ops->applyUnary( "!", ops->applyBinary( "==",
+                    ops->applyBinary( "%", a.get(), new ConstantDataSource<int>(2) ), new ConstantDataSource<int>(0) ) ) );
+    BOOST_REQUIRE( itree && btree );
+
+    DataSource<int>::shared_ptr itree_t = DataSource<int>::narrow( itree.get() );
+    DataSource<bool>::shared_ptr btree_t = DataSource<bool>::narrow( btree.get() );
+    DataSource<int>::shared_ptr icomp = DataSource<int>::narrow( ExpressionCompiler::compile( itree ).get() );
+    DataSource<bool>::shared_ptr bcomp = DataSource<bool>::narrow( ExpressionCompiler::compile( btree ).get() );
+    BOOST_REQUIRE( icomp && bcomp );
+    BOOST_CHECK( icomp != itree_t );
+    BOOST_CHECK( bcomp != btree_t );
+
+    // division by zero propagates zero.
+    BOOST_CHECK_EQUAL( itree_t->get(), 0 );
+    BOOST_CHECK_EQUAL( icomp->get(), 0 );
+    for ( int i = 0; i != 10; ++i ) {
+        a->set( i * 5 - 20 );
+        b->set( i - 3 );
+        d->set( i * 2.0 - 9.0 );
+        BOOST_CHECK_EQUAL( icomp->get(), itree_t->get() );
+        BOOST_CHECK_EQUAL( icomp->value(), itree_t->value() );
+        BOOST_CHECK_EQUAL( bcomp->get(), btree_t->get() );
+    }
+
+    // a copy reads its own variables.
+    std::map<const DataSourceBase*, DataSourceBase*> clones;
+    ValueDataSource<int>::shared_ptr acopy = new ValueDataSource<int>(100);
+    clones[a.get()] = acopy.get();
+    DataSource<int>::shared_ptr icopy = icomp->copy( clones );
+    a->set( 1 );
+    b->set( 3 );
+    BOOST_CHECK_EQUAL( icopy->get(), 303 );
+    BOOST_CHECK_EQUAL( icomp->get(), 6 );
+
+    // a variable is read in tree order, before a leaf assigns it: x + (x = 10, x)
+    ValueDataSource<int>::shared_ptr x = new ValueDataSource<int>(1);
+    DataSourceBase::shared_ptr side = ops->applyBinary( "+", x.get(),
+            new ActionAliasDataSource<int>( new AssignCommand<int>( x.get(), new ConstantDataSource<int>(10) ), x.get() ) );
+    DataSource<int>::shared_ptr side_t = DataSource<int>::narrow( side.get() );
+    DataSource<int>::shared_ptr side_c = DataSource<int>::narrow( ExpressionCompiler::compile( side ).get() );
+    BOOST_REQUIRE( side_t && side_c && side_c != side_t );
+    BOOST_CHECK_EQUAL( side_t->get(), 11 );
+    x->set( 1 );
+    BOOST_CHECK_EQUAL( side_c->get(), 11 );
+
+    // expressions without operators or on other types are not compiled.
+    BOOST_CHECK( ExpressionCompiler::compile( a ) == a );
+    DataSourceBase::shared_ptr str = ops->applyBinary( "+", new ConstantDataSource<std::string>("a"), new ConstantDataSource<std::string>("b") );
+    BOOST_CHECK( ExpressionCompiler::compile( str ) == str );
+
+    // the parser returns compiled expressions.
+    const char* exprs[] = { "6/2*4 == 12", "3 < 2 != 5 > 1", "6 - 9 % 2*3 ==  15/3 % 3 + 1",
+                            "-(1.5 * 2.0) + 3.0 == 0.0", "1/0 == 0 && 7u % 4u == 3u" };
+    for ( unsigned int i = 0; i != sizeof(exprs)/sizeof(exprs[0]); ++i ) {
+        DataSource<bool>::shared_ptr e;
+        try {
+            e = DataSource<bool>::narrow( parser.parseExpression( exprs[i], tc ).get() );
+        } catch( const parse_exception& pe ) {
+            BOOST_CHECK_MESSAGE( false, std::string(exprs[i]) + ": " + pe.what() );
+            continue;
+        }
+        BOOST_REQUIRE_MESSAGE( e, exprs[i] );
+        BOOST_CHECK_MESSAGE( e->get(), exprs[i] );
+    }
+
+    const int runs = 200000;
+    os::TimeService::ticks start = os::TimeService::Instance()->getTicks();
+    for ( int i = 0; i != runs; ++i ) {
+        itree_t->get();
+        btree_t->get();
+    }
+    os::TimeService::nsecs tree = os::TimeService::ticks2nsecs( os::TimeService::Instance()->ticksSince(start) );
+    start = os::TimeService::Instance()->getTicks();
+    for ( int i = 0; i != runs; ++i ) {
+        icomp->get();
+        bcomp->get();
+    }
+    os::TimeService::nsecs compiled = os::TimeService::ticks2nsecs( os::TimeService::Instance()->ticksSince(start) );
+    log(Info) << "Expression evaluation of " << runs << " runs: tree " << tree / 1000 << "us, compiled "
+              << compiled / 1000 << "us" << endlog();
+}
+
 BOOST_AUTO_TEST_CASE( testGlobals )
 {
     GlobalsRepository::Instance()->setValue( new Constant<double>("cd_num", 3.33));